@@ -4,6 +4,7 @@
 #include "AILibrary.h"
 #include "CharacterLibrary.h"
 #include "EODCharacterBase.h"
+#include "CharacterGridSubsystem.h"
 
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
@@ -94,21 +95,20 @@ void UBTService_CheckForEnemies::LookForAnotherEnemy(UBehaviorTreeComponent& Own
 	BlackboardComp->SetValueAsObject(UAILibrary::BBKey_TargetEnemy, nullptr);
 	float AggroActivationRadius = BlackboardComp->GetValueAsFloat(UAILibrary::BBKey_AggroActivationRadius);
 
-	TArray<FHitResult> HitResults;
-	FCollisionShape CollisionShape = FCollisionShape::MakeSphere(AggroActivationRadius);
-	FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(CharacterOwner);
-	FVector OwnerLocation = CharacterOwner->GetActorLocation();
-
-	FVector TraceEnd = OwnerLocation + FVector(0.f, 0.f, 1.f);
-	bool bHit = World->SweepMultiByChannel(HitResults, OwnerLocation, TraceEnd, FQuat::Identity, COLLISION_COMBAT, CollisionShape, Params);
+	// Candidates come from the shared character grid instead of a per mob physics sweep
+	TArray<AEODCharacterBase*> NearbyCharacters;
+	UCharacterGridSubsystem* CharacterGrid = World->GetSubsystem<UCharacterGridSubsystem>();
+	if (CharacterGrid)
+	{
+		CharacterGrid->GetCharactersInRadius(CharacterOwner->GetActorLocation(), AggroActivationRadius, NearbyCharacters, CharacterOwner);
+	}
 
 	FVector SpawnLocation = BlackboardComp->GetValueAsVector(UAILibrary::BBKey_SpawnLocation);
 	float AggroAreaRadius = BlackboardComp->GetValueAsFloat(UAILibrary::BBKey_AggroAreaRadius);
 
-	for (FHitResult& HitResult : HitResults)
+	for (AEODCharacterBase* HitCharacter : NearbyCharacters)
 	{
-		AEODCharacterBase* HitCharacter = Cast<AEODCharacterBase>(HitResult.GetActor());
-		if (!IsValid(HitCharacter) || !UCharacterLibrary::AreEnemies(HitCharacter, CharacterOwner))
+		if (HitCharacter->IsDead() || !UCharacterLibrary::AreEnemies(HitCharacter, CharacterOwner))
 		{
 			continue;
 		}
@@ -26,6 +26,12 @@ EBTNodeResult::Type UBTTask_SelectBestMeleeAttack::ExecuteTask(UBehaviorTreeComp
 	}
 
 	AEODCharacterBase* TargetEnemy = Cast<AEODCharacterBase>(BlackboardComp->GetValueAsObject(UAILibrary::BBKey_TargetEnemy));
+	if (!IsValid(TargetEnemy))
+	{
+		BlackboardComp->SetValueAsName(UAILibrary::BBKey_MostWeightedSkillID, NAME_None);
+		return EBTNodeResult::Failed;
+	}
+
 	FName SkillID = CharacterOwner->GetMostWeightedMeleeSkillID(TargetEnemy);
 
 	BlackboardComp->SetValueAsName(UAILibrary::BBKey_MostWeightedSkillID, SkillID);
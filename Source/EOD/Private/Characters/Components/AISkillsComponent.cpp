@@ -5,11 +5,25 @@
 #include "AISkillBase.h"
 #include "AICharacterBase.h"
 #include "EODAIControllerBase.h"
+#include "EOD.h"
 
 UAISkillsComponent::UAISkillsComponent(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	//~ @todo Find an appropriate value for maximum melee range
 	MaxMeleeRange = 50.f;
+
+	MeleeSkillsMask = 0;
+	RangedSkillsMask = 0;
+	SelfHealingSkillsMask = 0;
+	PartyHealingSkillsMask = 0;
+	SelfBuffSkillsMask = 0;
+	PartyBuffSkillsMask = 0;
+	DebuffSkillsMask = 0;
+	UnblockableSkillsMask = 0;
+	UndodgableSkillsMask = 0;
+	InterruptSkillsMask = 0;
+	CrowdControlSkillsMask = 0;
+	AvailableSkillsMask = 0;
 }
 
 void UAISkillsComponent::BeginPlay()
@@ -110,6 +124,10 @@ void UAISkillsComponent::TriggerSkill(uint8 SkillIndex, UGameplaySkillBase* Skil
 
 			LastUsedSkillGroup = AISkill->GetSkillGroup();
 			LastUsedSkillIndex = SkillIndex;
+
+			// The last used skill is not picked again until another skill gets used
+			AvailableSkillsMask = (MeleeSkillsMask | RangedSkillsMask | SelfHealingSkillsMask | PartyHealingSkillsMask |
+				SelfBuffSkillsMask | PartyBuffSkillsMask | DebuffSkillsMask) & ~GetSkillBit(SkillIndex);
 			ActiveSkills.Add(AISkill);
 		}
 	}
@@ -203,104 +221,23 @@ FName UAISkillsComponent::GetMostWeightedSkillID(const AEODCharacterBase* Target
 
 FName UAISkillsComponent::GetMostWeightedMeleeSkillID(const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
-	/**
-	 * Logic:
-	 *	If enemy is blocking, try and get an unblockable skill.
-	 *	If enemy is under CCE, then try and get a normal skill.
-	 *	If enemy is dodging, then try and get an undodgable skill.
-	 *	If enemy is using a skill, then try and get an interrupt skill.
-	 *	If enemy is doing nothing (Idle-Walk-Run), then try and get any CCE skill.
-	 */
-
-	FName WeightedSkillID = NAME_None;
-	if (TargetCharacter->IsBlocking())
-	{
-		WeightedSkillID = GetRandomUnblockableSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsDodging())
-	{
-		WeightedSkillID = GetRandomUndodgableSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsUsingAnySkill())
-	{
-		WeightedSkillID = GetRandomInterruptSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->HasBeenHit())
-	{
-		WeightedSkillID = GetRandomNormalSkill(MeleeSkills, SkillsToIgnore);
-	}
-	else
-	{
-		WeightedSkillID = GetRandomCCESkill(MeleeSkills, SkillsToIgnore);
-	}
-
-	if (WeightedSkillID == NAME_None)
-	{
-		WeightedSkillID = GetAnyRandomSkill(MeleeSkills, TArray<FName>());
-	}
-
-	return WeightedSkillID;
+	return GetWeightedAttackSkillID(MeleeSkillsMask, TargetCharacter);
 }
 
 FName UAISkillsComponent::GetMostWeightedRangedSkillID(const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
-	/**
-	 * Logic:
-	 *	If enemy is blocking, try and get an unblockable skill.
-	 *	If enemy is under CCE, then try and get a normal skill.
-	 *	If enemy is dodging, then try and get an undodgable skill.
-	 *	If enemy is using a skill, then try and get an interrupt skill.
-	 *	If enemy is doing nothing (Idle-Walk-Run), then try and get any CCE skill.
-	 */
-
-	FName WeightedSkillID = NAME_None;
-	if (TargetCharacter->IsBlocking())
-	{
-		WeightedSkillID = GetRandomUnblockableSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsDodging())
-	{
-		WeightedSkillID = GetRandomUndodgableSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->IsUsingAnySkill())
-	{
-		WeightedSkillID = GetRandomInterruptSkill(RangedSkills, SkillsToIgnore);
-	}
-	else if (TargetCharacter->HasBeenHit())
-	{
-		WeightedSkillID = GetRandomNormalSkill(RangedSkills, SkillsToIgnore);
-	}
-	else
-	{
-		WeightedSkillID = GetRandomCCESkill(RangedSkills, SkillsToIgnore);
-	}
-
-	if (WeightedSkillID == NAME_None)
-	{
-		WeightedSkillID = GetAnyRandomSkill(RangedSkills, TArray<FName>());
-	}
-
-	return WeightedSkillID;
+	return GetWeightedAttackSkillID(RangedSkillsMask, TargetCharacter);
 }
 
 FName UAISkillsComponent::GetHealingSkillID(bool bPartyHeal) const
 {
 	//~ Prioritize party healing over solo healing.
 
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
 	//~ @todo check if there's even a party before retreiving party healing skills
-	FName WeightedSkillID = GetAnyRandomSkill(PartyHealingSkills, SkillsToIgnore);
+	FName WeightedSkillID = GetRandomSkillFromMask(PartyHealingSkillsMask & AvailableSkillsMask);
 	if (WeightedSkillID == NAME_None)
 	{
-		WeightedSkillID = GetAnyRandomSkill(SelfHealingSkills, SkillsToIgnore);
+		WeightedSkillID = GetRandomSkillFromMask(SelfHealingSkillsMask & AvailableSkillsMask);
 	}
 
 	return WeightedSkillID;
@@ -310,14 +247,11 @@ FName UAISkillsComponent::GetWeightedBuffSkillID(bool bPartyBuff) const
 {
 	//~ Prioritize party buffs over solo buffs.
 
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-
 	//~ @todo check if there's even a party before retreiving party buff skills
-	FName WeightedSkillID = GetAnyRandomSkill(PartyBuffSkills, SkillsToIgnore);
+	FName WeightedSkillID = GetRandomSkillFromMask(PartyBuffSkillsMask & AvailableSkillsMask);
 	if (WeightedSkillID == NAME_None)
 	{
-		WeightedSkillID = GetAnyRandomSkill(SelfBuffSkills, SkillsToIgnore);
+		WeightedSkillID = GetRandomSkillFromMask(SelfBuffSkillsMask & AvailableSkillsMask);
 	}
 
 	return WeightedSkillID;
@@ -325,144 +259,168 @@ FName UAISkillsComponent::GetWeightedBuffSkillID(bool bPartyBuff) const
 
 FName UAISkillsComponent::GetWeightedDebuffSkillID() const
 {
-	TArray<FName> SkillsToIgnore;
-	SkillsToIgnore.Add(LastUsedSkillGroup);
-	FName WeightedSkillID = GetAnyRandomSkill(DebuffSkills, SkillsToIgnore);
-	return WeightedSkillID;
+	return GetRandomSkillFromMask(DebuffSkillsMask & AvailableSkillsMask);
 }
 
 void UAISkillsComponent::GenerateSkillTypesList()
 {
-	TArray<FName> Keys;
-	SkillGroupToSkillMap.GetKeys(Keys);
-
-	for (FName Key : Keys)
-	{
-		UAISkillBase* AISkill = Cast<UAISkillBase>(SkillGroupToSkillMap[Key]);
+	MeleeSkills.Empty();
+	RangedSkills.Empty();
+	SelfHealingSkills.Empty();
+	PartyHealingSkills.Empty();
+	SelfBuffSkills.Empty();
+	PartyBuffSkills.Empty();
+	DebuffSkills.Empty();
+
+	SkillGroupsByBit.Reset();
+	SkillGroupsByBit.SetNum(FMath::Min(SkillIndexToSkillMap.Num(), MaxSelectableSkills));
+
+	MeleeSkillsMask = 0;
+	RangedSkillsMask = 0;
+	SelfHealingSkillsMask = 0;
+	PartyHealingSkillsMask = 0;
+	SelfBuffSkillsMask = 0;
+	PartyBuffSkillsMask = 0;
+	DebuffSkillsMask = 0;
+	UnblockableSkillsMask = 0;
+	UndodgableSkillsMask = 0;
+	InterruptSkillsMask = 0;
+	CrowdControlSkillsMask = 0;
+
+	for (const TPair<uint8, UGameplaySkillBase*>& SkillPair : SkillIndexToSkillMap)
+	{
+		UAISkillBase* AISkill = Cast<UAISkillBase>(SkillPair.Value);
 		check(AISkill);
 
+		const FName Key = AISkill->GetSkillGroup();
+		const uint64 SkillBit = GetSkillBit(SkillPair.Key);
+		if (SkillBit == 0)
+		{
+			UE_LOG(LogRaiderZ, Warning, TEXT("Skill %s of %s can't be selected by AI because its skill index exceeds %d"),
+				*Key.ToString(), *GetNameSafe(GetOwner()), MaxSelectableSkills);
+		}
+		else
+		{
+			SkillGroupsByBit[SkillPair.Key - 1] = Key;
+		}
+
 		ESkillEffect SkillEffect = AISkill->GetSkillEffect();
 		switch (SkillEffect)
 		{
 		case ESkillEffect::DamageMelee:
 			MeleeSkills.Add(Key);
+			MeleeSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::DamageRanged:
 			RangedSkills.Add(Key);
+			RangedSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::HealSelf:
 			SelfHealingSkills.Add(Key);
+			SelfHealingSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::HealParty:
 			PartyHealingSkills.Add(Key);
+			PartyHealingSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::BuffSelf:
 			SelfBuffSkills.Add(Key);
+			SelfBuffSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::BuffParty:
 			PartyBuffSkills.Add(Key);
+			PartyBuffSkillsMask |= SkillBit;
 			break;
 		case ESkillEffect::DebuffEnemy:
 			DebuffSkills.Add(Key);
+			DebuffSkillsMask |= SkillBit;
 			break;
 		default:
 			break;
 		}
-	}
-}
 
-FName UAISkillsComponent::GetRandomUnblockableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
-	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
+		const FAISkillInfo& SkillInfo = AISkill->SkillInfo;
+		if (SkillInfo.bUnblockable)
 		{
-			if (AISkill->SkillInfo.bUnblockable)
-			{
-				NormalAttackSkills.Add(Key);
-			}
+			UnblockableSkillsMask |= SkillBit;
+		}
+		if (SkillInfo.bUndodgable)
+		{
+			UndodgableSkillsMask |= SkillBit;
+		}
+		if (SkillInfo.CCEffectInfo.CCEffect == ECrowdControlEffect::Interrupt)
+		{
+			InterruptSkillsMask |= SkillBit;
+		}
+		if (SkillInfo.CCEffectInfo.CCEffect != ECrowdControlEffect::Flinch)
+		{
+			CrowdControlSkillsMask |= SkillBit;
 		}
 	}
-	return GetRandomName(NormalAttackSkills);
+
+	AvailableSkillsMask = MeleeSkillsMask | RangedSkillsMask | SelfHealingSkillsMask | PartyHealingSkillsMask |
+		SelfBuffSkillsMask | PartyBuffSkillsMask | DebuffSkillsMask;
 }
 
-FName UAISkillsComponent::GetRandomUndodgableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+FName UAISkillsComponent::GetWeightedAttackSkillID(uint64 SourceSkillsMask, const AEODCharacterBase* TargetCharacter) const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	/**
+	 * Logic:
+	 *	If enemy is blocking, try and get an unblockable skill.
+	 *	If enemy is under CCE, then try and get a normal skill.
+	 *	If enemy is dodging, then try and get an undodgable skill.
+	 *	If enemy is using a skill, then try and get an interrupt skill.
+	 *	If enemy is doing nothing (Idle-Walk-Run), then try and get any CCE skill.
+	 */
+
+	const uint64 CandidateSkillsMask = SourceSkillsMask & AvailableSkillsMask;
+
+	uint64 WeightedSkillsMask = 0;
+	if (TargetCharacter->IsBlocking())
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.bUndodgable)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		WeightedSkillsMask = CandidateSkillsMask & UnblockableSkillsMask;
+	}
+	else if (TargetCharacter->IsDodging())
+	{
+		WeightedSkillsMask = CandidateSkillsMask & UndodgableSkillsMask;
+	}
+	else if (TargetCharacter->IsUsingAnySkill())
+	{
+		WeightedSkillsMask = CandidateSkillsMask & InterruptSkillsMask;
+	}
+	else if (TargetCharacter->HasBeenHit())
+	{
+		WeightedSkillsMask = CandidateSkillsMask & ~CrowdControlSkillsMask;
+	}
+	else
+	{
+		WeightedSkillsMask = CandidateSkillsMask & CrowdControlSkillsMask;
 	}
-	return GetRandomName(NormalAttackSkills);
-}
 
-FName UAISkillsComponent::GetRandomInterruptSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	FName WeightedSkillID = GetRandomSkillFromMask(WeightedSkillsMask);
+	if (WeightedSkillID == NAME_None)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect != ECrowdControlEffect::Interrupt)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		WeightedSkillID = GetRandomSkillFromMask(SourceSkillsMask);
 	}
-	return GetRandomName(NormalAttackSkills);
+
+	return WeightedSkillID;
 }
 
-FName UAISkillsComponent::GetRandomCCESkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
+FName UAISkillsComponent::GetRandomSkillFromMask(uint64 SkillsMask) const
 {
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	const int32 NumSkills = (int32)FPlatformMath::CountBits(SkillsMask);
+	if (NumSkills == 0)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect != ECrowdControlEffect::Flinch)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		return NAME_None;
 	}
-	return GetRandomName(NormalAttackSkills);
-}
 
-FName UAISkillsComponent::GetRandomNormalSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	TArray<FName> NormalAttackSkills;
-	for (const FName& Key : AvailableSkills)
+	// Clear the lowest set bits until the randomly picked skill is the lowest one left
+	int32 SkillsToSkip = FMath::RandRange(0, NumSkills - 1);
+	for (; SkillsToSkip > 0; --SkillsToSkip)
 	{
-		UAISkillBase* AISkill = SkillGroupToSkillMap.Contains(Key) ? Cast<UAISkillBase>(SkillGroupToSkillMap[Key]) : nullptr;
-		if (AISkill)
-		{
-			if (AISkill->SkillInfo.CCEffectInfo.CCEffect == ECrowdControlEffect::Flinch)
-			{
-				NormalAttackSkills.Add(Key);
-			}
-		}
+		SkillsMask &= SkillsMask - 1;
 	}
-	return GetRandomName(NormalAttackSkills);
-}
 
-FName UAISkillsComponent::GetAnyRandomSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	TArray<FName> AvailableSkills = GetAvailableSkills(SkillSource, SkillsToIgnore);
-	return GetRandomName(AvailableSkills);
+	const int32 SkillBitIndex = (int32)FPlatformMath::CountTrailingZeros64(SkillsMask);
+	return SkillGroupsByBit.IsValidIndex(SkillBitIndex) ? SkillGroupsByBit[SkillBitIndex] : NAME_None;
 }
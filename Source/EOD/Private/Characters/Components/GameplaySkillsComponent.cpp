@@ -8,6 +8,7 @@
 #include "GameplaySkillBase.h"
 #include "EODCharacterMovementComponent.h"
 #include "GameplayEffectBase.h"
+#include "GameplayEffectPoolSubsystem.h"
 
 #include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -249,7 +250,12 @@ void UGameplaySkillsComponent::AddGameplayEffect(UGameplayEffectBase* GameplayEf
 {
 	if (GameplayEffect)
 	{
-		ActiveGameplayEffects.Add(GameplayEffect);
+		bool bAlreadyActive = false;
+		ActiveGameplayEffects.Add(GameplayEffect, &bAlreadyActive);
+		if (!bAlreadyActive)
+		{
+			UpdateActiveGameplayEffectCounts(GameplayEffect, 1);
+		}
 		if (!GameplayEffect->IsActive())
 		{
 			GameplayEffect->ActivateEffect();
@@ -261,11 +267,44 @@ void UGameplaySkillsComponent::RemoveGameplayEffect(UGameplayEffectBase* Gamepla
 {
 	if (GameplayEffect)
 	{
-		ActiveGameplayEffects.Remove(GameplayEffect);
+		int32 NumRemoved = ActiveGameplayEffects.Remove(GameplayEffect);
+		UpdateActiveGameplayEffectCounts(GameplayEffect, -NumRemoved);
 		if (GameplayEffect->IsActive())
 		{
 			GameplayEffect->DeactivateEffect();
 		}
+
+		UWorld* World = GetWorld();
+		UGameplayEffectPoolSubsystem* EffectPool = World ? World->GetSubsystem<UGameplayEffectPoolSubsystem>() : nullptr;
+		if (EffectPool && NumRemoved > 0)
+		{
+			EffectPool->ReleaseGameplayEffect(GameplayEffect);
+		}
+	}
+}
+
+void UGameplaySkillsComponent::UpdateActiveGameplayEffectCounts(UGameplayEffectBase* GameplayEffect, int32 Delta)
+{
+	check(GameplayEffect);
+	if (Delta == 0)
+	{
+		return;
+	}
+
+	UClass* BaseClass = UGameplayEffectBase::StaticClass();
+	for (UClass* EffectClass = GameplayEffect->GetClass(); EffectClass; EffectClass = EffectClass->GetSuperClass())
+	{
+		int32& Count = ActiveGameplayEffectCounts.FindOrAdd(EffectClass);
+		Count += Delta;
+		if (Count <= 0)
+		{
+			ActiveGameplayEffectCounts.Remove(EffectClass);
+		}
+
+		if (EffectClass == BaseClass)
+		{
+			break;
+		}
 	}
 }
 
@@ -291,7 +330,12 @@ void UGameplaySkillsComponent::ActivateGameplayEffect(
 	TArray<AActor*> Targets,
 	bool bDetermineTargetDynamically)
 {
-	UGameplayEffectBase* GameplayEffect = NewObject<UGameplayEffectBase>(this, GameplayEffectClass, NAME_None, RF_Transient);
+	UWorld* World = GetWorld();
+	UGameplayEffectPoolSubsystem* EffectPool = World ? World->GetSubsystem<UGameplayEffectPoolSubsystem>() : nullptr;
+	UGameplayEffectBase* GameplayEffect =
+		EffectPool ?
+		EffectPool->AcquireGameplayEffect(GameplayEffectClass) :
+		NewObject<UGameplayEffectBase>(this, GameplayEffectClass, NAME_None, RF_Transient);
 	check(GameplayEffect);
 
 	TArray<AEODCharacterBase*> TargetChars;
@@ -309,31 +353,16 @@ void UGameplaySkillsComponent::ActivateGameplayEffect(
 
 bool UGameplaySkillsComponent::IsGameplayEffectTypeActive(TSubclassOf<UGameplayEffectBase> GameplayEffectClass, UGameplayEffectBase* GameplayEffectToIgnore)
 {
-	// Following line is just for future syntax reference
-	// TArray<UGameplayEffectBase*> Results = ActiveGameplayEffects.FilterByPredicate([&](UGameplayEffectBase* GE) { return GE->IsA(GameplayEffectClass); });
+	const int32* ActiveCountPtr = ActiveGameplayEffectCounts.Find(GameplayEffectClass.Get());
+	int32 ActiveCount = ActiveCountPtr ? *ActiveCountPtr : 0;
 
-	if (GameplayEffectToIgnore)
+	// The ignored effect only affects the result if it is one of the active effects being counted
+	if (ActiveCount > 0 && GameplayEffectToIgnore && GameplayEffectToIgnore->IsA(GameplayEffectClass) && ActiveGameplayEffects.Contains(GameplayEffectToIgnore))
 	{
-		for (UGameplayEffectBase* GameplayEffect : ActiveGameplayEffects)
-		{
-			if (GameplayEffect->IsA(GameplayEffectClass))
-			{
-				return true;
-			}
-		}
-	}
-	else
-	{
-		for (UGameplayEffectBase* GameplayEffect : ActiveGameplayEffects)
-		{
-			if (GameplayEffect != GameplayEffectToIgnore && GameplayEffect->IsA(GameplayEffectClass))
-			{
-				return true;
-			}
-		}
+		ActiveCount -= 1;
 	}
 
-	return false;
+	return ActiveCount > 0;
 }
 
 void UGameplaySkillsComponent::Server_TriggerSkill_Implementation(uint8 SkillIndex)
@@ -352,11 +352,12 @@ void UPlayerSkillsComponent::AddGameplayEffect(UGameplayEffectBase* GameplayEffe
 
 void UPlayerSkillsComponent::RemoveGameplayEffect(UGameplayEffectBase* GameplayEffect)
 {
-	Super::RemoveGameplayEffect(GameplayEffect);
+	// The UI is removed first, since removing the effect releases it to the pool and resets it
 	if (GameplayEffect && GameplayEffect->Icon && HUDWidget)
 	{
 		HUDWidget->RemoveGameplayEffectUI(GameplayEffect);
 	}
+	Super::RemoveGameplayEffect(GameplayEffect);
 }
 
 TArray<uint8> UPlayerSkillsComponent::GetSkillBarIndicesOfSkillGroup(FName SkillGroup)
@@ -1,10 +1,10 @@
 // Copyright 2018 Moikkai Games. All Rights Reserved.
 
 #include "StatsComponentBase.h"
+#include "RegenerationSubsystem.h"
 #include "EOD.h"
 
 #include "UnrealNetwork.h"
-#include "TimerManager.h"
 #include "Engine/World.h"
 
 UStatsComponentBase::UStatsComponentBase(const FObjectInitializer& ObjectInitializer) :
@@ -33,7 +33,8 @@ UStatsComponentBase::UStatsComponentBase(const FObjectInitializer& ObjectInitial
 	SpellCastingSpeedModifier(1.f),
 	StaminaConsumptionModifier(1.f),
 	PhysicalDamageReductionOnBlock(10.f),
-	MagickalDamageReductionOnBlock(10.f)
+	MagickalDamageReductionOnBlock(10.f),
+	RegenEntryIndex(INDEX_NONE)
 {
 	// This compnent doesn't tick
 	PrimaryComponentTick.bCanEverTick = false;
@@ -107,6 +108,20 @@ void UStatsComponentBase::BeginPlay()
 	//~ @todo Load stat values
 }
 
+void UStatsComponentBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem)
+	{
+		RegenSubsystem->StopAllRegeneration(this);
+	}
+	bIsRegeneratingHealth = false;
+	bIsRegeneratingMana = false;
+	bIsRegeneratingStamina = false;
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UStatsComponentBase::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
@@ -161,72 +176,60 @@ void UStatsComponentBase::OnStaminaChanged(int32 MaxValue, int32 CurrentValue)
 
 void UStatsComponentBase::ActivateHealthRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World && HealthRegenTickInterval > 0.f)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem && HealthRegenTickInterval > 0.f)
 	{
-		World->GetTimerManager().SetTimer(HealthRegenTimerHandle,
-			this,
-			&UStatsComponentBase::RegenerateHealth,
-			HealthRegenTickInterval,
-			true);
+		RegenSubsystem->StartRegeneration(this, EStatRegenType::Health);
 		bIsRegeneratingHealth = true;
 	}
 }
 
 void UStatsComponentBase::ActivateManaRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World && ManaRegenTickInterval > 0.f)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem && ManaRegenTickInterval > 0.f)
 	{
-		World->GetTimerManager().SetTimer(ManaRegenTimerHandle,
-			this,
-			&UStatsComponentBase::RegenerateMana,
-			ManaRegenTickInterval,
-			true);
+		RegenSubsystem->StartRegeneration(this, EStatRegenType::Mana);
 		bIsRegeneratingMana = true;
 	}
 }
 
 void UStatsComponentBase::ActivateStaminaRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World && StaminaRegenTickInterval > 0.f)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem && StaminaRegenTickInterval > 0.f)
 	{
-		World->GetTimerManager().SetTimer(StaminaRegenTimerHandle,
-			this,
-			&UStatsComponentBase::RegenerateStamina,
-			StaminaRegenTickInterval,
-			true);
+		RegenSubsystem->StartRegeneration(this, EStatRegenType::Stamina);
 		bIsRegeneratingStamina = true;
 	}
 }
 
 void UStatsComponentBase::DeactivateHealthRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem)
 	{
-		World->GetTimerManager().ClearTimer(HealthRegenTimerHandle);
+		RegenSubsystem->StopRegeneration(this, EStatRegenType::Health);
 	}
 	bIsRegeneratingHealth = false;
 }
 
 void UStatsComponentBase::DeactivateManaRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem)
 	{
-		World->GetTimerManager().ClearTimer(ManaRegenTimerHandle);
+		RegenSubsystem->StopRegeneration(this, EStatRegenType::Mana);
 	}
 	bIsRegeneratingMana = false;
 }
 
 void UStatsComponentBase::DeactivateStaminaRegeneration()
 {
-	UWorld* World = GetWorld();
-	if (World)
+	URegenerationSubsystem* RegenSubsystem = GetRegenerationSubsystem();
+	if (RegenSubsystem)
 	{
-		World->GetTimerManager().ClearTimer(StaminaRegenTimerHandle);
+		RegenSubsystem->StopRegeneration(this, EStatRegenType::Stamina);
 	}
 	bIsRegeneratingStamina = false;
 }
@@ -269,3 +272,42 @@ void UStatsComponentBase::RegenerateStamina()
 		DeactivateStaminaRegeneration();
 	}
 }
+
+void UStatsComponentBase::Regenerate(EStatRegenType StatType)
+{
+	switch (StatType)
+	{
+	case EStatRegenType::Health:
+		RegenerateHealth();
+		break;
+	case EStatRegenType::Mana:
+		RegenerateMana();
+		break;
+	case EStatRegenType::Stamina:
+		RegenerateStamina();
+		break;
+	default:
+		break;
+	}
+}
+
+float UStatsComponentBase::GetRegenTickInterval(EStatRegenType StatType) const
+{
+	switch (StatType)
+	{
+	case EStatRegenType::Health:
+		return HealthRegenTickInterval;
+	case EStatRegenType::Mana:
+		return ManaRegenTickInterval;
+	case EStatRegenType::Stamina:
+		return StaminaRegenTickInterval;
+	default:
+		return 0.f;
+	}
+}
+
+URegenerationSubsystem* UStatsComponentBase::GetRegenerationSubsystem() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<URegenerationSubsystem>() : nullptr;
+}
@@ -5,6 +5,7 @@
 #include "CharAnimInstance.h"
 #include "InteractionInterface.h"
 #include "EODBlueprintFunctionLibrary.h"
+#include "CombatMath.h"
 #include "EODPlayerController.h"
 #include "EODAIControllerBase.h"
 #include "StatsComponentBase.h"
@@ -22,6 +23,7 @@
 #include "EODWidgetComponent.h"
 #include "DamageNumberWidget.h"
 #include "EODLevelScriptActor.h"
+#include "CharacterGridSubsystem.h"
 
 #include "IdleWalkRunState.h"
 #include "DeadState.h"
@@ -55,6 +57,8 @@ AEODCharacterBase::AEODCharacterBase(const FObjectInitializer& ObjectInitializer
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	CombatRandomStream.GenerateNewSeed();
+
 	SkillManager = ObjectInitializer.CreateDefaultSubobject<UGameplaySkillsComponent>(this, AEODCharacterBase::GameplaySkillsComponentName);
 	CameraBoomComponent = ObjectInitializer.CreateDefaultSubobject<USpringArmComponent>(this, AEODCharacterBase::SpringArmComponentName);
 	if (CameraBoomComponent)
@@ -190,6 +194,25 @@ void AEODCharacterBase::BeginPlay()
 	{
 		MoveComp->SetDesiredCustomRotation(GetActorRotation());
 	}
+
+	UWorld* World = GetWorld();
+	UCharacterGridSubsystem* CharacterGrid = World ? World->GetSubsystem<UCharacterGridSubsystem>() : nullptr;
+	if (CharacterGrid)
+	{
+		CharacterGrid->RegisterCharacter(this);
+	}
+}
+
+void AEODCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UWorld* World = GetWorld();
+	UCharacterGridSubsystem* CharacterGrid = World ? World->GetSubsystem<UCharacterGridSubsystem>() : nullptr;
+	if (CharacterGrid)
+	{
+		CharacterGrid->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AEODCharacterBase::PostInitializeComponents()
@@ -484,7 +507,7 @@ void AEODCharacterBase::PushBack_Implementation(const FVector& ImpulseDirection)
 {
 }
 
-void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr)
+void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo)
 {
 	UAttackDodgedEvent* DodgeEvent = NewObject<UAttackDodgedEvent>(this, UAttackDodgedEvent::StaticClass(), FName("DodgeEvent"), RF_Transient);
 	DodgeEvent->AddToRoot();
@@ -493,7 +516,7 @@ void AEODCharacterBase::DodgeAttack(AActor* HitInstigator, ICombatInterface* Ins
 	DodgeEvent->MarkPendingKill();
 }
 
-void AEODCharacterBase::BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr)
+void AEODCharacterBase::BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo)
 {
 	//~ @todo block event
 	PlayAttackBlockedAnimation();
@@ -618,34 +641,45 @@ AActor* AEODCharacterBase::GetInterfaceOwner()
 	return this;
 }
 
-TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex)
+bool AEODCharacterBase::GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
 	UGameplaySkillBase* Skill = SkillManager ? SkillManager->GetSkillForSkillGroup(SkillGroup) : nullptr;
-	TSharedPtr<FAttackInfo> AttackInfoPtr = Skill ? Skill->GetAttackInfoPtr(CollisionIndex) : TSharedPtr<FAttackInfo>();
-	return AttackInfoPtr;
+	return Skill ? Skill->GetAttackInfo(OutAttackInfo, CollisionIndex) : false;
 }
 
-TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
+bool AEODCharacterBase::ReceiveAttack(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const FHitResult& DirectHitResult,
 	const bool bLineHitResultFound,
-	const FHitResult& LineHitResult)
+	const FHitResult& LineHitResult,
+	FAttackResponse& OutAttackResponse)
 {
 	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (!StatsComp || !InstigatorCI || !AttackInfoPtr.IsValid())
+	if (!StatsComp || !InstigatorCI)
 	{
-		return TSharedPtr<FAttackResponse>();
+		return false;
 	}
 
+	FCombatDefenderState DefenderState;
+	DefenderState.Forward = GetActorForwardVector();
+	DefenderState.bDodgingDamage = IsDodgingDamage();
+	DefenderState.bBlockingDamage = IsBlockingDamage();
+	DefenderState.PhysicalDamageReductionOnBlock = StatsComp->PhysicalDamageReductionOnBlock.GetValue();
+	DefenderState.MagickalDamageReductionOnBlock = StatsComp->MagickalDamageReductionOnBlock.GetValue();
+
+	const FVector& ImpactNormal = bLineHitResultFound ? LineHitResult.ImpactNormal : DirectHitResult.ImpactNormal;
+	FCombatHitOutcome Outcome;
+	FCombatMath::ResolveHit(AttackInfo, DefenderState, ImpactNormal, bLineHitResultFound, CombatRandomStream, Outcome);
+
 	FReceivedHitInfo ReceivedHitInfo;
 	ReceivedHitInfo.HitInstigator = HitInstigator;
 
 	// Handle dodge
-	if (!AttackInfoPtr->bUndodgable && this->IsDodgingDamage())
+	if (Outcome.DamageResult == EDamageResult::Dodged)
 	{
-		DodgeAttack(HitInstigator, InstigatorCI, AttackInfoPtr);
+		DodgeAttack(HitInstigator, InstigatorCI, AttackInfo);
 
 		// Replicate Hit Info
 		ReceivedHitInfo.DamageResult = EDamageResult::Dodged;
@@ -653,15 +687,15 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 		SetLastReceivedHitInfo(ReceivedHitInfo);
 
 
-		TSharedPtr<FAttackResponse> AttackResponsePtr = TSharedPtr<FAttackResponse>(new FAttackResponse);
-		AttackResponsePtr->DamageResult = EDamageResult::Dodged;
-		return AttackResponsePtr;
+		OutAttackResponse = FAttackResponse();
+		OutAttackResponse.DamageResult = EDamageResult::Dodged;
+		return true;
 	}
 
 	//~ possible alternative to current damage blocking
 	/*
 	bool bAttackBlocked = false;
-	if (!AttackInfoPtr->bUnblockable && this->IsBlockingDamage())
+	if (!AttackInfo.bUnblockable && this->IsBlockingDamage())
 	{
 		const FVector& HIVec = HitInstigator->GetActorForwardVector();
 		const FVector& ForVec = this->GetActorForwardVector();
@@ -674,41 +708,31 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 	}
 	*/
 
-	ReceivedHitInfo.bCritHit = AttackInfoPtr->CritRate >= FMath::RandRange(0.f, 100.f) ? true : false;
+	ReceivedHitInfo.bCritHit = Outcome.bCritHit;
+	ReceivedHitInfo.BCAngle = Outcome.BCAngle;
+	ReceivedHitInfo.DamageResult = Outcome.DamageResult;
 
-	bool bAttackBlocked = false;
-	if (bLineHitResultFound)
-	{
-		ReceivedHitInfo.BCAngle = UEODBlueprintFunctionLibrary::CalculateAngleBetweenVectors(GetActorForwardVector(), LineHitResult.ImpactNormal);
-		if (!AttackInfoPtr->bUnblockable && this->IsBlockingDamage())
-		{
-			bAttackBlocked = ReceivedHitInfo.BCAngle < UCombatLibrary::BlockDetectionAngle ? true : false;
-			if (bAttackBlocked)
-			{
-				BlockAttack(HitInstigator, InstigatorCI, AttackInfoPtr);
-				ReceivedHitInfo.DamageResult = EDamageResult::Blocked;
-			}
-		}
-	}
-	else
+	const bool bAttackBlocked = Outcome.bAttackBlocked;
+	if (bAttackBlocked)
 	{
-		ReceivedHitInfo.BCAngle = UEODBlueprintFunctionLibrary::CalculateAngleBetweenVectors(GetActorForwardVector(), DirectHitResult.ImpactNormal);
+		BlockAttack(HitInstigator, InstigatorCI, AttackInfo);
 	}
 
 	bool bCCEApplied = ApplyCCE(
 		HitInstigator,
-		AttackInfoPtr->CrowdControlEffect,
-		AttackInfoPtr->CrowdControlEffectDuration,
+		AttackInfo.CrowdControlEffect,
+		AttackInfo.CrowdControlEffectDuration,
 		ReceivedHitInfo.BCAngle,
 		bAttackBlocked);
 
-	ReceivedHitInfo.CrowdControlEffect = bCCEApplied ? AttackInfoPtr->CrowdControlEffect : ECrowdControlEffect::Flinch;
-	ReceivedHitInfo.CrowdControlEffectDuration = AttackInfoPtr->CrowdControlEffectDuration;
-	ReceivedHitInfo.ActualDamage = GetActualDamage(HitInstigator, InstigatorCI, AttackInfoPtr, ReceivedHitInfo.bCritHit, bAttackBlocked);
+	ReceivedHitInfo.CrowdControlEffect = bCCEApplied ? AttackInfo.CrowdControlEffect : ECrowdControlEffect::Flinch;
+	ReceivedHitInfo.CrowdControlEffectDuration = AttackInfo.CrowdControlEffectDuration;
 
-	if (!bAttackBlocked && ReceivedHitInfo.ActualDamage == 0)
+	// Damage goes through the GetActualDamage virtual, so subclasses that override it still change the damage they receive
+	ReceivedHitInfo.ActualDamage = GetActualDamage(HitInstigator, InstigatorCI, AttackInfo, Outcome.bCritHit, bAttackBlocked);
+	if (!bAttackBlocked)
 	{
-		ReceivedHitInfo.DamageResult = EDamageResult::Nullified;
+		ReceivedHitInfo.DamageResult = ReceivedHitInfo.ActualDamage == 0 ? EDamageResult::Nullified : EDamageResult::Damaged;
 	}
 
 	ReceivedHitInfo.HitLocation = bLineHitResultFound ? LineHitResult.ImpactPoint : DirectHitResult.ImpactPoint;
@@ -718,7 +742,7 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 		ReceivedHitInfo.HitSurface = PhysMat->SurfaceType;
 	}
 
-	ReceivedHitInfo.CamShakeType = AttackInfoPtr->CamShakeType;
+	ReceivedHitInfo.CamShakeType = AttackInfo.CamShakeType;
 
 	ReceivedHitInfo.ReplicationIndex = GetLastReceivedHitInfo().ReplicationIndex + 1;
 	SetLastReceivedHitInfo(ReceivedHitInfo);
@@ -726,61 +750,36 @@ TSharedPtr<FAttackResponse> AEODCharacterBase::ReceiveAttack(
 	StatsComp->Health.ModifyCurrentValue(-ReceivedHitInfo.ActualDamage);
 	TriggerReceivedHitCosmetics(ReceivedHitInfo);
 
-	TSharedPtr<FAttackResponse> AttackResponsePtr = 
-		TSharedPtr<FAttackResponse>(
-			new FAttackResponse(
-				ReceivedHitInfo.DamageResult,
-				ReceivedHitInfo.CrowdControlEffect,
-				ReceivedHitInfo.ActualDamage,
-				ReceivedHitInfo.bCritHit
-			));
+	OutAttackResponse =
+		FAttackResponse(
+			ReceivedHitInfo.DamageResult,
+			ReceivedHitInfo.CrowdControlEffect,
+			ReceivedHitInfo.ActualDamage,
+			ReceivedHitInfo.bCritHit
+		);
 
-	return AttackResponsePtr;
+	return true;
 }
 
 float AEODCharacterBase::GetActualDamage(
 	AActor* HitInstigator,
 	ICombatInterface* InstigatorCI,
-	const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+	const FAttackInfo& AttackInfo,
 	const bool bCritHit,
 	const bool bAttackBlocked)
 {
-	float ActualDamage = 0.f;
-
 	UStatsComponentBase* StatsComp = GetStatsComponent();
-	if (!StatsComp || !AttackInfoPtr.IsValid())
+	if (!StatsComp)
 	{
-		return ActualDamage;
+		return 0.f;
 	}
 
-	if (bCritHit)
-	{
-		ActualDamage = AttackInfoPtr->CritDamage;
-	}
-	else
-	{
-		ActualDamage = AttackInfoPtr->NormalDamage;
-	}
+	float DamageReductionOnBlock =
+		AttackInfo.DamageType == EDamageType::Magickal ?
+		StatsComp->MagickalDamageReductionOnBlock.GetValue() :
+		StatsComp->PhysicalDamageReductionOnBlock.GetValue();
 
-	if (bAttackBlocked)
-	{
-		float DamageReductionOnBlock = 0.1f;
-		if (StatsComp)
-		{
-			if (AttackInfoPtr->DamageType == EDamageType::Magickal)
-			{
-				DamageReductionOnBlock = StatsComp->MagickalDamageReductionOnBlock.GetValue();
-			}
-			else
-			{
-				DamageReductionOnBlock = StatsComp->PhysicalDamageReductionOnBlock.GetValue();
-			}
-		}
-		DamageReductionOnBlock = DamageReductionOnBlock > 100.f ? 100.f : DamageReductionOnBlock;
-		ActualDamage = ActualDamage * (1 - DamageReductionOnBlock / 100.f);
-	}
-
-	return ActualDamage;
+	return FCombatMath::GetActualDamage(AttackInfo, bCritHit, bAttackBlocked, DamageReductionOnBlock);
 }
 
 void AEODCharacterBase::TriggerReceivedHitCosmetics(const FReceivedHitInfo& HitInfo)
@@ -922,11 +921,11 @@ bool AEODCharacterBase::ApplyCCE(
 	return bCCEApplied;
 }
 
-TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtrFromNormalAttack(const FString& NormalAttackStr)
+bool AEODCharacterBase::GetAttackInfoFromNormalAttack(const FString& NormalAttackStr, FAttackInfo& OutAttackInfo)
 {
 	if (GetLocalRole() < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	int32 NormalAttackIndex = GetAttackIndexFromNormalAttackString(NormalAttackStr);
@@ -980,8 +979,8 @@ TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtrFromNormalAttack(cons
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
+	OutAttackInfo =
+		FAttackInfo(
 			false,
 			false,
 			CritRate,
@@ -991,9 +990,9 @@ TSharedPtr<FAttackInfo> AEODCharacterBase::GetAttackInfoPtrFromNormalAttack(cons
 			ECrowdControlEffect::Flinch,
 			0.f,
 			ECameraShakeType::Weak
-		));
+		);
 
-	return AttackInfoPtr;
+	return true;
 }
 
 EWeaponType AEODCharacterBase::GetWeaponTypeFromNormalAttackString(const FString& NormalAttackStr)
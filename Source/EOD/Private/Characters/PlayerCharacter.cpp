@@ -337,23 +337,22 @@ void APlayerCharacter::LoadCharacterState()
 	*/
 }
 
-TSharedPtr<FAttackInfo> APlayerCharacter::GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex)
+bool APlayerCharacter::GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo)
 {
 	const FString& SkillGroupStr = SkillGroup.ToString();
 	if (SkillGroupStr.Contains("-normal-"))
 	{
-		return GetAttackInfoPtrFromNormalAttack(SkillGroupStr);
+		return GetAttackInfoFromNormalAttack(SkillGroupStr, OutAttackInfo);
 	}
 	else
 	{
 		UGameplaySkillsComponent* SkillComp = GetGameplaySkillsComponent();
 		UGameplaySkillBase* Skill = SkillComp ? SkillComp->GetSkillForSkillGroup(SkillGroup) : nullptr;
-		TSharedPtr<FAttackInfo> AttackInfoPtr = Skill ? Skill->GetAttackInfoPtr(CollisionIndex) : TSharedPtr<FAttackInfo>();
-		return AttackInfoPtr;
+		return Skill ? Skill->GetAttackInfo(OutAttackInfo, CollisionIndex) : false;
 	}
 }
 
-void APlayerCharacter::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors)
+void APlayerCharacter::PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors)
 {
 	LastAttackResponses = AttackResponses;
 	if (AttackResponses.Num() == 0)
@@ -0,0 +1,175 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CharacterGridSubsystem.h"
+#include "EODCharacterBase.h"
+
+#include "Engine/World.h"
+
+const float UCharacterGridSubsystem::CellSize = 1000.f;
+const int32 UCharacterGridSubsystem::MaxCellUpdatesPerTick = 64;
+
+void UCharacterGridSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+	Cells.Empty();
+	NextUpdateIndex = 0;
+
+	Super::Deinitialize();
+}
+
+void UCharacterGridSubsystem::Tick(float DeltaTime)
+{
+	const int32 NumUpdates = FMath::Min(Entries.Num(), MaxCellUpdatesPerTick);
+	for (int32 UpdateCount = 0; UpdateCount < NumUpdates && Entries.Num() > 0; ++UpdateCount)
+	{
+		if (NextUpdateIndex >= Entries.Num())
+		{
+			NextUpdateIndex = 0;
+		}
+
+		// A removed entry gets replaced by the last entry, which is then refreshed in its place
+		if (UpdateEntry(NextUpdateIndex))
+		{
+			++NextUpdateIndex;
+		}
+		else
+		{
+			RemoveEntryAt(NextUpdateIndex);
+		}
+	}
+}
+
+bool UCharacterGridSubsystem::IsTickable() const
+{
+	if (IsTemplate() || Entries.Num() == 0)
+	{
+		return false;
+	}
+
+	// Editor preview worlds have no gameplay that needs the grid
+	UWorld* World = GetWorld();
+	return World && World->IsGameWorld();
+}
+
+UWorld* UCharacterGridSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UCharacterGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterGridSubsystem, STATGROUP_Tickables);
+}
+
+void UCharacterGridSubsystem::RegisterCharacter(AEODCharacterBase* Character)
+{
+	check(Character);
+	const FObjectKey CharacterKey(Character);
+	if (EntryIndices.Contains(CharacterKey))
+	{
+		return;
+	}
+
+	FCharacterGridEntry NewEntry;
+	NewEntry.Character = Character;
+	NewEntry.CharacterKey = CharacterKey;
+	NewEntry.Cell = GetCellForLocation(Character->GetActorLocation());
+	EntryIndices.Add(CharacterKey, Entries.Add(NewEntry));
+	AddToCell(NewEntry.Character, NewEntry.Cell);
+}
+
+void UCharacterGridSubsystem::UnregisterCharacter(AEODCharacterBase* Character)
+{
+	int32* EntryIndexPtr = EntryIndices.Find(FObjectKey(Character));
+	if (EntryIndexPtr)
+	{
+		RemoveEntryAt(*EntryIndexPtr);
+	}
+}
+
+void UCharacterGridSubsystem::GetCharactersInRadius(const FVector& Origin, float Radius, TArray<AEODCharacterBase*>& OutCharacters, const AEODCharacterBase* IgnoredCharacter) const
+{
+	const FIntPoint MinCell = GetCellForLocation(Origin - FVector(Radius, Radius, 0.f));
+	const FIntPoint MaxCell = GetCellForLocation(Origin + FVector(Radius, Radius, 0.f));
+	const float RadiusSquared = Radius * Radius;
+
+	for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+	{
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			const TArray<TWeakObjectPtr<AEODCharacterBase>, TInlineAllocator<4>>* CellCharacters = Cells.Find(FIntPoint(CellX, CellY));
+			if (!CellCharacters)
+			{
+				continue;
+			}
+
+			for (const TWeakObjectPtr<AEODCharacterBase>& WeakCharacter : *CellCharacters)
+			{
+				AEODCharacterBase* Character = WeakCharacter.Get();
+				if (Character && Character != IgnoredCharacter &&
+					FVector::DistSquared(Origin, Character->GetActorLocation()) < RadiusSquared)
+				{
+					OutCharacters.Add(Character);
+				}
+			}
+		}
+	}
+}
+
+FIntPoint UCharacterGridSubsystem::GetCellForLocation(const FVector& Location)
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+void UCharacterGridSubsystem::AddToCell(const TWeakObjectPtr<AEODCharacterBase>& Character, const FIntPoint& Cell)
+{
+	Cells.FindOrAdd(Cell).Add(Character);
+}
+
+void UCharacterGridSubsystem::RemoveFromCell(const TWeakObjectPtr<AEODCharacterBase>& Character, const FIntPoint& Cell)
+{
+	TArray<TWeakObjectPtr<AEODCharacterBase>, TInlineAllocator<4>>* CellCharacters = Cells.Find(Cell);
+	if (CellCharacters)
+	{
+		// Stale pointers compare equal to each other, which is fine since any one of them can go
+		CellCharacters->RemoveSingleSwap(Character, false);
+		if (CellCharacters->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+bool UCharacterGridSubsystem::UpdateEntry(int32 EntryIndex)
+{
+	FCharacterGridEntry& Entry = Entries[EntryIndex];
+	AEODCharacterBase* Character = Entry.Character.Get();
+	if (!Character)
+	{
+		return false;
+	}
+
+	const FIntPoint NewCell = GetCellForLocation(Character->GetActorLocation());
+	if (NewCell != Entry.Cell)
+	{
+		RemoveFromCell(Entry.Character, Entry.Cell);
+		AddToCell(Entry.Character, NewCell);
+		Entry.Cell = NewCell;
+	}
+	return true;
+}
+
+void UCharacterGridSubsystem::RemoveEntryAt(int32 EntryIndex)
+{
+	// The character may already be garbage collected, so cells and indices are cleaned up through its weak pointer and key
+	const FCharacterGridEntry& RemovedEntry = Entries[EntryIndex];
+	RemoveFromCell(RemovedEntry.Character, RemovedEntry.Cell);
+	EntryIndices.Remove(RemovedEntry.CharacterKey);
+
+	Entries.RemoveAtSwap(EntryIndex, 1, false);
+	if (Entries.IsValidIndex(EntryIndex))
+	{
+		EntryIndices.Add(Entries[EntryIndex].CharacterKey, EntryIndex);
+	}
+}
@@ -14,6 +14,8 @@
 ACombatManager::ACombatManager(const FObjectInitializer & ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = false;
+	bProcessingAttack = false;
+	LastPendingAttackID = 0;
 
 	SetReplicates(false);
 	SetReplicateMovement(false);
@@ -22,6 +24,8 @@ ACombatManager::ACombatManager(const FObjectInitializer & ObjectInitializer) : S
 void ACombatManager::BeginPlay()
 {
 	Super::BeginPlay();
+
+	LineOfSightTraceDelegate.BindUObject(this, &ACombatManager::OnLineOfSightTraceDone);
 }
 
 void ACombatManager::Tick(float DeltaTime)
@@ -41,42 +45,54 @@ void ACombatManager::OnMeleeAttack(
 		return;
 	}
 
-	TArray<FAttackResponse> AttackResponses;
-	TArray<AActor*> HitActors;
-	if (HitResults.Num() == 0)
+	// Attacks can be triggered from within another attack, e.g. by a damage or death callback. The shared buffers
+	// are still in use by the outer attack then, so the nested attack gets its own
+	TArray<FAttackResponse> NestedAttackResponses;
+	TArray<AActor*> NestedHitActors;
+	TSet<AActor*> NestedProcessedActors;
+	const bool bNestedAttack = bProcessingAttack;
+	TArray<FAttackResponse>& AttackResponses = bNestedAttack ? NestedAttackResponses : AttackResponseBuffer;
+	TArray<AActor*>& HitActors = bNestedAttack ? NestedHitActors : HitActorBuffer;
+	TSet<AActor*>& ProcessedActors = bNestedAttack ? NestedProcessedActors : ProcessedActorSet;
+	TGuardValue<bool> ProcessingAttackGuard(bProcessingAttack, true);
+
+	AttackResponses.Reset();
+	HitActors.Reset();
+	ProcessedActors.Reset();
+
+	FAttackInfo AttackInfo;
+	bool bAttackInfoValid = HitResults.Num() > 0 && InstigatorCI->GetAttackInfo(CollisionSkillInfo.SkillGroup, CollisionSkillInfo.CollisionIndex, AttackInfo);
+	if (bAttackInfoValid && CollisionSkillInfo.bAsyncLineOfSight)
 	{
-		InstigatorCI->PostAttack(AttackResponses, HitActors);
+		QueueMeleeAttack(HitInstigator, InstigatorCI, AttackInfo, HitResults, ProcessedActors);
 		return;
 	}
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr = InstigatorCI->GetAttackInfoPtr(CollisionSkillInfo.SkillGroup, CollisionSkillInfo.CollisionIndex);
-	TArray<TSharedPtr<FAttackResponse>> AttackResponsePtrs;
-	for (const FHitResult& HitResult : HitResults)
+	if (bAttackInfoValid)
 	{
-		AActor* HitActor = HitResult.GetActor();
-		// Multiple components of an actor can register multiple hits. We want to avoid damaging the same actor more than one time
-		if (HitActors.Contains(HitActor))
+		for (const FHitResult& HitResult : HitResults)
 		{
-			continue;
-		}
+			AActor* HitActor = HitResult.GetActor();
+			// Multiple components of an actor can register multiple hits. We want to avoid damaging the same actor more than one time
+			if (!HitActor || ProcessedActors.Contains(HitActor))
+			{
+				continue;
+			}
 
-		ICombatInterface* TargetCI = Cast<ICombatInterface>(HitActor);
+			ICombatInterface* TargetCI = Cast<ICombatInterface>(HitActor);
 
-		// Do not process if the hit actor does not implement a combat interface
-		if (!TargetCI)
-		{
-			continue;
-		}
+			// Do not process if the hit actor does not implement a combat interface
+			if (!TargetCI)
+			{
+				continue;
+			}
 
-		TSharedPtr<FAttackResponse> AttackResponsePtr = ProcessAttack(HitInstigator, InstigatorCI, AttackInfoPtr, HitActor, TargetCI, HitResult);
-		if (AttackResponsePtr.IsValid())
-		{
-			AttackResponsePtrs.Add(AttackResponsePtr);
-			HitActors.Add(HitActor);
-			FAttackResponse* ResponsePtr = AttackResponsePtr.Get();
-			if (ResponsePtr)
+			FAttackResponse AttackResponse;
+			if (ProcessAttack(HitInstigator, InstigatorCI, AttackInfo, HitActor, TargetCI, HitResult, AttackResponse))
 			{
-				AttackResponses.Add(*ResponsePtr);
+				ProcessedActors.Add(HitActor);
+				HitActors.Add(HitActor);
+				AttackResponses.Add(AttackResponse);
 			}
 		}
 	}
@@ -84,23 +100,27 @@ void ACombatManager::OnMeleeAttack(
 	InstigatorCI->PostAttack(AttackResponses, HitActors);
 }
 
-TSharedPtr<FAttackResponse> ACombatManager::ProcessAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr, AActor* HitTarget, ICombatInterface* TargetCI, const FHitResult& HitResult)
+bool ACombatManager::ProcessAttack(
+	AActor* HitInstigator,
+	ICombatInterface* InstigatorCI,
+	const FAttackInfo& AttackInfo,
+	AActor* HitTarget,
+	ICombatInterface* TargetCI,
+	const FHitResult& HitResult,
+	FAttackResponse& OutAttackResponse)
 {
 	check(InstigatorCI && TargetCI);
 
-	TSharedPtr<FAttackResponse> DamageResponsePtr(nullptr);
-	if (!AttackInfoPtr.IsValid() || !InstigatorCI->IsEnemyOf(TargetCI))
+	if (!InstigatorCI->IsEnemyOf(TargetCI))
 	{
-		return DamageResponsePtr;
+		return false;
 	}
 
 	FHitResult LineHitResult;
 	bool bLineHitResultFound;
 	GetLineHitResult(HitInstigator, HitResult.GetComponent(), LineHitResult, bLineHitResultFound);
 
-	DamageResponsePtr = TargetCI->ReceiveAttack(HitInstigator, InstigatorCI, AttackInfoPtr, HitResult, bLineHitResultFound, LineHitResult);
-
-	return DamageResponsePtr;
+	return TargetCI->ReceiveAttack(HitInstigator, InstigatorCI, AttackInfo, HitResult, bLineHitResultFound, LineHitResult, OutAttackResponse);
 }
 
 void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const AActor* HitTarget, FHitResult& OutHitResult, bool& bOutLineHitResultFound) const
@@ -116,9 +136,8 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const AActor*
 	FVector LineEnd = HitTarget->GetActorLocation();
 	LineEnd.Z = LineStart.Z < LineEnd.Z ? LineStart.Z : LineEnd.Z;
 
-	TArray<FHitResult> LineHitResults;
-	GetWorld()->LineTraceMultiByChannel(LineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
-	for (FHitResult& LineHitResult : LineHitResults)
+	GetWorld()->LineTraceMultiByChannel(LineHitResultBuffer, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
+	for (const FHitResult& LineHitResult : LineHitResultBuffer)
 	{
 		if (LineHitResult.GetActor() == HitTarget)
 		{
@@ -138,13 +157,27 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const UPrimit
 	}
 
 	FCollisionQueryParams QueryParams = UCombatLibrary::GenerateCombatCollisionQueryParams(HitInstigator);
-	FVector LineStart = HitInstigator->GetActorLocation();
-	FVector LineEnd = HitComponent->GetComponentLocation();
-	LineEnd.Z = LineStart.Z < LineEnd.Z ? LineStart.Z : LineEnd.Z;
+	FVector LineStart;
+	FVector LineEnd;
+	GetLineTraceEndpoints(HitInstigator, HitComponent, LineStart, LineEnd);
+
+	GetWorld()->LineTraceMultiByChannel(LineHitResultBuffer, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
+	FindLineHitResult(LineHitResultBuffer, HitComponent, OutHitResult, bOutLineHitResultFound);
+}
+
+void ACombatManager::GetLineTraceEndpoints(const AActor* HitInstigator, const UPrimitiveComponent* HitComponent, FVector& OutLineStart, FVector& OutLineEnd)
+{
+	check(HitInstigator && HitComponent);
+
+	OutLineStart = HitInstigator->GetActorLocation();
+	OutLineEnd = HitComponent->GetComponentLocation();
+	OutLineEnd.Z = OutLineStart.Z < OutLineEnd.Z ? OutLineStart.Z : OutLineEnd.Z;
+}
 
-	TArray<FHitResult> LineHitResults;
-	GetWorld()->LineTraceMultiByChannel(LineHitResults, LineStart, LineEnd, COLLISION_COMBAT, QueryParams);
-	for (FHitResult& LineHitResult : LineHitResults)
+void ACombatManager::FindLineHitResult(const TArray<FHitResult>& LineHitResults, const UPrimitiveComponent* HitComponent, FHitResult& OutHitResult, bool& bOutLineHitResultFound)
+{
+	bOutLineHitResultFound = false;
+	for (const FHitResult& LineHitResult : LineHitResults)
 	{
 		if (LineHitResult.GetComponent() == HitComponent)
 		{
@@ -155,6 +188,175 @@ void ACombatManager::GetLineHitResult(const AActor* HitInstigator, const UPrimit
 	}
 }
 
+void ACombatManager::QueueMeleeAttack(
+	AActor* HitInstigator,
+	ICombatInterface* InstigatorCI,
+	const FAttackInfo& AttackInfo,
+	const TArray<FHitResult>& HitResults,
+	TSet<AActor*>& ProcessedActors)
+{
+	check(HitInstigator && InstigatorCI);
+
+	UWorld* World = GetWorld();
+	check(World);
+
+	// Attack ID 0 is never used so that a zeroed trace user data can't resolve to a pending attack
+	LastPendingAttackID = LastPendingAttackID == MAX_uint32 ? 1 : LastPendingAttackID + 1;
+	const uint32 AttackID = LastPendingAttackID;
+
+	// Built locally and only added once all traces are queued, since a nested attack triggered by ReceiveAttack may add to PendingMeleeAttacks
+	FPendingMeleeAttack PendingAttack;
+	PendingAttack.HitInstigator = HitInstigator;
+	PendingAttack.AttackInfo = AttackInfo;
+
+	FCollisionQueryParams QueryParams = UCombatLibrary::GenerateCombatCollisionQueryParams(HitInstigator);
+	for (const FHitResult& HitResult : HitResults)
+	{
+		AActor* HitActor = HitResult.GetActor();
+		// Multiple components of an actor can register multiple hits. We want to avoid damaging the same actor more than one time
+		if (!HitActor || ProcessedActors.Contains(HitActor))
+		{
+			continue;
+		}
+
+		ICombatInterface* TargetCI = Cast<ICombatInterface>(HitActor);
+		if (!TargetCI || !InstigatorCI->IsEnemyOf(TargetCI))
+		{
+			continue;
+		}
+
+		ProcessedActors.Add(HitActor);
+
+		UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+		if (!IsValid(HitComponent))
+		{
+			// There is nothing to trace against, so the hit can be resolved right away without a line hit result
+			FAttackResponse AttackResponse;
+			if (TargetCI->ReceiveAttack(HitInstigator, InstigatorCI, AttackInfo, HitResult, false, FHitResult(), AttackResponse))
+			{
+				PendingAttack.AttackResponses.Add(AttackResponse);
+				PendingAttack.HitActors.Add(HitActor);
+			}
+			continue;
+		}
+
+		FVector LineStart;
+		FVector LineEnd;
+		GetLineTraceEndpoints(HitInstigator, HitComponent, LineStart, LineEnd);
+
+		FPendingMeleeHit PendingHit;
+		PendingHit.HitTarget = HitActor;
+		PendingHit.HitComponent = HitComponent;
+		PendingHit.DirectHitResult = HitResult;
+		PendingHit.TraceHandle = World->AsyncLineTraceByChannel(
+			EAsyncTraceType::Multi,
+			LineStart,
+			LineEnd,
+			COLLISION_COMBAT,
+			QueryParams,
+			FCollisionResponseParams::DefaultResponseParam,
+			&LineOfSightTraceDelegate,
+			AttackID);
+
+		PendingAttack.PendingHits.Add(PendingHit);
+	}
+
+	const bool bHasPendingHits = PendingAttack.PendingHits.Num() > 0;
+	PendingMeleeAttacks.Add(AttackID, MoveTemp(PendingAttack));
+	if (!bHasPendingHits)
+	{
+		FinishPendingMeleeAttack(AttackID);
+	}
+}
+
+void ACombatManager::OnLineOfSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const uint32 AttackID = TraceDatum.UserData;
+	FPendingMeleeAttack* PendingAttack = PendingMeleeAttacks.Find(AttackID);
+	if (!PendingAttack)
+	{
+		return;
+	}
+
+	int32 HitIndex = PendingAttack->PendingHits.IndexOfByPredicate([&TraceHandle](const FPendingMeleeHit& PendingHit)
+	{
+		return PendingHit.TraceHandle == TraceHandle;
+	});
+
+	if (HitIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FPendingMeleeHit PendingHit = PendingAttack->PendingHits[HitIndex];
+	PendingAttack->PendingHits.RemoveAtSwap(HitIndex);
+
+	AActor* HitInstigator = PendingAttack->HitInstigator.Get();
+	AActor* HitTarget = PendingHit.HitTarget.Get();
+	UPrimitiveComponent* HitComponent = PendingHit.HitComponent.Get();
+	ICombatInterface* InstigatorCI = Cast<ICombatInterface>(HitInstigator);
+	ICombatInterface* TargetCI = Cast<ICombatInterface>(HitTarget);
+
+	// Either actor may have been destroyed while the trace was in flight
+	if (InstigatorCI && TargetCI && HitComponent)
+	{
+		FHitResult LineHitResult;
+		bool bLineHitResultFound;
+		FindLineHitResult(TraceDatum.OutHits, HitComponent, LineHitResult, bLineHitResultFound);
+
+		FAttackResponse AttackResponse;
+		const bool bAttackReceived = TargetCI->ReceiveAttack(HitInstigator, InstigatorCI, PendingAttack->AttackInfo, PendingHit.DirectHitResult, bLineHitResultFound, LineHitResult, AttackResponse);
+
+		// ReceiveAttack can trigger a nested attack that adds to PendingMeleeAttacks and moves this attack
+		PendingAttack = PendingMeleeAttacks.Find(AttackID);
+		if (!PendingAttack)
+		{
+			return;
+		}
+
+		if (bAttackReceived)
+		{
+			PendingAttack->AttackResponses.Add(AttackResponse);
+			PendingAttack->HitActors.Add(HitTarget);
+		}
+	}
+
+	if (PendingAttack->PendingHits.Num() == 0)
+	{
+		FinishPendingMeleeAttack(AttackID);
+	}
+}
+
+void ACombatManager::FinishPendingMeleeAttack(uint32 AttackID)
+{
+	FPendingMeleeAttack PendingAttack;
+	if (!PendingMeleeAttacks.RemoveAndCopyValue(AttackID, PendingAttack))
+	{
+		return;
+	}
+
+	AActor* HitInstigator = PendingAttack.HitInstigator.Get();
+	ICombatInterface* InstigatorCI = Cast<ICombatInterface>(HitInstigator);
+	if (!InstigatorCI)
+	{
+		return;
+	}
+
+	TArray<AActor*> HitActors;
+	TArray<FAttackResponse> AttackResponses;
+	for (int32 Index = 0; Index < PendingAttack.HitActors.Num(); ++Index)
+	{
+		AActor* HitActor = PendingAttack.HitActors[Index].Get();
+		if (HitActor)
+		{
+			HitActors.Add(HitActor);
+			AttackResponses.Add(PendingAttack.AttackResponses[Index]);
+		}
+	}
+
+	InstigatorCI->PostAttack(AttackResponses, HitActors);
+}
+
 bool ACombatManager::AreEnemies(AEODCharacterBase* CharOne, AEODCharacterBase* CharTwo)
 {
 	ICombatInterface* CIOne = Cast<ICombatInterface>(CharOne);
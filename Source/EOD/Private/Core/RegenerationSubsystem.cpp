@@ -0,0 +1,132 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RegenerationSubsystem.h"
+
+void URegenerationSubsystem::Deinitialize()
+{
+	for (const FStatRegenEntry& Entry : RegenEntries)
+	{
+		UStatsComponentBase* StatsComponent = Entry.Component.Get();
+		if (StatsComponent)
+		{
+			StatsComponent->RegenEntryIndex = INDEX_NONE;
+		}
+	}
+	RegenEntries.Empty();
+
+	Super::Deinitialize();
+}
+
+void URegenerationSubsystem::Tick(float DeltaTime)
+{
+	int32 EntryIndex = 0;
+	while (EntryIndex < RegenEntries.Num())
+	{
+		UStatsComponentBase* StatsComponent = RegenEntries[EntryIndex].Component.Get();
+		if (!StatsComponent || RegenEntries[EntryIndex].ActiveStatsMask == 0)
+		{
+			RemoveEntryAt(EntryIndex);
+			continue;
+		}
+
+		for (uint8 StatIndex = 0; StatIndex < (uint8)EStatRegenType::MAX; ++StatIndex)
+		{
+			if (!(RegenEntries[EntryIndex].ActiveStatsMask & (1 << StatIndex)))
+			{
+				continue;
+			}
+
+			const EStatRegenType StatType = (EStatRegenType)StatIndex;
+			const float TickInterval = StatsComponent->GetRegenTickInterval(StatType);
+
+			// Regenerating a stat can start or stop regeneration on any component, which may reallocate RegenEntries.
+			// So the entry is always accessed through its index.
+			RegenEntries[EntryIndex].TimeUntilNextTick[StatIndex] -= DeltaTime;
+			while ((RegenEntries[EntryIndex].ActiveStatsMask & (1 << StatIndex)) && RegenEntries[EntryIndex].TimeUntilNextTick[StatIndex] <= 0.f)
+			{
+				RegenEntries[EntryIndex].TimeUntilNextTick[StatIndex] += TickInterval;
+				StatsComponent->Regenerate(StatType);
+			}
+		}
+
+		++EntryIndex;
+	}
+}
+
+bool URegenerationSubsystem::IsTickable() const
+{
+	return RegenEntries.Num() > 0 && !IsTemplate();
+}
+
+UWorld* URegenerationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId URegenerationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URegenerationSubsystem, STATGROUP_Tickables);
+}
+
+void URegenerationSubsystem::StartRegeneration(UStatsComponentBase* StatsComponent, EStatRegenType StatType)
+{
+	check(StatsComponent);
+
+	const float TickInterval = StatsComponent->GetRegenTickInterval(StatType);
+	if (TickInterval <= 0.f)
+	{
+		return;
+	}
+
+	if (!RegenEntries.IsValidIndex(StatsComponent->RegenEntryIndex) || RegenEntries[StatsComponent->RegenEntryIndex].Component.Get() != StatsComponent)
+	{
+		FStatRegenEntry NewEntry;
+		NewEntry.Component = StatsComponent;
+		StatsComponent->RegenEntryIndex = RegenEntries.Add(NewEntry);
+	}
+
+	const uint8 StatIndex = (uint8)StatType;
+	FStatRegenEntry& Entry = RegenEntries[StatsComponent->RegenEntryIndex];
+	Entry.ActiveStatsMask |= (1 << StatIndex);
+	Entry.TimeUntilNextTick[StatIndex] = TickInterval;
+}
+
+void URegenerationSubsystem::StopRegeneration(UStatsComponentBase* StatsComponent, EStatRegenType StatType)
+{
+	check(StatsComponent);
+
+	// The entry itself is removed on next tick so that stopping regeneration never shuffles entries while they are being ticked
+	if (RegenEntries.IsValidIndex(StatsComponent->RegenEntryIndex) && RegenEntries[StatsComponent->RegenEntryIndex].Component.Get() == StatsComponent)
+	{
+		RegenEntries[StatsComponent->RegenEntryIndex].ActiveStatsMask &= ~(1 << (uint8)StatType);
+	}
+}
+
+void URegenerationSubsystem::StopAllRegeneration(UStatsComponentBase* StatsComponent)
+{
+	check(StatsComponent);
+
+	if (RegenEntries.IsValidIndex(StatsComponent->RegenEntryIndex) && RegenEntries[StatsComponent->RegenEntryIndex].Component.Get() == StatsComponent)
+	{
+		RegenEntries[StatsComponent->RegenEntryIndex].ActiveStatsMask = 0;
+	}
+}
+
+void URegenerationSubsystem::RemoveEntryAt(int32 EntryIndex)
+{
+	UStatsComponentBase* RemovedComponent = RegenEntries[EntryIndex].Component.Get();
+	if (RemovedComponent)
+	{
+		RemovedComponent->RegenEntryIndex = INDEX_NONE;
+	}
+
+	RegenEntries.RemoveAtSwap(EntryIndex, 1, false);
+	if (RegenEntries.IsValidIndex(EntryIndex))
+	{
+		UStatsComponentBase* MovedComponent = RegenEntries[EntryIndex].Component.Get();
+		if (MovedComponent)
+		{
+			MovedComponent->RegenEntryIndex = EntryIndex;
+		}
+	}
+}
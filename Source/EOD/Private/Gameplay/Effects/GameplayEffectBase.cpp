@@ -5,6 +5,8 @@
 #include "EODCharacterBase.h"
 #include "GameplaySkillsComponent.h"
 
+#include "Engine/BlueprintGeneratedClass.h"
+
 UGameplayEffectBase::UGameplayEffectBase(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 }
@@ -36,6 +38,27 @@ void UGameplayEffectBase::InitEffect(AEODCharacterBase* Instigator, TArray<AEODC
 	}
 }
 
+void UGameplayEffectBase::ResetEffect()
+{
+	// Restore every property to its class default, including the Blueprint variables and native properties of subclasses,
+	// so that a recycled effect behaves exactly like a freshly created one.
+	UObject* EffectDefaults = GetClass()->GetDefaultObject();
+	for (TFieldIterator<FProperty> PropIt(GetClass()); PropIt; ++PropIt)
+	{
+		FProperty* Property = *PropIt;
+
+		// Instanced subobjects belong to this instance and the uber graph frame holds the Blueprint's own VM state
+		UBlueprintGeneratedClass* OwnerBPClass = Cast<UBlueprintGeneratedClass>(Property->GetOwnerClass());
+		bool bIsUberGraphFrame = OwnerBPClass && OwnerBPClass->UberGraphFramePointerProperty == Property;
+		if (bIsUberGraphFrame || Property->HasAnyPropertyFlags(CPF_InstancedReference | CPF_ContainsInstancedReference))
+		{
+			continue;
+		}
+
+		Property->CopyCompleteValue_InContainer(this, EffectDefaults);
+	}
+}
+
 void UGameplayEffectBase::ActivateEffect_Implementation()
 {
 	bActive = true;
@@ -0,0 +1,48 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "GameplayEffectPoolSubsystem.h"
+#include "GameplayEffectBase.h"
+
+const int32 UGameplayEffectPoolSubsystem::MaxFreeEffectsPerClass = 32;
+
+void UGameplayEffectPoolSubsystem::Deinitialize()
+{
+	EffectPools.Empty();
+
+	Super::Deinitialize();
+}
+
+UGameplayEffectBase* UGameplayEffectPoolSubsystem::AcquireGameplayEffect(UClass* GameplayEffectClass)
+{
+	check(GameplayEffectClass && GameplayEffectClass->IsChildOf(UGameplayEffectBase::StaticClass()));
+
+	FGameplayEffectPool* Pool = EffectPools.Find(GameplayEffectClass);
+	while (Pool && Pool->FreeEffects.Num() > 0)
+	{
+		UGameplayEffectBase* GameplayEffect = Pool->FreeEffects.Pop(false);
+		// An effect can get marked pending kill by its owner after it has been released to the pool
+		if (IsValid(GameplayEffect))
+		{
+			return GameplayEffect;
+		}
+	}
+
+	// Outer the effects to this pool rather than to the component that applies them so that they can be reused across characters
+	return NewObject<UGameplayEffectBase>(this, GameplayEffectClass, NAME_None, RF_Transient);
+}
+
+void UGameplayEffectPoolSubsystem::ReleaseGameplayEffect(UGameplayEffectBase* GameplayEffect)
+{
+	if (!IsValid(GameplayEffect) || GameplayEffect->GetOuter() != this)
+	{
+		return;
+	}
+
+	GameplayEffect->ResetEffect();
+
+	FGameplayEffectPool& Pool = EffectPools.FindOrAdd(GameplayEffect->GetClass());
+	if (Pool.FreeEffects.Num() < MaxFreeEffectsPerClass)
+	{
+		Pool.FreeEffects.AddUnique(GameplayEffect);
+	}
+}
@@ -24,6 +24,21 @@ void UMovementBuff::InitEffect(AEODCharacterBase* Instigator, TArray<AEODCharact
 	}
 }
 
+void UMovementBuff::ResetEffect()
+{
+	// An effect released without being deactivated still has its timer running, which would deactivate the effect after it has been reused.
+	// The timer is cleared before the base class resets the instigator it was set through
+	AEODCharacterBase* Instigator = EffectInstigator.Get();
+	UWorld* World = Instigator ? Instigator->GetWorld() : GetWorld();
+	if (World)
+	{
+		World->GetTimerManager().ClearTimer(MovementEndTimerHandle);
+	}
+	MovementEndTimerHandle.Invalidate();
+
+	Super::ResetEffect();
+}
+
 void UMovementBuff::ActivateEffect_Implementation()
 {
 	AEODCharacterBase* Instigator = EffectInstigator.Get();
@@ -84,12 +84,12 @@ void UAISkillBase::FinishSkill()
 	// LoseCCImmunities();
 }
 
-TSharedPtr<FAttackInfo> UAISkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UAISkillBase::GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex)
 {
 	AEODCharacterBase* Instigator = SkillInstigator.Get();
 	if (Instigator->GetLocalRole() < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	AEODAIControllerBase* AIC = Instigator ? Cast<AEODAIControllerBase>(Instigator->Controller) : nullptr;
@@ -106,8 +106,8 @@ TSharedPtr<FAttackInfo> UAISkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
+	OutAttackInfo =
+		FAttackInfo(
 			SkillInfo.bUndodgable,
 			SkillInfo.bUnblockable,
 			CritRate,
@@ -117,7 +117,7 @@ TSharedPtr<FAttackInfo> UAISkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 			SkillInfo.CCEffectInfo.CCEffect,
 			SkillInfo.CCEffectInfo.CCDuration,
 			CamShakeType
-		));
+		);
 
-	return AttackInfoPtr;
+	return true;
 }
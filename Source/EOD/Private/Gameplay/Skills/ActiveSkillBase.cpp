@@ -288,12 +288,12 @@ void UActiveSkillBase::LoseCCImmunities()
 	}
 }
 
-TSharedPtr<FAttackInfo> UActiveSkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UActiveSkillBase::GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex)
 {
 	AEODCharacterBase* Instigator = SkillInstigator.Get();
 	if (Instigator->GetLocalRole() < ROLE_Authority)
 	{
-		return TSharedPtr<FAttackInfo>();
+		return false;
 	}
 
 	AEODPlayerController* PC = Instigator ? Cast<AEODPlayerController>(Instigator->Controller) : nullptr;
@@ -311,8 +311,8 @@ TSharedPtr<FAttackInfo> UActiveSkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 		(NormalDamage * UCombatLibrary::MagickalCritMultiplier + StatsComp->MagickalCritBonus.GetValue()) :
 		(NormalDamage * UCombatLibrary::PhysicalCritMultiplier + StatsComp->PhysicalCritBonus.GetValue());
 
-	TSharedPtr<FAttackInfo> AttackInfoPtr =
-		MakeShareable(new FAttackInfo(
+	OutAttackInfo =
+		FAttackInfo(
 			SkillInfo.bUndodgable,
 			SkillInfo.bUnblockable,
 			CritRate,
@@ -322,9 +322,9 @@ TSharedPtr<FAttackInfo> UActiveSkillBase::GetAttackInfoPtr(int32 CollisionIndex)
 			SkillInfo.CrowdControlEffect,
 			SkillInfo.CrowdControlEffectDuration,
 			CamShakeType
-		));
+		);
 
-	return AttackInfoPtr;
+	return true;
 }
 
 void UActiveSkillBase::LoadFemaleAnimations()
@@ -58,9 +58,9 @@ void UGameplaySkillBase::FinishSkill()
 	}
 }
 
-TSharedPtr<FAttackInfo> UGameplaySkillBase::GetAttackInfoPtr(int32 CollisionIndex)
+bool UGameplaySkillBase::GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex)
 {
-	return TSharedPtr<FAttackInfo>(nullptr);
+	return false;
 }
 
 bool UGameplaySkillBase::CanCancelSkill() const
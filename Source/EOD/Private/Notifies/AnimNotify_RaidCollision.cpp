@@ -15,65 +15,143 @@
 void UAnimNotify_RaidCollision::Notify(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation)
 {
 	UWorld* World = MeshComp ? MeshComp->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	TArray<FRaidWorldCapsule, TInlineAllocator<8>> WorldCapsules;
+	GetWorldCapsules(MeshComp->GetComponentTransform(), WorldCapsules);
 
 #if EOD_DRAWING_DEBUG_SHAPES_ENABLED
-	if (World)
+	for (const FRaidWorldCapsule& Capsule : WorldCapsules)
 	{
-		for (FRaidCapsule& Capsule : CollisionCapsules)
-		{
-			FTransform WorldTransform = MeshComp->GetComponentTransform();
+		UKismetSystemLibrary::DrawDebugCapsule(MeshComp, Capsule.Center, Capsule.HalfHeight, Capsule.Radius, Capsule.Rotation.Rotator(), FLinearColor::White, 5.f, 1.f);
+	}
+#endif
 
-			FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
-			FVector NormalizedHeightVector = HalfHeightVector.GetSafeNormal();
-			FVector Center = CorrectedBottom + HalfHeightVector;
-			FRotator CapsuleRotation = FRotationMatrix::MakeFromZ(HalfHeightVector).Rotator();
+	// Only process this notify if the current game mode is ACombatZoneModeBase
+	ACombatZoneModeBase* CombatZoneGameMode = Cast<ACombatZoneModeBase>(World->GetAuthGameMode());
+	ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
+	if (!CombatManager)
+	{
+		return;
+	}
 
-			// Transformation from object space to world space
-			FVector TransformedCenter = WorldTransform.TransformPosition(Center);
-			FRotator TransformedRotation = WorldTransform.TransformRotation(CapsuleRotation.Quaternion()).Rotator();
+	AActor* Owner = MeshComp->GetOwner();
+	FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
+	TArray<FHitResult> HitResults;
+	bool bHit = SweepWorldCapsules(World, WorldCapsules, Params, HitResults);
 
-			UKismetSystemLibrary::DrawDebugCapsule(MeshComp, TransformedCenter, HalfHeightVector.Size(), Capsule.Radius, TransformedRotation, FLinearColor::White, 5.f, 1.f);
-		}
+	// All capsules of this notify belong to a single attack, so the combat manager should only receive a single attack event
+	CombatManager->OnMeleeAttack(Owner, bHit, HitResults, SkillInfo);
+}
+
+void UAnimNotify_RaidCollision::GetWorldCapsules(const FTransform& WorldTransform, TArray<FRaidWorldCapsule, TInlineAllocator<8>>& OutCapsules) const
+{
+	OutCapsules.Reset(CollisionCapsules.Num());
+	for (const FRaidCapsule& Capsule : CollisionCapsules)
+	{
+		FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
+		FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
+		FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
+		FVector Center = CorrectedBottom + HalfHeightVector;
+		FQuat CapsuleRotation = FRotationMatrix::MakeFromZ(HalfHeightVector).ToQuat();
+
+		// Transformation from object space to world space
+		FRaidWorldCapsule WorldCapsule;
+		WorldCapsule.Center = WorldTransform.TransformPosition(Center);
+		WorldCapsule.Rotation = WorldTransform.TransformRotation(CapsuleRotation);
+		WorldCapsule.HalfHeight = HalfHeightVector.Size();
+		WorldCapsule.Radius = Capsule.Radius;
+		OutCapsules.Add(WorldCapsule);
+	}
+}
+
+bool UAnimNotify_RaidCollision::SweepWorldCapsules(UWorld* World, const TArray<FRaidWorldCapsule, TInlineAllocator<8>>& Capsules, const FCollisionQueryParams& Params, TArray<FHitResult>& OutHitResults) const
+{
+	check(World);
+	OutHitResults.Reset();
+	if (Capsules.Num() == 0)
+	{
+		return false;
 	}
-#endif
 
-	if (World)
+	// A single capsule is swept as is. Multiple capsules are swept as one sphere that encloses all of them, and the
+	// candidates it returns are then filtered against the individual capsules.
+	FVector SweepCenter;
+	FQuat SweepRotation;
+	FCollisionShape SweepShape;
+	if (Capsules.Num() == 1)
 	{
-		// Only process this notify if the current game mode is ACombatZoneModeBase
-		ACombatZoneModeBase* CombatZoneGameMode = Cast<ACombatZoneModeBase>(World->GetAuthGameMode());
-		ACombatManager* CombatManager = CombatZoneGameMode ? CombatZoneGameMode->GetCombatManager() : nullptr;
-		if (!CombatManager)
+		SweepCenter = Capsules[0].Center;
+		SweepRotation = Capsules[0].Rotation;
+		SweepShape = FCollisionShape::MakeCapsule(Capsules[0].Radius, Capsules[0].HalfHeight);
+	}
+	else
+	{
+		FBox Bounds(ForceInit);
+		float MaxRadius = 0.f;
+		for (const FRaidWorldCapsule& Capsule : Capsules)
 		{
-			return;
+			FVector Extent = Capsule.Rotation.GetAxisZ() * Capsule.HalfHeight;
+			Bounds += Capsule.Center + Extent;
+			Bounds += Capsule.Center - Extent;
+			MaxRadius = FMath::Max(MaxRadius, Capsule.Radius);
 		}
 
-		for (FRaidCapsule& Capsule : CollisionCapsules)
+		SweepCenter = Bounds.GetCenter();
+		SweepRotation = FQuat::Identity;
+		SweepShape = FCollisionShape::MakeSphere(Bounds.GetExtent().Size() + MaxRadius);
+	}
+
+	// If trace start and end position is same, the trace doesn't hit anything.
+	FVector End = SweepCenter + FVector(0.f, 0.f, 1.f);
+	TArray<FHitResult> CandidateHitResults;
+	World->SweepMultiByChannel(CandidateHitResults, SweepCenter, End, SweepRotation, COLLISION_COMBAT, SweepShape, Params);
+
+	TSet<AActor*, DefaultKeyFuncs<AActor*>, TInlineSetAllocator<16>> HitActors;
+	for (const FHitResult& HitResult : CandidateHitResults)
+	{
+		if (Capsules.Num() > 1 && !IsHitInsideAnyCapsule(HitResult, Capsules))
 		{
-			FTransform WorldTransform = MeshComp->GetComponentTransform();
+			continue;
+		}
 
-			FVector CorrectedBottom = Capsule.Bottom.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector CorrectedTop = Capsule.Top.RotateAngleAxis(90.f, FVector(0.f, 0.f, 1.f));
-			FVector HalfHeightVector = (CorrectedTop - CorrectedBottom) / 2;
-			FVector NormalizedHeightVector = HalfHeightVector.GetSafeNormal();
-			FVector Center = CorrectedBottom + HalfHeightVector;
-			FRotator CapsuleRotation = FRotationMatrix::MakeFromZ(HalfHeightVector).Rotator();
+		AActor* HitActor = HitResult.GetActor();
+		// An actor overlapped by more than one capsule must only be processed once
+		bool bAlreadyHit = false;
+		if (HitActor)
+		{
+			HitActors.Add(HitActor, &bAlreadyHit);
+		}
 
-			// Transformation from object space to world space
-			FVector TransformedCenter = WorldTransform.TransformPosition(Center);
-			FRotator TransformedRotation = WorldTransform.TransformRotation(CapsuleRotation.Quaternion()).Rotator();
+		if (!bAlreadyHit)
+		{
+			OutHitResults.Add(HitResult);
+		}
+	}
 
-			AActor* Owner = MeshComp->GetOwner();
+	return OutHitResults.Num() > 0;
+}
 
-			FCollisionShape CollisionShape = FCollisionShape::MakeCapsule(Capsule.Radius, HalfHeightVector.Size());
-			FCollisionQueryParams Params = UCombatLibrary::GenerateCombatCollisionQueryParams(Owner);
-			TArray<FHitResult> HitResults;
+bool UAnimNotify_RaidCollision::IsHitInsideAnyCapsule(const FHitResult& HitResult, const TArray<FRaidWorldCapsule, TInlineAllocator<8>>& Capsules)
+{
+	UPrimitiveComponent* HitComponent = HitResult.GetComponent();
+	if (!HitComponent)
+	{
+		return false;
+	}
 
-			// If trace start and end position is same, the trace doesn't hit anything.
-			FVector End = TransformedCenter + FVector(0.f, 0.f, 1.f);
-			bool bHit = World->SweepMultiByChannel(HitResults, TransformedCenter, End, TransformedRotation.Quaternion(), COLLISION_COMBAT, CollisionShape, Params);
-			CombatManager->OnMeleeAttack(Owner, bHit, HitResults, SkillInfo);
+	// The enclosing sweep only finds candidates. Each one is tested against the exact shape of every capsule,
+	// which is as precise as sweeping the capsules one by one but doesn't query the whole scene again
+	for (const FRaidWorldCapsule& Capsule : Capsules)
+	{
+		if (HitComponent->OverlapComponent(Capsule.Center, Capsule.Rotation, FCollisionShape::MakeCapsule(Capsule.Radius, Capsule.HalfHeight)))
+		{
+			return true;
 		}
 	}
+
+	return false;
 }
@@ -0,0 +1,137 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatMath.h"
+#include "EOD.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+bool FCombatMath::RollCritHit(float CritRate, FRandomStream& RandomStream)
+{
+	return CritRate >= RandomStream.FRandRange(0.f, 100.f);
+}
+
+float FCombatMath::CalculateAngleBetweenVectors(const FVector& Vector1, const FVector& Vector2)
+{
+	FVector NormalizedVec1 = Vector1.GetSafeNormal();
+	FVector NormalizedVec2 = Vector2.GetSafeNormal();
+	return FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(NormalizedVec1, NormalizedVec2)));
+}
+
+float FCombatMath::GetActualDamage(const FAttackInfo& AttackInfo, const bool bCritHit, const bool bAttackBlocked, float DamageReductionOnBlock)
+{
+	float ActualDamage = FMath::Max(bCritHit ? AttackInfo.CritDamage : AttackInfo.NormalDamage, 0.f);
+	if (bAttackBlocked)
+	{
+		// Blocking can at most negate the damage, and a negative reduction must never amplify it
+		DamageReductionOnBlock = FMath::Clamp(DamageReductionOnBlock, 0.f, 100.f);
+		ActualDamage = ActualDamage * (1 - DamageReductionOnBlock / 100.f);
+	}
+	return ActualDamage;
+}
+
+void FCombatMath::ResolveHit(
+	const FAttackInfo& AttackInfo,
+	const FCombatDefenderState& Defender,
+	const FVector& ImpactNormal,
+	const bool bLineHitResultFound,
+	FRandomStream& RandomStream,
+	FCombatHitOutcome& OutOutcome)
+{
+	OutOutcome = FCombatHitOutcome();
+
+	if (!AttackInfo.bUndodgable && Defender.bDodgingDamage)
+	{
+		OutOutcome.DamageResult = EDamageResult::Dodged;
+		return;
+	}
+
+	OutOutcome.bCritHit = RollCritHit(AttackInfo.CritRate, RandomStream);
+	OutOutcome.BCAngle = CalculateAngleBetweenVectors(Defender.Forward, ImpactNormal);
+
+	// Only an attack that has a clear line of sight to the defender can be blocked
+	if (bLineHitResultFound && !AttackInfo.bUnblockable && Defender.bBlockingDamage)
+	{
+		OutOutcome.bAttackBlocked = OutOutcome.BCAngle < UCombatLibrary::BlockDetectionAngle;
+		if (OutOutcome.bAttackBlocked)
+		{
+			OutOutcome.DamageResult = EDamageResult::Blocked;
+		}
+	}
+
+	float DamageReductionOnBlock = AttackInfo.DamageType == EDamageType::Magickal ? Defender.MagickalDamageReductionOnBlock : Defender.PhysicalDamageReductionOnBlock;
+	OutOutcome.ActualDamage = GetActualDamage(AttackInfo, OutOutcome.bCritHit, OutOutcome.bAttackBlocked, DamageReductionOnBlock);
+
+	if (!OutOutcome.bAttackBlocked && OutOutcome.ActualDamage == 0)
+	{
+		OutOutcome.DamageResult = EDamageResult::Nullified;
+	}
+}
+
+void FCombatMath::RunBenchmark(int32 NumHits, int32 Seed, FCombatBenchmarkResult& OutResult)
+{
+	OutResult = FCombatBenchmarkResult();
+	NumHits = FMath::Max(NumHits, 0);
+
+	// Generate the inputs up front so that only the hit resolution gets timed
+	FRandomStream InputStream(Seed);
+	TArray<FAttackInfo> Attacks;
+	TArray<FCombatDefenderState> Defenders;
+	TArray<FVector> ImpactNormals;
+	Attacks.Reserve(NumHits);
+	Defenders.Reserve(NumHits);
+	ImpactNormals.Reserve(NumHits);
+	for (int32 Index = 0; Index < NumHits; ++Index)
+	{
+		FAttackInfo AttackInfo;
+		AttackInfo.bUndodgable = InputStream.FRand() < 0.1f;
+		AttackInfo.bUnblockable = InputStream.FRand() < 0.1f;
+		AttackInfo.CritRate = InputStream.FRandRange(0.f, 50.f);
+		AttackInfo.NormalDamage = InputStream.FRandRange(0.f, 1000.f);
+		AttackInfo.CritDamage = AttackInfo.NormalDamage * UCombatLibrary::PhysicalCritMultiplier;
+		AttackInfo.DamageType = InputStream.FRand() < 0.5f ? EDamageType::Physical : EDamageType::Magickal;
+		Attacks.Add(AttackInfo);
+
+		FCombatDefenderState Defender;
+		Defender.Forward = InputStream.GetUnitVector();
+		Defender.bDodgingDamage = InputStream.FRand() < 0.1f;
+		Defender.bBlockingDamage = InputStream.FRand() < 0.3f;
+		Defender.PhysicalDamageReductionOnBlock = InputStream.FRandRange(0.f, 100.f);
+		Defender.MagickalDamageReductionOnBlock = InputStream.FRandRange(0.f, 100.f);
+		Defenders.Add(Defender);
+
+		ImpactNormals.Add(InputStream.GetUnitVector());
+	}
+
+	FRandomStream RandomStream(Seed);
+	FCombatHitOutcome Outcome;
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumHits; ++Index)
+	{
+		ResolveHit(Attacks[Index], Defenders[Index], ImpactNormals[Index], (Index & 1) == 0, RandomStream, Outcome);
+
+		OutResult.TotalDamage += Outcome.ActualDamage;
+		OutResult.NumCritHits += Outcome.bCritHit ? 1 : 0;
+		OutResult.NumBlockedHits += Outcome.bAttackBlocked ? 1 : 0;
+		OutResult.NumDodgedHits += Outcome.DamageResult == EDamageResult::Dodged ? 1 : 0;
+	}
+	OutResult.Seconds = FPlatformTime::Seconds() - StartTime;
+	OutResult.NumHits = NumHits;
+	OutResult.HitsPerSecond = OutResult.Seconds > 0.0 ? NumHits / OutResult.Seconds : 0.0;
+}
+
+static FAutoConsoleCommand CombatMathBenchmarkCommand(
+	TEXT("EOD.CombatMathBenchmark"),
+	TEXT("Resolves randomly generated attacks without a world and logs the hits resolved per second. Usage: EOD.CombatMathBenchmark [NumHits] [Seed]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic([](const TArray<FString>& Args)
+	{
+		int32 NumHits = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000000;
+		int32 Seed = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 0;
+
+		FCombatBenchmarkResult Result;
+		FCombatMath::RunBenchmark(NumHits, Seed, Result);
+
+		UE_LOG(LogRaiderZ, Log, TEXT("Combat math benchmark: %d hits in %.4f seconds (%.0f hits/s). Seed: %d, total damage: %lld, crits: %d, blocked: %d, dodged: %d"),
+			Result.NumHits, Result.Seconds, Result.HitsPerSecond, Seed, Result.TotalDamage, Result.NumCritHits, Result.NumBlockedHits, Result.NumDodgedHits);
+	})
+);
@@ -2,6 +2,7 @@
 
 #include "EODBlueprintFunctionLibrary.h"
 #include "CustomEODSettings.h"
+#include "CombatMath.h"
 
 #include "GameFramework/Actor.h"
 
@@ -17,9 +18,7 @@ float UEODBlueprintFunctionLibrary::CalculateYawDiffBetweenRotators(const FRotat
 
 float UEODBlueprintFunctionLibrary::CalculateAngleBetweenVectors(const FVector& Vector1, const FVector& Vector2)
 {
-	FVector NormalizedVec1 = Vector1.GetSafeNormal();
-	FVector NormalizedVec2 = Vector2.GetSafeNormal();
-	return FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(NormalizedVec1, NormalizedVec2)));
+	return FCombatMath::CalculateAngleBetweenVectors(Vector1, Vector2);
 }
 
 float UEODBlueprintFunctionLibrary::FindDeltaAngleDegrees(const float& A1, const float& A2)
@@ -0,0 +1,184 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "CombatMath.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CombatMathTests
+{
+	/** Crit rolls are drawn from [0, 100), so a negative crit rate never lands a critical hit */
+	const float NoCritRate = -1.f;
+
+	static FAttackInfo MakeAttack(float NormalDamage, float CritRate)
+	{
+		FAttackInfo AttackInfo;
+		AttackInfo.CritRate = CritRate;
+		AttackInfo.NormalDamage = NormalDamage;
+		AttackInfo.CritDamage = NormalDamage * UCombatLibrary::PhysicalCritMultiplier;
+		AttackInfo.DamageType = EDamageType::Physical;
+		return AttackInfo;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathDodgeTest, "EOD.CombatMath.ResolveHit.Dodge",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathDodgeTest::RunTest(const FString& Parameters)
+{
+	FCombatDefenderState Defender;
+	Defender.bDodgingDamage = true;
+
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(100.f, CombatMathTests::NoCritRate);
+	FRandomStream RandomStream(0);
+	FCombatHitOutcome Outcome;
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Attack against a dodging defender is dodged"), Outcome.DamageResult == EDamageResult::Dodged);
+	TestEqual(TEXT("Dodged attack deals no damage"), Outcome.ActualDamage, 0);
+
+	AttackInfo.bUndodgable = true;
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Undodgable attack damages a dodging defender"), Outcome.DamageResult == EDamageResult::Damaged);
+	TestEqual(TEXT("Undodgable attack deals its normal damage"), Outcome.ActualDamage, 100);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathBlockTest, "EOD.CombatMath.ResolveHit.Block",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathBlockTest::RunTest(const FString& Parameters)
+{
+	FCombatDefenderState Defender;
+	Defender.Forward = FVector::ForwardVector;
+	Defender.bBlockingDamage = true;
+	Defender.PhysicalDamageReductionOnBlock = 75.f;
+
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(100.f, CombatMathTests::NoCritRate);
+	FRandomStream RandomStream(0);
+	FCombatHitOutcome Outcome;
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Frontal attack against a blocking defender is blocked"), Outcome.bAttackBlocked);
+	TestTrue(TEXT("Blocked attack reports a blocked damage result"), Outcome.DamageResult == EDamageResult::Blocked);
+	TestEqual(TEXT("Blocked attack damage is reduced"), Outcome.ActualDamage, 25);
+
+	FCombatMath::ResolveHit(AttackInfo, Defender, -FVector::ForwardVector, true, RandomStream, Outcome);
+	TestFalse(TEXT("Attack from behind is not blocked"), Outcome.bAttackBlocked);
+	TestEqual(TEXT("Attack from behind deals its normal damage"), Outcome.ActualDamage, 100);
+
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, false, RandomStream, Outcome);
+	TestFalse(TEXT("Attack without line of sight is not blocked"), Outcome.bAttackBlocked);
+
+	AttackInfo.bUnblockable = true;
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestFalse(TEXT("Unblockable attack is not blocked"), Outcome.bAttackBlocked);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathCritTest, "EOD.CombatMath.ResolveHit.Crit",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathCritTest::RunTest(const FString& Parameters)
+{
+	FCombatDefenderState Defender;
+	FRandomStream RandomStream(0);
+	FCombatHitOutcome Outcome;
+
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(100.f, 100.f);
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Attack with 100% crit rate lands a critical hit"), Outcome.bCritHit);
+	TestEqual(TEXT("Critical hit deals crit damage"), Outcome.ActualDamage, 160);
+
+	AttackInfo = CombatMathTests::MakeAttack(100.f, CombatMathTests::NoCritRate);
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestFalse(TEXT("Attack with a negative crit rate never lands a critical hit"), Outcome.bCritHit);
+	TestEqual(TEXT("Normal hit deals normal damage"), Outcome.ActualDamage, 100);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathNullifiedTest, "EOD.CombatMath.ResolveHit.Nullified",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathNullifiedTest::RunTest(const FString& Parameters)
+{
+	FCombatDefenderState Defender;
+	FRandomStream RandomStream(0);
+	FCombatHitOutcome Outcome;
+
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(0.f, CombatMathTests::NoCritRate);
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Attack that deals no damage is nullified"), Outcome.DamageResult == EDamageResult::Nullified);
+
+	// A fully blocked attack deals no damage but must still be reported as blocked
+	Defender.bBlockingDamage = true;
+	Defender.PhysicalDamageReductionOnBlock = 100.f;
+	AttackInfo = CombatMathTests::MakeAttack(100.f, CombatMathTests::NoCritRate);
+	FCombatMath::ResolveHit(AttackInfo, Defender, FVector::ForwardVector, true, RandomStream, Outcome);
+	TestTrue(TEXT("Fully blocked attack is blocked, not nullified"), Outcome.DamageResult == EDamageResult::Blocked);
+	TestEqual(TEXT("Fully blocked attack deals no damage"), Outcome.ActualDamage, 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathDeterminismTest, "EOD.CombatMath.ResolveHit.SameSeedSameOutcome",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathDeterminismTest::RunTest(const FString& Parameters)
+{
+	FCombatDefenderState Defender;
+	Defender.bBlockingDamage = true;
+	Defender.PhysicalDamageReductionOnBlock = 40.f;
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(250.f, 50.f);
+
+	FRandomStream StreamA(1234);
+	FRandomStream StreamB(1234);
+	FRandomStream NormalStream(5678);
+	for (int32 Index = 0; Index < 256; ++Index)
+	{
+		FVector ImpactNormal = NormalStream.GetUnitVector();
+		FCombatHitOutcome OutcomeA;
+		FCombatHitOutcome OutcomeB;
+		FCombatMath::ResolveHit(AttackInfo, Defender, ImpactNormal, true, StreamA, OutcomeA);
+		FCombatMath::ResolveHit(AttackInfo, Defender, ImpactNormal, true, StreamB, OutcomeB);
+
+		if (OutcomeA.DamageResult != OutcomeB.DamageResult || OutcomeA.ActualDamage != OutcomeB.ActualDamage ||
+			OutcomeA.bCritHit != OutcomeB.bCritHit || OutcomeA.bAttackBlocked != OutcomeB.bAttackBlocked)
+		{
+			AddError(FString::Printf(TEXT("Hit %d resolved differently for the same seed"), Index));
+			return false;
+		}
+	}
+
+	FCombatBenchmarkResult ResultA;
+	FCombatBenchmarkResult ResultB;
+	FCombatMath::RunBenchmark(10000, 42, ResultA);
+	FCombatMath::RunBenchmark(10000, 42, ResultB);
+	TestEqual(TEXT("Same seed deals the same total damage"), ResultA.TotalDamage, ResultB.TotalDamage);
+	TestEqual(TEXT("Same seed lands the same number of crits"), ResultA.NumCritHits, ResultB.NumCritHits);
+	TestEqual(TEXT("Same seed blocks the same number of hits"), ResultA.NumBlockedHits, ResultB.NumBlockedHits);
+	TestEqual(TEXT("Same seed dodges the same number of hits"), ResultA.NumDodgedHits, ResultB.NumDodgedHits);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCombatMathActualDamageTest, "EOD.CombatMath.GetActualDamage.Clamp",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCombatMathActualDamageTest::RunTest(const FString& Parameters)
+{
+	FAttackInfo AttackInfo = CombatMathTests::MakeAttack(100.f, CombatMathTests::NoCritRate);
+	TestEqual(TEXT("Unblocked damage ignores block reduction"), FCombatMath::GetActualDamage(AttackInfo, false, false, 50.f), 100.f);
+	TestEqual(TEXT("Block reduction is applied"), FCombatMath::GetActualDamage(AttackInfo, false, true, 50.f), 50.f);
+	TestEqual(TEXT("Block reduction above 100% clamps damage at 0"), FCombatMath::GetActualDamage(AttackInfo, false, true, 150.f), 0.f);
+	TestEqual(TEXT("Negative block reduction clamps damage at the unblocked maximum"), FCombatMath::GetActualDamage(AttackInfo, false, true, -50.f), 100.f);
+	TestEqual(TEXT("Crit damage is used for critical hits"), FCombatMath::GetActualDamage(AttackInfo, true, false, 0.f), 160.f);
+
+	AttackInfo = CombatMathTests::MakeAttack(-100.f, CombatMathTests::NoCritRate);
+	TestEqual(TEXT("Negative damage clamps at 0"), FCombatMath::GetActualDamage(AttackInfo, false, false, 0.f), 0.f);
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
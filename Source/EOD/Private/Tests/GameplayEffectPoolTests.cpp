@@ -0,0 +1,51 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "GameplayEffectPoolSubsystem.h"
+#include "MovementBuff.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGameplayEffectPoolReuseTest, "EOD.GameplayEffects.Pool.ReusedEffectMatchesFreshEffect",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGameplayEffectPoolReuseTest::RunTest(const FString& Parameters)
+{
+	UGameplayEffectPoolSubsystem* EffectPool = NewObject<UGameplayEffectPoolSubsystem>(GetTransientPackage());
+	const UMovementBuff* Defaults = GetDefault<UMovementBuff>();
+
+	UMovementBuff* Effect = Cast<UMovementBuff>(EffectPool->AcquireGameplayEffect(UMovementBuff::StaticClass()));
+	if (!TestNotNull(TEXT("Pool creates an effect of the requested class"), Effect))
+	{
+		return false;
+	}
+	const float FreshDuration = Effect->GetDuration();
+
+	// Dirty both base class and subclass state the way a running effect would
+	Effect->MaxUpgradeLevel = Defaults->MaxUpgradeLevel + 5;
+	Effect->ExtraEffectDurationPerLevel = Defaults->ExtraEffectDurationPerLevel + 10;
+	Effect->bNeedsUpdate = !Defaults->bNeedsUpdate;
+	Effect->InGameName = TEXT("Dirty");
+	Effect->InitEffect(nullptr, TArray<AEODCharacterBase*>(), 3);
+	TestNotEqual(TEXT("Initialized effect has a level dependent duration"), Effect->GetDuration(), FreshDuration);
+
+	EffectPool->ReleaseGameplayEffect(Effect);
+	UMovementBuff* ReusedEffect = Cast<UMovementBuff>(EffectPool->AcquireGameplayEffect(UMovementBuff::StaticClass()));
+	TestTrue(TEXT("Pool hands out the released effect again"), ReusedEffect == Effect);
+	if (!ReusedEffect)
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Reused effect has the default max upgrade level"), ReusedEffect->MaxUpgradeLevel, Defaults->MaxUpgradeLevel);
+	TestEqual(TEXT("Reused effect has the default duration per level"), ReusedEffect->ExtraEffectDurationPerLevel, Defaults->ExtraEffectDurationPerLevel);
+	TestEqual(TEXT("Reused effect has the default update flag"), ReusedEffect->bNeedsUpdate, Defaults->bNeedsUpdate);
+	TestEqual(TEXT("Reused effect has the default name"), ReusedEffect->InGameName, Defaults->InGameName);
+	TestEqual(TEXT("Reused effect has the same duration as a fresh effect"), ReusedEffect->GetDuration(), FreshDuration);
+	TestFalse(TEXT("Reused effect is inactive"), ReusedEffect->IsActive());
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,113 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "StatsComponentBase.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace StatModifierTests
+{
+	/** Round trips a stat struct through the same tagged property serialization used for saving and loading */
+	template<typename StatType>
+	static void SaveAndLoad(const StatType& SavedStat, StatType& OutLoadedStat)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter MemoryWriter(Bytes, true);
+		FObjectAndNameAsStringProxyArchive WriterAr(MemoryWriter, true);
+		StatType::StaticStruct()->SerializeItem(WriterAr, const_cast<StatType*>(&SavedStat), nullptr);
+
+		FMemoryReader MemoryReader(Bytes, true);
+		FObjectAndNameAsStringProxyArchive ReaderAr(MemoryReader, true);
+		StatType::StaticStruct()->SerializeItem(ReaderAr, &OutLoadedStat, nullptr);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPrimaryStatSaveLoadTest, "EOD.Stats.PrimaryStat.SaveLoadRebuildsModifiers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FPrimaryStatSaveLoadTest::RunTest(const FString& Parameters)
+{
+	UObject* FlatSource = GetTransientPackage();
+	UObject* PercentSource = UPackage::StaticClass()->GetDefaultObject();
+
+	FPrimaryStat SavedStat(100, 100);
+	SavedStat.AddModifier(FlatSource, FStatModifier(50.f, EStatModType::Flat));
+	SavedStat.AddModifier(PercentSource, FStatModifier(10.f, EStatModType::Percent));
+	TestEqual(TEXT("Modified max value before saving"), SavedStat.GetMaxValue(), 165);
+
+	FPrimaryStat LoadedStat;
+	StatModifierTests::SaveAndLoad(SavedStat, LoadedStat);
+	TestEqual(TEXT("Loaded max value matches the saved max value"), LoadedStat.GetMaxValue(), 165);
+
+	LoadedStat.RemoveModifier(PercentSource);
+	TestEqual(TEXT("Removing a loaded percent modifier keeps the loaded flat modifier"), LoadedStat.GetMaxValue(), 150);
+
+	LoadedStat.RemoveModifier(FlatSource);
+	TestEqual(TEXT("Removing every loaded modifier restores the loaded base value"), LoadedStat.GetMaxValue(), 100);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenericStatSaveLoadTest, "EOD.Stats.GenericStat.SaveLoadRebuildsModifiers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FGenericStatSaveLoadTest::RunTest(const FString& Parameters)
+{
+	UObject* FlatSource = GetTransientPackage();
+	UObject* PercentSource = UPackage::StaticClass()->GetDefaultObject();
+
+	FGenericStat SavedStat(20.f);
+	SavedStat.AddModifier(FlatSource, FStatModifier(20.f, EStatModType::Flat));
+	SavedStat.AddModifier(PercentSource, FStatModifier(50.f, EStatModType::Percent));
+	TestEqual(TEXT("Modified value before saving"), SavedStat.GetValue(), 60.f);
+
+	FGenericStat LoadedStat;
+	StatModifierTests::SaveAndLoad(SavedStat, LoadedStat);
+	TestEqual(TEXT("Loaded value matches the saved value"), LoadedStat.GetValue(), 60.f);
+
+	LoadedStat.RemoveModifier(FlatSource);
+	TestEqual(TEXT("Removing a loaded flat modifier keeps the loaded percent modifier"), LoadedStat.GetValue(), 30.f);
+
+	LoadedStat.RemoveModifier(PercentSource);
+	TestEqual(TEXT("Removing every loaded modifier restores the loaded base value"), LoadedStat.GetValue(), 20.f);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FCCImmunitiesSaveLoadTest, "EOD.Stats.CCImmunities.SaveLoadRebuildsModifiers",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FCCImmunitiesSaveLoadTest::RunTest(const FString& Parameters)
+{
+	UObject* FlinchSource = GetTransientPackage();
+	UObject* StunSource = UPackage::StaticClass()->GetDefaultObject();
+
+	FCCImmunityModifier FlinchImmunity;
+	FlinchImmunity.Value = 1 << (uint8)ECrowdControlEffect::Flinch;
+	FlinchImmunity.ModType = ECCImmunityModType::Additive;
+
+	FCCImmunityModifier StunImmunity;
+	StunImmunity.Value = 1 << (uint8)ECrowdControlEffect::Stunned;
+	StunImmunity.ModType = ECCImmunityModType::Additive;
+
+	FCCImmunities SavedImmunities(0);
+	SavedImmunities.AddModifier(FlinchSource, FlinchImmunity);
+	SavedImmunities.AddModifier(StunSource, StunImmunity);
+
+	FCCImmunities LoadedImmunities;
+	StatModifierTests::SaveAndLoad(SavedImmunities, LoadedImmunities);
+	TestTrue(TEXT("Loaded immunities keep the flinch immunity"), LoadedImmunities.HasCCImmunity(ECrowdControlEffect::Flinch));
+	TestTrue(TEXT("Loaded immunities keep the stun immunity"), LoadedImmunities.HasCCImmunity(ECrowdControlEffect::Stunned));
+
+	LoadedImmunities.RemoveModifier(FlinchSource);
+	TestFalse(TEXT("Removing a loaded modifier removes its immunity"), LoadedImmunities.HasCCImmunity(ECrowdControlEffect::Flinch));
+	TestTrue(TEXT("Removing a loaded modifier keeps the other loaded immunity"), LoadedImmunities.HasCCImmunity(ECrowdControlEffect::Stunned));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
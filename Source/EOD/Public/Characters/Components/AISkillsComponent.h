@@ -104,56 +104,51 @@ protected:
 	UPROPERTY(Transient, Category = Skills, BlueprintReadOnly)
 	TArray<FName> DebuffSkills;
 
+	// --------------------------------------
+	//  Skill Category Bitsets
+	// --------------------------------------
+
+	/**
+	 * Maximum number of skills that can be picked by weighted skill selection.
+	 * A skill with skill index N is represented by bit (N - 1) in the skill masks below.
+	 */
+	static const int32 MaxSelectableSkills = 64;
+
+	/** Skill groups mapped by their bit in the skill masks */
+	TArray<FName> SkillGroupsByBit;
+
+	uint64 MeleeSkillsMask;
+	uint64 RangedSkillsMask;
+	uint64 SelfHealingSkillsMask;
+	uint64 PartyHealingSkillsMask;
+	uint64 SelfBuffSkillsMask;
+	uint64 PartyBuffSkillsMask;
+	uint64 DebuffSkillsMask;
+
+	uint64 UnblockableSkillsMask;
+	uint64 UndodgableSkillsMask;
+	uint64 InterruptSkillsMask;
+
+	/** Skills that apply any crowd control effect other than flinch */
+	uint64 CrowdControlSkillsMask;
+
+	/** Skills that can currently be selected, i.e., every skill except the last used one */
+	uint64 AvailableSkillsMask;
+
 private:
 
-	FName GetRandomUnblockableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomUndodgableSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomInterruptSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomCCESkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetRandomNormalSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	FName GetAnyRandomSkill(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
+	/** Returns the bit that represents the skill with given skill index, or 0 if the skill is not selectable */
+	static inline uint64 GetSkillBit(uint8 SkillIndex);
 
-	inline TArray<FName> GetAvailableSkills(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const;
-	inline FName GetRandomName(const TArray<FName>& NameArray) const;
+	/** Picks the attack skill from SourceSkillsMask that is most appropriate against the current state of the target */
+	FName GetWeightedAttackSkillID(uint64 SourceSkillsMask, const AEODCharacterBase* TargetCharacter) const;
 
-};
+	/** Returns a random skill out of the skills in SkillsMask, with each skill being equally weighted */
+	FName GetRandomSkillFromMask(uint64 SkillsMask) const;
 
-inline TArray<FName> UAISkillsComponent::GetAvailableSkills(const TArray<FName>& SkillSource, const TArray<FName>& SkillsToIgnore) const
-{
-	if (SkillSource == SkillsToIgnore)
-	{
-		return TArray<FName>();
-	}
-
-	if (SkillsToIgnore.Num() == 0)
-	{
-		return SkillSource;
-	}
-	else
-	{
-		TArray<FName> AvailableSkills;
-		for (const FName& Key : SkillSource)
-		{
-			if (!SkillsToIgnore.Contains(Key))
-			{
-				AvailableSkills.Add(Key);
-			}
-		}
-		return AvailableSkills;
-	}
-}
+};
 
-inline FName UAISkillsComponent::GetRandomName(const TArray<FName>& NameArray) const
+inline uint64 UAISkillsComponent::GetSkillBit(uint8 SkillIndex)
 {
-	int32 ArraySize = NameArray.Num();
-	if (ArraySize > 0)
-	{
-		int32 RandomIndex = FMath::RandRange(0, ArraySize - 1);
-		FName RandomName = NameArray[RandomIndex];
-		return RandomName;
-	}
-	else
-	{
-		return NAME_None;
-	}
+	return (SkillIndex > 0 && SkillIndex <= MaxSelectableSkills) ? (1ULL << (SkillIndex - 1)) : 0;
 }
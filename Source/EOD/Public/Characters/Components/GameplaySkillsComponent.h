@@ -128,8 +128,15 @@ protected:
 	UPROPERTY(Transient)
 	TMap<FName, uint8> SkillGroupToSkillIndexMap;
 
+	/** Gameplay effects currently applied through this component. A set so that membership checks are a single lookup */
 	UPROPERTY(Transient)
-	TArray<UGameplayEffectBase*> ActiveGameplayEffects;
+	TSet<UGameplayEffectBase*> ActiveGameplayEffects;
+
+	/**
+	 * Number of active gameplay effects of each class. An active effect is counted under its own class
+	 * and every parent class up to UGameplayEffectBase, so that IsA queries are a single map lookup.
+	 */
+	TMap<UClass*, int32> ActiveGameplayEffectCounts;
 
 	UPROPERTY(Transient)
 	bool bCanUseChainSkill;
@@ -210,6 +217,9 @@ public:
 
 private:
 
+	/** Adds Delta to the active count of the gameplay effect's class and all of its parent classes */
+	void UpdateActiveGameplayEffectCounts(UGameplayEffectBase* GameplayEffect, int32 Delta);
+
 	/** Cached pointer to EOD character owner */
 	UPROPERTY(Transient)
 	AEODCharacterBase* EODCharacterOwner;
@@ -8,6 +8,8 @@
 #include "Components/ActorComponent.h"
 #include "StatsComponentBase.generated.h"
 
+class URegenerationSubsystem;
+
 
 /**
  * Delegate for when the primary stat value changes
@@ -22,6 +24,15 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FOnPrimaryStatChangedMCDelegate, int32, int
  */
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnGenericStatChangedMCDelegate, float);
 
+/** Primary stats that can regenerate over time */
+enum class EStatRegenType : uint8
+{
+	Health,
+	Mana,
+	Stamina,
+	MAX
+};
+
 UENUM(BlueprintType)
 enum class EStatModType : uint8
 {
@@ -78,6 +89,70 @@ struct EOD_API FStatModifier
 	}
 };
 
+/**
+ * Keeps running sums of flat and percent stat modifiers so that adding or removing a modifier
+ * doesn't require iterating over every active modifier of a stat.
+ */
+struct EOD_API FStatModifierAggregator
+{
+public:
+
+	FStatModifierAggregator() :
+		FlatSum(0.0),
+		PercentSum(0.0)
+	{
+	}
+
+	FORCEINLINE void Add(const FStatModifier& Mod)
+	{
+		if (Mod.ModType == EStatModType::Flat)
+		{
+			FlatSum += Mod.Value;
+		}
+		else if (Mod.ModType == EStatModType::Percent)
+		{
+			PercentSum += Mod.Value;
+		}
+	}
+
+	FORCEINLINE void Remove(const FStatModifier& Mod)
+	{
+		if (Mod.ModType == EStatModType::Flat)
+		{
+			FlatSum -= Mod.Value;
+		}
+		else if (Mod.ModType == EStatModType::Percent)
+		{
+			PercentSum -= Mod.Value;
+		}
+	}
+
+	/** Clears the running sums. Called once the last modifier is removed so floating point error can't build up */
+	FORCEINLINE void Reset()
+	{
+		FlatSum = 0.0;
+		PercentSum = 0.0;
+	}
+
+	/** Returns the flat value of a stat with the base value BaseValue, i.e., base value with all flat modifiers applied */
+	FORCEINLINE int32 GetFlatValue(float BaseValue) const
+	{
+		return (int32)(BaseValue + FlatSum);
+	}
+
+	FORCEINLINE float GetPercent() const
+	{
+		return PercentSum;
+	}
+
+private:
+
+	double FlatSum;
+
+	double PercentSum;
+
+};
+
 USTRUCT(BlueprintType)
 struct EOD_API FPrimaryStat
 {
@@ -94,7 +169,8 @@ public:
 	{
 	}
 
-	FPrimaryStat(int32 InMaxValue, int32 InCurrentValue)
+	FPrimaryStat(int32 InMaxValue, int32 InCurrentValue) :
+		FPrimaryStat()
 	{
 		SetMaxValue(InMaxValue);
 		SetCurrentValue(InCurrentValue);
@@ -155,16 +231,23 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FStatModifier* ExistingMod = Modifiers.Find(UniqueID);
+			if (ExistingMod)
 			{
-				Modifiers[UniqueID] = NewMod;
+				Aggregator.Remove(*ExistingMod);
+				*ExistingMod = NewMod;
 			}
 			else
 			{
 				Modifiers.Add(UniqueID, NewMod);
 			}
-			RecalculateMaxValue();
-			OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+			Aggregator.Add(NewMod);
+
+			int32 OldMaxValue = MaxValue;
+			if (RecalculateMaxValue() != OldMaxValue)
+			{
+				OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+			}
 		}
 	}
 
@@ -174,11 +257,20 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FStatModifier RemovedMod;
+			if (Modifiers.RemoveAndCopyValue(UniqueID, RemovedMod))
 			{
-				Modifiers.Remove(UniqueID);
-				RecalculateMaxValue();
-				OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+				Aggregator.Remove(RemovedMod);
+				if (Modifiers.Num() == 0)
+				{
+					Aggregator.Reset();
+				}
+
+				int32 OldMaxValue = MaxValue;
+				if (RecalculateMaxValue() != OldMaxValue)
+				{
+					OnStatValueChanged.Broadcast(MaxValue, CurrentValue);
+				}
 			}
 		}
 	}
@@ -192,33 +284,43 @@ public:
 
 	FOnPrimaryStatChangedMCDelegate OnStatValueChanged;
 
-private:
-
-	int32 RecalculateMaxValue()
+	/** The modifier aggregate isn't serialized, so it gets rebuilt from the loaded modifiers */
+	void PostSerialize(const FArchive& Ar)
 	{
-		Modifiers.ValueSort([&](const FStatModifier& Mod1, const FStatModifier& Mod2) { return Mod1 < Mod2; });
+		if (Ar.IsLoading())
+		{
+			RebuildAggregate();
+		}
+	}
 
-		int32 MaxFlat = MaxValue_NoMod;
-		float FlatPercent = 0.f;
+private:
 
+	void RebuildAggregate()
+	{
+		Aggregator.Reset();
 		for (const TPair<uint32, FStatModifier>& ModPair : Modifiers)
 		{
-			if (ModPair.Value.ModType == EStatModType::Flat)
-			{
-				MaxFlat += ModPair.Value.Value;
-			}
-			else if (ModPair.Value.ModType == EStatModType::Percent)
-			{
-				FlatPercent += ModPair.Value.Value;
-			}
+			Aggregator.Add(ModPair.Value);
 		}
+		RecalculateMaxValue();
+	}
+
+	int32 RecalculateMaxValue()
+	{
+		int32 MaxFlat = Aggregator.GetFlatValue(MaxValue_NoMod);
+		float FlatPercent = Aggregator.GetPercent();
 
 		MaxValue = MaxFlat + (MaxFlat * (FlatPercent / 100.f));
 		return MaxValue;
 	}
 
+	/** Saved along with the modifiers so the final value can be recomputed on load. Clients only need the final value. */
+	UPROPERTY(NotReplicated)
 	int32 MaxValue_NoMod;
 
+	/** Running sums of all the modifiers in Modifiers */
+	FStatModifierAggregator Aggregator;
+
 	UPROPERTY()
 	int32 MaxValue;
 
@@ -229,6 +331,15 @@ private:
 	TMap<uint32, FStatModifier> Modifiers;
 };
 
+template<>
+struct TStructOpsTypeTraits<FPrimaryStat> : public TStructOpsTypeTraitsBase2<FPrimaryStat>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
 USTRUCT(BlueprintType)
 struct EOD_API FGenericStat
 {
@@ -244,7 +355,8 @@ public:
 	{
 	}
 
-	FGenericStat(float InValue)
+	FGenericStat(float InValue) :
+		FGenericStat()
 	{
 		SetValue(InValue);
 	}
@@ -271,16 +383,23 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FStatModifier* ExistingMod = Modifiers.Find(UniqueID);
+			if (ExistingMod)
 			{
-				Modifiers[UniqueID] = NewMod;
+				Aggregator.Remove(*ExistingMod);
+				*ExistingMod = NewMod;
 			}
 			else
 			{
 				Modifiers.Add(UniqueID, NewMod);
 			}
-			RecalculateValue();
-			OnStatValueChanged.Broadcast(Value);
+			Aggregator.Add(NewMod);
+
+			float OldValue = Value;
+			if (RecalculateValue() != OldValue)
+			{
+				OnStatValueChanged.Broadcast(Value);
+			}
 		}
 	}
 
@@ -290,11 +409,20 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FStatModifier RemovedMod;
+			if (Modifiers.RemoveAndCopyValue(UniqueID, RemovedMod))
 			{
-				Modifiers.Remove(UniqueID);
-				RecalculateValue();
-				OnStatValueChanged.Broadcast(Value);
+				Aggregator.Remove(RemovedMod);
+				if (Modifiers.Num() == 0)
+				{
+					Aggregator.Reset();
+				}
+
+				float OldValue = Value;
+				if (RecalculateValue() != OldValue)
+				{
+					OnStatValueChanged.Broadcast(Value);
+				}
 			}
 		}
 	}
@@ -307,33 +435,42 @@ public:
 
 	FOnGenericStatChangedMCDelegate OnStatValueChanged;
 
-private:
-
-	float RecalculateValue()
+	/** The modifier aggregate isn't serialized, so it gets rebuilt from the loaded modifiers */
+	void PostSerialize(const FArchive& Ar)
 	{
-		Modifiers.ValueSort([&](const FStatModifier& Mod1, const FStatModifier& Mod2) { return Mod1 < Mod2; });
+		if (Ar.IsLoading())
+		{
+			RebuildAggregate();
+		}
+	}
 
-		int32 MaxFlat = Value_NoMod;
-		float FlatPercent = 0.f;
+private:
 
+	void RebuildAggregate()
+	{
+		Aggregator.Reset();
 		for (const TPair<uint32, FStatModifier>& ModPair : Modifiers)
 		{
-			if (ModPair.Value.ModType == EStatModType::Flat)
-			{
-				MaxFlat += ModPair.Value.Value;
-			}
-			else if (ModPair.Value.ModType == EStatModType::Percent)
-			{
-				FlatPercent += ModPair.Value.Value;
-			}
+			Aggregator.Add(ModPair.Value);
 		}
+		RecalculateValue();
+	}
+
+	float RecalculateValue()
+	{
+		int32 MaxFlat = Aggregator.GetFlatValue(Value_NoMod);
+		float FlatPercent = Aggregator.GetPercent();
 
 		Value = MaxFlat + (MaxFlat * (FlatPercent / 100.f));
 		return Value;
 	}
 
+	UPROPERTY(NotReplicated)
 	float Value_NoMod;
 
+	/** Running sums of all the modifiers in Modifiers */
+	FStatModifierAggregator Aggregator;
+
 	UPROPERTY()
 	float Value;
 
@@ -342,6 +479,15 @@ private:
 
 };
 
+template<>
+struct TStructOpsTypeTraits<FGenericStat> : public TStructOpsTypeTraitsBase2<FGenericStat>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
+};
+
 UENUM(BlueprintType)
 enum class ECCImmunityModType : uint8
 {
@@ -411,11 +557,14 @@ public:
 
 	FCCImmunities() :
 		Value_NoMod(0),
-		Value(0)
+		Value(0),
+		ReductiveImmunities(0)
 	{
+		FMemory::Memzero(AdditiveBitCounts);
 	}
 
-	FCCImmunities(float InValue)
+	FCCImmunities(float InValue) :
+		FCCImmunities()
 	{
 		SetValue(InValue);
 	}
@@ -436,14 +585,17 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FCCImmunityModifier* ExistingMod = Modifiers.Find(UniqueID);
+			if (ExistingMod)
 			{
-				Modifiers[UniqueID] = NewMod;
+				RemoveFromAggregate(*ExistingMod);
+				*ExistingMod = NewMod;
 			}
 			else
 			{
 				Modifiers.Add(UniqueID, NewMod);
 			}
+			AddToAggregate(NewMod);
 			RecalculateValue();
 		}
 	}
@@ -454,9 +606,10 @@ public:
 		if (SourceObj)
 		{
 			uint32 UniqueID = SourceObj->GetUniqueID();
-			if (Modifiers.Contains(UniqueID))
+			FCCImmunityModifier RemovedMod;
+			if (Modifiers.RemoveAndCopyValue(UniqueID, RemovedMod))
 			{
-				Modifiers.Remove(UniqueID);
+				RemoveFromAggregate(RemovedMod);
 				RecalculateValue();
 			}
 		}
@@ -472,26 +625,79 @@ public:
 		return (Value & CCImmunities) == CCImmunities;
 	}
 
+	/** The modifier aggregate isn't serialized, so it gets rebuilt from the loaded modifiers */
+	void PostSerialize(const FArchive& Ar)
+	{
+		if (Ar.IsLoading())
+		{
+			RebuildAggregate();
+		}
+	}
+
 private:
 
+	void RebuildAggregate()
+	{
+		FMemory::Memzero(AdditiveBitCounts);
+		ReductiveImmunities = 0;
+		for (const TPair<uint32, FCCImmunityModifier>& ModPair : Modifiers)
+		{
+			AddToAggregate(ModPair.Value);
+		}
+		RecalculateValue();
+	}
+
+	/**
+	 * Additive modifiers are applied before reductive modifiers, and every reductive modifier toggles its immunity bits.
+	 * That is, the final value is (base | union of additive modifiers) ^ (xor of reductive modifiers).
+	 */
 	float RecalculateValue()
 	{
-		Modifiers.ValueSort([&](const FCCImmunityModifier& Mod1, const FCCImmunityModifier& Mod2) { return Mod1 < Mod2; });
+		uint8 AdditiveImmunities = 0;
+		for (int32 Bit = 0; Bit < 8; ++Bit)
+		{
+			if (AdditiveBitCounts[Bit] > 0)
+			{
+				AdditiveImmunities |= (1 << Bit);
+			}
+		}
 
 		Value = Value_NoMod;
-		for (const TPair<uint32, FCCImmunityModifier>& ModPair : Modifiers)
+		AddImmunities(AdditiveImmunities);
+		RemoveImmunities(ReductiveImmunities);
+
+		return Value;
+	}
+
+	void AddToAggregate(const FCCImmunityModifier& Mod)
+	{
+		if (Mod.ModType == ECCImmunityModType::Additive)
 		{
-			if (ModPair.Value.ModType == ECCImmunityModType::Additive)
+			for (int32 Bit = 0; Bit < 8; ++Bit)
 			{
-				AddImmunities(ModPair.Value.Value);
+				AdditiveBitCounts[Bit] += (Mod.Value >> Bit) & 1;
 			}
-			else if (ModPair.Value.ModType == ECCImmunityModType::Reductive)
+		}
+		else if (Mod.ModType == ECCImmunityModType::Reductive)
+		{
+			ReductiveImmunities ^= Mod.Value;
+		}
+	}
+
+	void RemoveFromAggregate(const FCCImmunityModifier& Mod)
+	{
+		if (Mod.ModType == ECCImmunityModType::Additive)
+		{
+			for (int32 Bit = 0; Bit < 8; ++Bit)
 			{
-				RemoveImmunities(ModPair.Value.Value);
+				AdditiveBitCounts[Bit] -= (Mod.Value >> Bit) & 1;
 			}
 		}
-
-		return Value;
+		else if (Mod.ModType == ECCImmunityModType::Reductive)
+		{
+			// xor is its own inverse
+			ReductiveImmunities ^= Mod.Value;
+		}
 	}
 
 	void AddImmunity(ECrowdControlEffect CCImmunity)
@@ -521,6 +727,7 @@ private:
 
 private:
 
+	UPROPERTY(NotReplicated)
 	uint8 Value_NoMod;
 
 	UPROPERTY()
@@ -529,6 +736,21 @@ private:
 	UPROPERTY()
 	TMap<uint32, FCCImmunityModifier> Modifiers;
 
+	/** Number of additive modifiers that grant each immunity bit */
+	uint16 AdditiveBitCounts[8];
+
+	/** Xor of all reductive modifiers */
+	uint8 ReductiveImmunities;
+
+};
+
+template<>
+struct TStructOpsTypeTraits<FCCImmunities> : public TStructOpsTypeTraitsBase2<FCCImmunities>
+{
+	enum
+	{
+		WithPostSerialize = true,
+	};
 };
 
 
@@ -554,6 +776,8 @@ public:
 
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Dummy declaration. This component doesn't tick */
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
@@ -636,10 +860,6 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "Regeneration")
 	float StaminaRegenTickInterval;
 
-	FTimerHandle HealthRegenTimerHandle;
-	FTimerHandle ManaRegenTimerHandle;
-	FTimerHandle StaminaRegenTimerHandle;
-
 	/** Starts health regeneration on player. Automatically stops once the health is full or if manually stopped */
 	void ActivateHealthRegeneration();
 
@@ -662,6 +882,12 @@ public:
 	void RegenerateMana();
 	void RegenerateStamina();
 
+	/** Called by URegenerationSubsystem on every regeneration tick of a stat */
+	void Regenerate(EStatRegenType StatType);
+
+	/** Returns the delay between regeneration updates of a stat */
+	float GetRegenTickInterval(EStatRegenType StatType) const;
+
 	// --------------------------------------
 	//  Attack
 	// --------------------------------------
@@ -742,6 +968,15 @@ public:
 	UPROPERTY(Replicated)
 	FGenericStat Darkness;
 
+private:
+
+	friend class URegenerationSubsystem;
+
+	/** Index of this component's entry in URegenerationSubsystem, or INDEX_NONE if none of its stats are regenerating */
+	int32 RegenEntryIndex;
+
+	URegenerationSubsystem* GetRegenerationSubsystem() const;
+
 protected:
 
 	// --------------------------------------
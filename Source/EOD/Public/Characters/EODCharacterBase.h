@@ -156,6 +156,8 @@ public:
 	/** Called when the game starts or when spawned */
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Updates character state every frame */
 	virtual void Tick(float DeltaTime) override;
 
@@ -463,22 +465,23 @@ public:
 
 	virtual AActor* GetInterfaceOwner() override;
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex) override;
+	virtual bool GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
 
 	/** [server] Receive an attack on server */
-	virtual TSharedPtr<FAttackResponse> ReceiveAttack(
+	virtual bool ReceiveAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const FHitResult& DirectHitResult,
 		const bool bLineHitResultFound,
-		const FHitResult& LineHitResult) override;
+		const FHitResult& LineHitResult,
+		FAttackResponse& OutAttackResponse) override;
 
 	/** Returns the actual damage received by this character */
 	virtual float GetActualDamage(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const bool bCritHit,
 		const bool bAttackBlocked) override;
 
@@ -501,12 +504,18 @@ public:
 
 	inline const FReceivedHitInfo& GetLastReceivedHitInfo() const { return LastReceivedHit; }
 
+	/** Reseeds the random stream used for resolving received attacks, e.g., to reproduce a fight deterministically */
+	inline void SeedCombatRandomStream(int32 Seed) { CombatRandomStream.Initialize(Seed); }
+
 protected:
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtrFromNormalAttack(const FString& NormalAttackStr);
+	virtual bool GetAttackInfoFromNormalAttack(const FString& NormalAttackStr, FAttackInfo& OutAttackInfo);
 	virtual EWeaponType GetWeaponTypeFromNormalAttackString(const FString& NormalAttackStr);
 	virtual int32 GetAttackIndexFromNormalAttackString(const FString& NormalAttackStr);
 
+	/** Random stream used for rolls made while resolving attacks received by this character */
+	FRandomStream CombatRandomStream;
+
 	UPROPERTY(ReplicatedUsing = OnRep_LastReceivedHit)
 	FReceivedHitInfo LastReceivedHit;
 	
@@ -1095,8 +1104,8 @@ public:
 	//  Gameplay Events
 	// --------------------------------------
 
-	virtual void DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr);
-	virtual void BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const TSharedPtr<FAttackInfo>& AttackInfoPtr);
+	virtual void DodgeAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo);
+	virtual void BlockAttack(AActor* HitInstigator, ICombatInterface* InstigatorCI, const FAttackInfo& AttackInfo);
 
 	FOnGameplayEventMCDelegate OnReceivingHit;
 	FOnGameplayEventMCDelegate OnSuccessfulHit;
@@ -69,10 +69,10 @@ public:
 	//  Combat Interface
 	// --------------------------------------
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex) override;
+	virtual bool GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo) override;
 
 	/** [server] Called to process the post attack event */
-	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors);
+	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors) override;
 
 	// --------------------------------------
 	//	Components
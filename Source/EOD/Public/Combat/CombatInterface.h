@@ -34,24 +34,30 @@ public:
 
 	virtual AActor* GetInterfaceOwner();
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(const FName& SkillGroup, const int32 CollisionIndex);
+	/** Fills OutAttackInfo for the given skill collision and returns true if the attack info is valid */
+	virtual bool GetAttackInfo(const FName& SkillGroup, const int32 CollisionIndex, FAttackInfo& OutAttackInfo);
 
 	virtual bool IsEnemyOf(ICombatInterface* TargetCI) const;
 
-	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*> HitActors);
+	virtual void PostAttack(const TArray<FAttackResponse>& AttackResponses, const TArray<AActor*>& HitActors);
 
-	virtual TSharedPtr<FAttackResponse> ReceiveAttack(
+	/**
+	 * Receives an attack and fills OutAttackResponse with the result
+	 * @return True if the attack was processed by this actor
+	 */
+	virtual bool ReceiveAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const FHitResult& DirectHitResult,
 		const bool bLineHitResultFound,
-		const FHitResult& LineHitResult);
+		const FHitResult& LineHitResult,
+		FAttackResponse& OutAttackResponse);
 
 	virtual float GetActualDamage(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		const bool bCritHit,
 		const bool bAttackBlocked);
 
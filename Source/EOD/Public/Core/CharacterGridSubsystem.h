@@ -0,0 +1,106 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CharacterGridSubsystem.generated.h"
+
+class AEODCharacterBase;
+
+/** A character registered with UCharacterGridSubsystem */
+struct FCharacterGridEntry
+{
+	TWeakObjectPtr<AEODCharacterBase> Character;
+
+	/** Identifies the character even after it has been garbage collected, so its entry can still be found and removed */
+	FObjectKey CharacterKey;
+
+	/** The grid cell that the character is currently filed under */
+	FIntPoint Cell;
+
+	FCharacterGridEntry() :
+		Cell(FIntPoint::ZeroValue)
+	{
+	}
+};
+
+/**
+ * A world subsystem that files all player and AI characters into a uniform 2D grid so that nearby characters
+ * can be found without querying the physics scene.
+ * Character cells are refreshed in round robin slices of MaxCellUpdatesPerTick characters per frame.
+ */
+UCLASS()
+class EOD_API UCharacterGridSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// --------------------------------------
+	//  UE4 Method Overrides
+	// --------------------------------------
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/** Ticks with the owning world so that pausing and time dilation apply */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	// --------------------------------------
+	//  Character Grid
+	// --------------------------------------
+
+	/** Side length of a single grid cell in world units */
+	static const float CellSize;
+
+	/** Maximum number of characters whose grid cell gets refreshed in a single tick */
+	static const int32 MaxCellUpdatesPerTick;
+
+	void RegisterCharacter(AEODCharacterBase* Character);
+
+	void UnregisterCharacter(AEODCharacterBase* Character);
+
+	/**
+	 * Appends all registered characters (excluding IgnoredCharacter) within Radius of Origin to OutCharacters.
+	 * Only the cells overlapping the query are visited, and the distance test uses the current character location.
+	 */
+	void GetCharactersInRadius(const FVector& Origin, float Radius, TArray<AEODCharacterBase*>& OutCharacters, const AEODCharacterBase* IgnoredCharacter = nullptr) const;
+
+private:
+
+	static FIntPoint GetCellForLocation(const FVector& Location);
+
+	void AddToCell(const TWeakObjectPtr<AEODCharacterBase>& Character, const FIntPoint& Cell);
+
+	void RemoveFromCell(const TWeakObjectPtr<AEODCharacterBase>& Character, const FIntPoint& Cell);
+
+	/** Refreshes the cell of the entry at EntryIndex. Returns false if the entry's character is no longer valid */
+	bool UpdateEntry(int32 EntryIndex);
+
+	/** Removes the entry at EntryIndex and fixes up the index of the entry that got swapped into its place */
+	void RemoveEntryAt(int32 EntryIndex);
+
+	TArray<FCharacterGridEntry> Entries;
+
+	/** Index into Entries for each registered character */
+	TMap<FObjectKey, int32> EntryIndices;
+
+	/**
+	 * Characters filed under each non-empty grid cell. Characters that are destroyed without being unregistered,
+	 * e.g. on a failed spawn or a streaming level teardown, stay here until the tick prunes them, so queries skip them
+	 */
+	TMap<FIntPoint, TArray<TWeakObjectPtr<AEODCharacterBase>, TInlineAllocator<4>>> Cells;
+
+	/** Index of the entry to refresh first on the next tick */
+	int32 NextUpdateIndex = 0;
+
+};
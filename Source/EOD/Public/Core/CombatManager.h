@@ -6,14 +6,43 @@
 #include "EODCharacterBase.h"
 #include "CharacterLibrary.h"
 #include "CombatLibrary.h"
+#include "CombatMath.h"
 
 #include "Camera/CameraShake.h"
+#include "WorldCollision.h"
 #include "GameFramework/Info.h"
 #include "CombatManager.generated.h"
 
 class AActor;
 class UMatineeCameraShake;
 class APlayerCharacter;
+
+/** A melee hit that is waiting for the result of its async line of sight trace */
+struct FPendingMeleeHit
+{
+	TWeakObjectPtr<AActor> HitTarget;
+
+	TWeakObjectPtr<UPrimitiveComponent> HitComponent;
+
+	FHitResult DirectHitResult;
+
+	FTraceHandle TraceHandle;
+};
+
+/** A melee attack whose hits are waiting for async line of sight traces before they can be resolved */
+struct FPendingMeleeAttack
+{
+	TWeakObjectPtr<AActor> HitInstigator;
+
+	FAttackInfo AttackInfo;
+
+	/** Hits whose line of sight traces haven't completed yet */
+	TArray<FPendingMeleeHit> PendingHits;
+
+	TArray<FAttackResponse> AttackResponses;
+
+	TArray<TWeakObjectPtr<AActor>> HitActors;
+};
 /**
  * 
  */
@@ -45,13 +74,29 @@ public:
 		const TArray<FHitResult>& HitResults,
 		const FCollisionSkillInfo& CollisionSkillInfo);
 
-	TSharedPtr<FAttackResponse> ProcessAttack(
+	/**
+	 * Processes an attack from HitInstigator on HitTarget
+	 * @return True if the attack was received by HitTarget, in which case OutAttackResponse contains the response
+	 */
+	bool ProcessAttack(
 		AActor* HitInstigator,
 		ICombatInterface* InstigatorCI,
-		const TSharedPtr<FAttackInfo>& AttackInfoPtr,
+		const FAttackInfo& AttackInfo,
 		AActor* HitTarget,
 		ICombatInterface* TargetCI,
-		const FHitResult& HitResult);
+		const FHitResult& HitResult,
+		FAttackResponse& OutAttackResponse);
+
+	/**
+	 * Queues async line of sight traces for all the hits of a melee attack.
+	 * The hits are resolved in OnLineOfSightTraceDone once their trace results arrive.
+	 */
+	void QueueMeleeAttack(
+		AActor* HitInstigator,
+		ICombatInterface* InstigatorCI,
+		const FAttackInfo& AttackInfo,
+		const TArray<FHitResult>& HitResults,
+		TSet<AActor*>& ProcessedActors);
 
 	//~ @todo OnRangedHit
 
@@ -85,15 +130,59 @@ public:
 	 */
 	void GetLineHitResult(const AActor* HitInstigator, const UPrimitiveComponent* HitComponent, FHitResult& OutHitResult, bool& bOutLineHitResultFound) const;
 
+	/** Returns the start and end location of the line of sight trace from HitInstigator to HitComponent */
+	static void GetLineTraceEndpoints(const AActor* HitInstigator, const UPrimitiveComponent* HitComponent, FVector& OutLineStart, FVector& OutLineEnd);
+
+	/** Finds the hit result for HitComponent in a line of sight trace result */
+	static void FindLineHitResult(const TArray<FHitResult>& LineHitResults, const UPrimitiveComponent* HitComponent, FHitResult& OutHitResult, bool& bOutLineHitResultFound);
+
+private:
+
+	// --------------------------------------
+	//  Async Line of Sight
+	// --------------------------------------
+
+	/** Called on game thread when an async line of sight trace queued by QueueMeleeAttack completes */
+	void OnLineOfSightTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** Notifies the instigator of a pending attack that all of its hits have been resolved */
+	void FinishPendingMeleeAttack(uint32 AttackID);
+
+	/** Attacks waiting for async line of sight traces, mapped by attack ID. Attack ID is passed to traces as user data */
+	TMap<uint32, FPendingMeleeAttack> PendingMeleeAttacks;
+
+	uint32 LastPendingAttackID;
+
+	FTraceDelegate LineOfSightTraceDelegate;
+
+private:
+
+	// --------------------------------------
+	//  Attack Buffers
+	// --------------------------------------
+
+	/**
+	 * Buffers reused by every melee attack processed by this combat manager. They are reset (but never shrunk)
+	 * at the start of each attack so that attack processing doesn't touch the allocator once they have grown.
+	 */
+	TArray<FAttackResponse> AttackResponseBuffer;
+
+	TArray<AActor*> HitActorBuffer;
+
+	/** Scratch buffer for line traces done from const methods */
+	mutable TArray<FHitResult> LineHitResultBuffer;
+
+	/** Actors that have already been processed during the current attack */
+	TSet<AActor*> ProcessedActorSet;
+
+	/** True while an attack is being processed. Attacks triggered from within another attack use local buffers instead of the ones above */
+	bool bProcessingAttack;
+
 };
 
 inline float ACombatManager::CalculateAngleBetweenVectors(FVector Vec1, FVector Vec2)
 {
-	FVector NormalizedVec1 = Vec1.GetSafeNormal();
-	FVector NormalizedVec2 = Vec2.GetSafeNormal();
-	float Angle = FMath::RadiansToDegrees(FMath::Acos(FVector::DotProduct(NormalizedVec1, NormalizedVec2)));
-
-	return Angle;
+	return FCombatMath::CalculateAngleBetweenVectors(Vec1, Vec2);
 }
 
 inline float ACombatManager::GetBCAngle(AEODCharacterBase* HitCharacter, const FHitResult& LineHitResult)
@@ -0,0 +1,76 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StatsComponentBase.h"
+
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RegenerationSubsystem.generated.h"
+
+/** Regeneration state of a single stats component inside URegenerationSubsystem */
+struct FStatRegenEntry
+{
+	TWeakObjectPtr<UStatsComponentBase> Component;
+
+	/** Time left until the next regeneration tick of each stat, indexed by EStatRegenType */
+	float TimeUntilNextTick[(uint8)EStatRegenType::MAX];
+
+	/** Bitmask of the stats (1 << EStatRegenType) that are currently regenerating */
+	uint8 ActiveStatsMask;
+
+	FStatRegenEntry() :
+		ActiveStatsMask(0)
+	{
+		FMemory::Memzero(TimeUntilNextTick);
+	}
+};
+
+/**
+ * A world subsystem that drives health, mana and stamina regeneration of all stats components in the world.
+ * Components only stay registered while at least one of their stats is regenerating, so characters at full stats cost nothing.
+ */
+UCLASS()
+class EOD_API URegenerationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	// --------------------------------------
+	//  UE4 Method Overrides
+	// --------------------------------------
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/** Ticks with the owning world so that pausing and time dilation apply */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	virtual TStatId GetStatId() const override;
+
+	// --------------------------------------
+	//  Regeneration
+	// --------------------------------------
+
+	/** Starts regenerating the given stat of StatsComponent. The first regeneration tick happens after the stat's tick interval */
+	void StartRegeneration(UStatsComponentBase* StatsComponent, EStatRegenType StatType);
+
+	/** Stops regenerating the given stat of StatsComponent */
+	void StopRegeneration(UStatsComponentBase* StatsComponent, EStatRegenType StatType);
+
+	/** Stops regenerating all stats of StatsComponent */
+	void StopAllRegeneration(UStatsComponentBase* StatsComponent);
+
+private:
+
+	/** Removes the entry at EntryIndex and fixes up the index of the entry that got swapped into its place */
+	void RemoveEntryAt(int32 EntryIndex);
+
+	TArray<FStatRegenEntry> RegenEntries;
+
+};
@@ -28,6 +28,12 @@ public:
 
 	virtual void InitEffect(AEODCharacterBase* Instigator, TArray<AEODCharacterBase*> Targets, int32 ActivationLevel = 1);
 
+	/**
+	 * Restores this effect to the state of a freshly created instance so it can be initialized again. Called when the effect is returned to the effect pool.
+	 * All properties are copied back from the class default object. Subclasses must override this to reset any state that isn't a UPROPERTY.
+	 */
+	virtual void ResetEffect();
+
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Gameplay Effects")
 	void ActivateEffect();
 	virtual void ActivateEffect_Implementation();
@@ -0,0 +1,52 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayEffectPoolSubsystem.generated.h"
+
+class UGameplayEffectBase;
+
+/** Free gameplay effect instances of a single gameplay effect class */
+USTRUCT()
+struct EOD_API FGameplayEffectPool
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(Transient)
+	TArray<UGameplayEffectBase*> FreeEffects;
+};
+
+/**
+ * A world subsystem that recycles gameplay effect instances so that applying an effect doesn't create a new UObject every time.
+ */
+UCLASS()
+class EOD_API UGameplayEffectPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/** Returns a free gameplay effect of the given class, creating a new one if the pool for that class is empty */
+	UGameplayEffectBase* AcquireGameplayEffect(UClass* GameplayEffectClass);
+
+	/**
+	 * Resets the gameplay effect and puts it back into the pool.
+	 * Effects that weren't acquired from this pool are ignored.
+	 */
+	void ReleaseGameplayEffect(UGameplayEffectBase* GameplayEffect);
+
+	/** Maximum number of free instances kept for each gameplay effect class. Extra released instances are left to GC */
+	static const int32 MaxFreeEffectsPerClass;
+
+private:
+
+	/** Free gameplay effects mapped by their class */
+	UPROPERTY(Transient)
+	TMap<UClass*, FGameplayEffectPool> EffectPools;
+
+};
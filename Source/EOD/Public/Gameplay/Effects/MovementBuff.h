@@ -24,6 +24,8 @@ public:
 
 	virtual void InitEffect(AEODCharacterBase* Instigator, TArray<AEODCharacterBase*> Targets, int32 ActivationLevel = 1) override;
 
+	virtual void ResetEffect() override;
+
 	virtual void ActivateEffect_Implementation() override;
 	virtual void DeactivateEffect_Implementation() override;
 	virtual void UpdateEffect_Implementation(float DeltaTime) override;
@@ -85,7 +85,7 @@ public:
 
 	virtual void FinishSkill() override;
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1) override;
+	virtual bool GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex = 1) override;
 
 	// --------------------------------------
 	//  Pseudo Constants
@@ -129,7 +129,7 @@ public:
 
 	virtual void LoseCCImmunities();
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1) override;
+	virtual bool GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex = 1) override;
 
 	inline FActiveSkillLevelUpInfo GetCurrentSkillLevelupInfo() const;
 
@@ -55,7 +55,11 @@ public:
 
 	virtual void DisableGameplayEffectEvents() { ; }
 
-	virtual TSharedPtr<FAttackInfo> GetAttackInfoPtr(int32 CollisionIndex = 1);
+	/**
+	 * Fills OutAttackInfo with the attack info of the given collision index of this skill
+	 * @return True if this skill has a valid attack info for the given collision index
+	 */
+	virtual bool GetAttackInfo(FAttackInfo& OutAttackInfo, int32 CollisionIndex = 1);
 
 	/** Returns true if this skill is valid, i.e, skill belongs to a valid skill group */
 	FORCEINLINE bool IsValid() const { return SkillGroup != NAME_None && SkillIndex != 0; }
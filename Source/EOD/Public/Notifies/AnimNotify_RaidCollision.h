@@ -38,6 +38,15 @@ public:
 	}
 };
 
+/** World space shape of a single raid capsule, computed once per notify */
+struct FRaidWorldCapsule
+{
+	FVector Center;
+	FQuat Rotation;
+	float HalfHeight;
+	float Radius;
+};
+
 /**
  * An anim notify class to handle collisions of RaiderZ format
  */
@@ -57,4 +66,18 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = SkillInfo)
 	FCollisionSkillInfo SkillInfo;
 
+private:
+
+	/** Transforms all collision capsules from mesh space to world space */
+	void GetWorldCapsules(const FTransform& WorldTransform, TArray<FRaidWorldCapsule, TInlineAllocator<8>>& OutCapsules) const;
+
+	/**
+	 * Sweeps all the world capsules with a single scene query and filters its hits so that every hit actor is reported only once.
+	 * @return True if any of the capsules hit something
+	 */
+	bool SweepWorldCapsules(UWorld* World, const TArray<FRaidWorldCapsule, TInlineAllocator<8>>& Capsules, const FCollisionQueryParams& Params, TArray<FHitResult>& OutHitResults) const;
+
+	/** Returns true if the collision of the hit component overlaps any of the capsules */
+	static bool IsHitInsideAnyCapsule(const FHitResult& HitResult, const TArray<FRaidWorldCapsule, TInlineAllocator<8>>& Capsules);
+
 };
@@ -162,9 +162,17 @@ struct EOD_API FCollisionSkillInfo
 	UPROPERTY(EditAnywhere)
 	int32 CollisionIndex;
 
+	/**
+	 * If true, the line of sight traces for hits of this collision are queued on the async trace queue and
+	 * the damage is applied once the trace results arrive in the next frame.
+	 */
+	UPROPERTY(EditAnywhere)
+	bool bAsyncLineOfSight;
+
 	FCollisionSkillInfo() :
 		SkillGroup(NAME_None),
-		CollisionIndex(1)
+		CollisionIndex(1),
+		bAsyncLineOfSight(false)
 	{
 	}
 };
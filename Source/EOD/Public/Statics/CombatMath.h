@@ -0,0 +1,130 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CombatLibrary.h"
+
+/** State of the character receiving an attack that is relevant for resolving the attack */
+struct EOD_API FCombatDefenderState
+{
+	/** Forward vector of the defending character */
+	FVector Forward;
+
+	/** True if the defender currently has active invincibility frames */
+	bool bDodgingDamage;
+
+	/** True if the defender is currently blocking damage */
+	bool bBlockingDamage;
+
+	/** Percentage of physical damage that is reduced on blocking an attack */
+	float PhysicalDamageReductionOnBlock;
+
+	/** Percentage of magickal damage that is reduced on blocking an attack */
+	float MagickalDamageReductionOnBlock;
+
+	FCombatDefenderState() :
+		Forward(FVector::ForwardVector),
+		bDodgingDamage(false),
+		bBlockingDamage(false),
+		PhysicalDamageReductionOnBlock(0.f),
+		MagickalDamageReductionOnBlock(0.f)
+	{
+	}
+};
+
+/** Result of resolving an attack against a defender */
+struct EOD_API FCombatHitOutcome
+{
+	EDamageResult DamageResult;
+
+	/** Angle between defender's forward vector and the impact normal of the hit, in degrees */
+	float BCAngle;
+
+	int32 ActualDamage;
+
+	bool bCritHit;
+
+	bool bAttackBlocked;
+
+	FCombatHitOutcome() :
+		DamageResult(EDamageResult::Damaged),
+		BCAngle(0.f),
+		ActualDamage(0),
+		bCritHit(false),
+		bAttackBlocked(false)
+	{
+	}
+};
+
+/** Result of a combat math benchmark run */
+struct EOD_API FCombatBenchmarkResult
+{
+	int32 NumHits;
+
+	double Seconds;
+
+	double HitsPerSecond;
+
+	/** Sum of the damage dealt by all hits. Identical seeds must always produce the same total damage */
+	int64 TotalDamage;
+
+	int32 NumCritHits;
+
+	int32 NumBlockedHits;
+
+	int32 NumDodgedHits;
+
+	FCombatBenchmarkResult() :
+		NumHits(0),
+		Seconds(0.0),
+		HitsPerSecond(0.0),
+		TotalDamage(0),
+		NumCritHits(0),
+		NumBlockedHits(0),
+		NumDodgedHits(0)
+	{
+	}
+};
+
+/**
+ * FCombatMath contains the world independent part of damage resolution.
+ * All randomness is drawn from the random stream passed in by the caller so the results are deterministic for a given seed.
+ */
+class EOD_API FCombatMath
+{
+public:
+
+	/** Returns true if an attack with the given crit rate (in percent) lands a critical hit */
+	static bool RollCritHit(float CritRate, FRandomStream& RandomStream);
+
+	/** Returns angle between two vectors in degrees */
+	static float CalculateAngleBetweenVectors(const FVector& Vector1, const FVector& Vector2);
+
+	/**
+	 * Returns the damage dealt by an attack after applying critical hit and block damage reduction.
+	 * The damage is never negative, and the block damage reduction is clamped between 0 and 100 percent.
+	 */
+	static float GetActualDamage(const FAttackInfo& AttackInfo, const bool bCritHit, const bool bAttackBlocked, float DamageReductionOnBlock);
+
+	/**
+	 * Resolves an attack against a defender
+	 * @param AttackInfo The attack being resolved
+	 * @param Defender State of the character receiving the attack
+	 * @param ImpactNormal Impact normal of the line hit result if bLineHitResultFound is true, otherwise of the direct hit result
+	 * @param bLineHitResultFound True if the line of sight trace from the instigator hit the defender. Attacks can only be blocked if it did.
+	 * @param RandomStream Stream used for all random rolls
+	 * @param OutOutcome Outs the result of the attack
+	 */
+	static void ResolveHit(
+		const FAttackInfo& AttackInfo,
+		const FCombatDefenderState& Defender,
+		const FVector& ImpactNormal,
+		const bool bLineHitResultFound,
+		FRandomStream& RandomStream,
+		FCombatHitOutcome& OutOutcome);
+
+	/** Resolves NumHits randomly generated attacks with the given seed and measures how long it took */
+	static void RunBenchmark(int32 NumHits, int32 Seed, FCombatBenchmarkResult& OutResult);
+
+};
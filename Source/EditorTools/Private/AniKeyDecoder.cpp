@@ -0,0 +1,144 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "AniKeyDecoder.h"
+#include "AniLoader.h"
+#include "RaiderzBinaryReader.h"
+
+#include "Math/VectorRegister.h"
+
+void FAniKeyTrackSoA::SetNumUninitialized(int32 NewNum, bool bWithW)
+{
+	Frames.SetNumUninitialized(NewNum, false);
+	X.SetNumUninitialized(NewNum, false);
+	Y.SetNumUninitialized(NewNum, false);
+	Z.SetNumUninitialized(NewNum, false);
+	W.SetNumUninitialized(bWithW ? NewNum : 0, false);
+}
+
+bool FAniKeyDecoder::ReadShortVecKeys(FRaiderzBinaryReader& Reader, int32 Count, FAniKeyTrackSoA& OutTrack, bool bWithW)
+{
+	const int64 NumBytes = (int64)Count * ShortVecKeySize;
+	TArrayView<const uint8> Records;
+	if (Count < 0 || NumBytes > MAX_int32 || !Reader.ReadView((int32)NumBytes, Records))
+	{
+		return false;
+	}
+
+	OutTrack.SetNumUninitialized(Count, bWithW);
+
+	int32* RESTRICT Frames = OutTrack.Frames.GetData();
+	float* RESTRICT X = OutTrack.X.GetData();
+	float* RESTRICT Y = OutTrack.Y.GetData();
+	float* RESTRICT Z = OutTrack.Z.GetData();
+
+	// Records are 10 bytes and so only byte aligned. Memcpy compiles down to plain unaligned loads
+	const uint8* Record = Records.GetData();
+	for (int32 Index = 0; Index < Count; ++Index, Record += ShortVecKeySize)
+	{
+		uint16 Halves[3];
+		FMemory::Memcpy(&Frames[Index], Record, sizeof(int32));
+		FMemory::Memcpy(Halves, Record + sizeof(int32), sizeof(Halves));
+
+		X[Index] = HalfToFloat(Halves[0]);
+		Y[Index] = HalfToFloat(Halves[1]);
+		Z[Index] = HalfToFloat(Halves[2]);
+	}
+
+	return true;
+}
+
+bool FAniKeyDecoder::ReadUniqueVecKeys(FRaiderzBinaryReader& Reader, int32 Count, FAniKeyTrackSoA& OutTrack, bool bWithW)
+{
+	const int64 NumBytes = (int64)Count * UniqueVecKeySize;
+	TArrayView<const uint8> Records;
+	if (Count < 0 || NumBytes > MAX_int32 || !Reader.ReadView((int32)NumBytes, Records))
+	{
+		return false;
+	}
+
+	OutTrack.SetNumUninitialized(Count, bWithW);
+
+	int32* RESTRICT Frames = OutTrack.Frames.GetData();
+	float* RESTRICT X = OutTrack.X.GetData();
+	float* RESTRICT Y = OutTrack.Y.GetData();
+	float* RESTRICT Z = OutTrack.Z.GetData();
+
+	const uint8* Record = Records.GetData();
+	for (int32 Index = 0; Index < Count; ++Index, Record += UniqueVecKeySize)
+	{
+		float Components[3];
+		FMemory::Memcpy(&Frames[Index], Record, sizeof(int32));
+		FMemory::Memcpy(Components, Record + sizeof(int32), sizeof(Components));
+
+		X[Index] = Components[0];
+		Y[Index] = Components[1];
+		Z[Index] = Components[2];
+	}
+
+	return true;
+}
+
+void FAniKeyDecoder::ReconstructQuatW(FAniKeyTrackSoA& Track)
+{
+	const int32 Num = Track.Num();
+	check(Track.W.Num() == Num);
+
+	const float* X = Track.X.GetData();
+	const float* Y = Track.Y.GetData();
+	const float* Z = Track.Z.GetData();
+	float* W = Track.W.GetData();
+
+	// W = sqrt(max(1 - (X^2 + Y^2 + Z^2), 0)). There's no vector sqrt, so it's computed as V * rsqrt(V) with V = 0 masked out
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister One = VectorOne();
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister VX = VectorLoad(X + Index);
+		const VectorRegister VY = VectorLoad(Y + Index);
+		const VectorRegister VZ = VectorLoad(Z + Index);
+
+		VectorRegister SizeSquared = VectorMultiply(VX, VX);
+		SizeSquared = VectorMultiplyAdd(VY, VY, SizeSquared);
+		SizeSquared = VectorMultiplyAdd(VZ, VZ, SizeSquared);
+
+		const VectorRegister WSquared = VectorMax(VectorSubtract(One, SizeSquared), Zero);
+		const VectorRegister VW = VectorMultiply(WSquared, VectorReciprocalSqrtAccurate(WSquared));
+		VectorStore(VectorSelect(VectorCompareGT(WSquared, Zero), VW, Zero), W + Index);
+	}
+
+	for (; Index < Num; ++Index)
+	{
+		const float SizeSquared = X[Index] * X[Index] + Y[Index] * Y[Index] + Z[Index] * Z[Index];
+		W[Index] = SizeSquared <= 1.f ? FMath::Sqrt(1.f - SizeSquared) : 0.f;
+	}
+}
+
+void FAniKeyDecoder::AppendPositionKeys(const FAniKeyTrackSoA& Track, TArray<FVecKey>& OutKeys)
+{
+	const int32 Num = Track.Num();
+	const int32 StartIndex = OutKeys.AddUninitialized(Num);
+	FVecKey* RESTRICT Keys = OutKeys.GetData() + StartIndex;
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Keys[Index].Key = FVector(Track.X[Index], Track.Y[Index], Track.Z[Index]);
+		Keys[Index].Frame = Track.Frames[Index];
+	}
+}
+
+void FAniKeyDecoder::AppendRotationKeys(const FAniKeyTrackSoA& Track, TArray<FRotKey>& OutKeys)
+{
+	const int32 Num = Track.Num();
+	check(Track.W.Num() == Num);
+
+	const int32 StartIndex = OutKeys.AddUninitialized(Num);
+	FRotKey* RESTRICT Keys = OutKeys.GetData() + StartIndex;
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Keys[Index].Quat = FQuat(Track.X[Index], Track.Y[Index], Track.Z[Index], Track.W[Index]);
+		Keys[Index].Frame = Track.Frames[Index];
+	}
+}
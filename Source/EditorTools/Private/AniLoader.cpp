@@ -3,33 +3,32 @@
 #include "AniLoader.h"
 #include "EOD.h"
 #include "EluLibrary.h"
-#include "RaiderzXmlUtilities.h"
 
-void FAnimationFileLoadImpl_v6::LoadVertexAniBoundingBox(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset)
+void FAnimationFileLoadImpl_v6::LoadVertexAniBoundingBox(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader)
 {
 	//~ pass
 }
 
-bool FAnimationFileLoadImpl_v6::LoadVertexAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v6::LoadVertexAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(Node->NodeName))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->VertexCount, sizeof(Node->VertexCount), BinaryData, Offset))
+	if (!Reader.Read(Node->VertexCount))
 	{
 		return false;
 	}
 
 	int VertexPointCount;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VertexPointCount, sizeof(VertexPointCount), BinaryData, Offset);
+	Reader.Read(VertexPointCount);
 	Node->VertexPointCount = VertexPointCount;
 
 	for (int i = 0; i < Node->VertexCount; i++)
 	{
 		DWORD Val;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Val, sizeof(Val), BinaryData, Offset))
+		if (!Reader.Read(Val))
 		{
 			return false;
 		}
@@ -41,7 +40,7 @@ bool FAnimationFileLoadImpl_v6::LoadVertexAni(TSharedPtr<FAniNode> Node, TArray<
 		for (int j = 0; j < VertexPointCount; j++)
 		{
 			FVector TempVec;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&TempVec, sizeof(TempVec), BinaryData, Offset))
+			if (!Reader.Read(TempVec))
 			{
 				return false;
 			}
@@ -49,45 +48,40 @@ bool FAnimationFileLoadImpl_v6::LoadVertexAni(TSharedPtr<FAniNode> Node, TArray<
 		}
 	}
 
-	LoadVertexAniBoundingBox(Node, BinaryData, Offset);
+	LoadVertexAniBoundingBox(Node, Reader);
 
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v6::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v6::LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(Node->NodeName))
 	{
 		return false;
 	}
 
 	if (Version >= EXPORTER_ANI_VER6)
 	{
-		if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->ParentNodeName, BinaryData, Offset))
+		if (!Reader.ReadName(Node->ParentNodeName))
 		{
 			return false;
 		}
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->LocalMatrix, sizeof(Node->LocalMatrix), BinaryData, Offset))
+	if (!Reader.Read(Node->LocalMatrix))
 	{
 		return false;
 	}
 
 	int pos_key_num = 0;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&pos_key_num, sizeof(pos_key_num), BinaryData, Offset))
+	if (!Reader.Read(pos_key_num))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < pos_key_num; i++)
+	if (!Reader.ReadArray(pos_key_num, Node->PositionKeyTrack))
 	{
-		FVecKey PosKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PosKey, sizeof(PosKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->PositionKeyTrack.Add(PosKey);
+		return false;
 	}
 
 	if (Node->PositionKeyTrack.Num() > 0)
@@ -97,19 +91,14 @@ bool FAnimationFileLoadImpl_v6::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<ui
 	}
 
 	int rot_key_num = 0;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&rot_key_num, sizeof(rot_key_num), BinaryData, Offset))
+	if (!Reader.Read(rot_key_num))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < rot_key_num; i++)
+	if (!Reader.ReadArray(rot_key_num, Node->RotationKeyTrack))
 	{
-		FRotKey RotKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&RotKey, sizeof(RotKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->RotationKeyTrack.Add(RotKey);
+		return false;
 	}
 
 	if (Node->RotationKeyTrack.Num() > 0)
@@ -121,43 +110,33 @@ bool FAnimationFileLoadImpl_v6::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<ui
 	if (Version >= EXPORTER_ANI_VER5)
 	{
 		int scale_key_num = 0;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&scale_key_num, sizeof(scale_key_num), BinaryData, Offset))
+		if (!Reader.Read(scale_key_num))
 		{
 			return false;
 		}
 
-		for (int i = 0; i < scale_key_num; i++)
+		if (!Reader.ReadArray(scale_key_num, Node->ScaleKeyTrack))
 		{
-			FVecKey ScaleKey;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&ScaleKey, sizeof(ScaleKey), BinaryData, Offset))
-			{
-				return false;
-			}
-			Node->ScaleKeyTrack.Add(ScaleKey);
+			return false;
 		}
 	}
 
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v6::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v6::LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
 	if (Version >= EXPORTER_ANI_VER5)
 	{
 		int vis_key_num = 0;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&vis_key_num, sizeof(vis_key_num), BinaryData, Offset))
+		if (!Reader.Read(vis_key_num))
 		{
 			return false;
 		}
 
-		for (int i = 0; i < vis_key_num; i++)
+		if (!Reader.ReadArray(vis_key_num, Node->VisibilityKeyTrack))
 		{
-			FVisKey VisKey;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VisKey, sizeof(VisKey), BinaryData, Offset))
-			{
-				return false;
-			}
-			Node->VisibilityKeyTrack.Add(VisKey);
+			return false;
 		}
 
 		for (FVisKey& VisKey : Node->VisibilityKeyTrack)
@@ -171,7 +150,7 @@ bool FAnimationFileLoadImpl_v6::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TAr
 	else
 	{
 		int vis_key_num = 0;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&vis_key_num, sizeof(vis_key_num), BinaryData, Offset))
+		if (!Reader.Read(vis_key_num))
 		{
 			return false;
 		}
@@ -184,7 +163,7 @@ bool FAnimationFileLoadImpl_v6::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TAr
 
 		for (int i = 0; i < vis_key_num; i++)
 		{
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&OldKey, sizeof(OldKey), BinaryData, Offset))
+			if (!Reader.Read(OldKey))
 			{
 				return false;
 			}
@@ -208,22 +187,17 @@ bool FAnimationFileLoadImpl_v6::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TAr
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v9::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v9::LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
 	int vis_key_num = 0;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&vis_key_num, sizeof(vis_key_num), BinaryData, Offset))
+	if (!Reader.Read(vis_key_num))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < vis_key_num; i++)
+	if (!Reader.ReadArray(vis_key_num, Node->VisibilityKeyTrack))
 	{
-		FVisKey VisKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VisKey, sizeof(VisKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->VisibilityKeyTrack.Add(VisKey);
+		return false;
 	}
 
 	for (FVisKey& VisKey : Node->VisibilityKeyTrack)
@@ -237,37 +211,32 @@ bool FAnimationFileLoadImpl_v9::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TAr
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v11::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v11::LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(Node->NodeName))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->ParentNodeName, BinaryData, Offset))
+	if (!Reader.ReadName(Node->ParentNodeName))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->LocalMatrix, sizeof(Node->LocalMatrix), BinaryData, Offset))
+	if (!Reader.Read(Node->LocalMatrix))
 	{
 		return false;
 	}
 
 	FAnimType AnimType1;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType1, sizeof(AnimType1), BinaryData, Offset))
+	if (!Reader.Read(AnimType1))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < AnimType1.Count; i++)
+	if (!Reader.ReadArray(AnimType1.Count, Node->PositionKeyTrack))
 	{
-		FVecKey PosKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PosKey, sizeof(PosKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->PositionKeyTrack.Add(PosKey);
+		return false;
 	}
 
 	if (Node->PositionKeyTrack.Num() > 0)
@@ -277,19 +246,14 @@ bool FAnimationFileLoadImpl_v11::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 	}
 
 	FAnimType AnimType2;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType2, sizeof(AnimType2), BinaryData, Offset))
+	if (!Reader.Read(AnimType2))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < AnimType2.Count; i++)
+	if (!Reader.ReadArray(AnimType2.Count, Node->RotationKeyTrack))
 	{
-		FRotKey RotKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&RotKey, sizeof(RotKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->RotationKeyTrack.Add(RotKey);
+		return false;
 	}
 
 	if (Node->RotationKeyTrack.Num() > 0)
@@ -299,40 +263,30 @@ bool FAnimationFileLoadImpl_v11::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 	}
 
 	FAnimType AnimType3;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType3, sizeof(AnimType3), BinaryData, Offset))
+	if (!Reader.Read(AnimType3))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < AnimType3.Count; i++)
+	if (!Reader.ReadArray(AnimType3.Count, Node->ScaleKeyTrack))
 	{
-		FVecKey ScaleKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&ScaleKey, sizeof(ScaleKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->ScaleKeyTrack.Add(ScaleKey);
+		return false;
 	}
 
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v11::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v11::LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
 	FAnimType AnimType;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType, sizeof(AnimType), BinaryData, Offset))
+	if (!Reader.Read(AnimType))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < AnimType.Count; i++)
+	if (!Reader.ReadArray(AnimType.Count, Node->VisibilityKeyTrack))
 	{
-		FVisKey VisKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VisKey, sizeof(VisKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->VisibilityKeyTrack.Add(VisKey);
+		return false;
 	}
 
 	for (FVisKey& VisKey : Node->VisibilityKeyTrack)
@@ -346,9 +300,9 @@ bool FAnimationFileLoadImpl_v11::LoadVisibilityKey(TSharedPtr<FAniNode> Node, TA
 	return true;
 }
 
-bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)
+bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(Node->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(Node->NodeName))
 	{
 		return false;
 	}
@@ -356,54 +310,38 @@ bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 	int Unk = 0;
 	FVector BaseTrans;
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->BaseTranslation, sizeof(Node->BaseTranslation), BinaryData, Offset))
+	if (!Reader.Read(Node->BaseTranslation))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->BaseRotation, sizeof(Node->BaseRotation), BinaryData, Offset))
+	if (!Reader.Read(Node->BaseRotation))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Node->BaseScale, sizeof(Node->BaseScale), BinaryData, Offset))
+	if (!Reader.Read(Node->BaseScale))
 	{
 		return false;
 	}
 
 	FAnimType AnimType1;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType1, sizeof(AnimType1), BinaryData, Offset))
+	if (!Reader.Read(AnimType1))
 	{
 		return false;
 	}
 	
 	if (AnimType1.Count > 0)
 	{
-		if (AnimType1.CountType == 10)
+		if (AnimType1.CountType == FAniKeyDecoder::ShortVecKeySize)
 		{
-			TArray<FShortVecKey> ShortPosKeys;
-			for (int i = 0; i < AnimType1.Count; i++)
+			if (!FAniKeyDecoder::ReadShortVecKeys(Reader, AnimType1.Count, DecodedKeys, false))
 			{
-				FShortVecKey ShortVecKey;
-				if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&ShortVecKey, 10 /*sizeof(ShortVecKey)*/, BinaryData, Offset))
-				{
-					return false;
-				}
-				ShortPosKeys.Add(ShortVecKey);
+				return false;
 			}
 
-			for (const FShortVecKey& ShortVecKey : ShortPosKeys)
-			{
-				FVecKey PosKey;
-
-				PosKey.Frame = ShortVecKey.Frame;
-				PosKey.Key.X = ShortVecKey.X();
-				PosKey.Key.Y = ShortVecKey.Y();
-				PosKey.Key.Z = ShortVecKey.Z();
-
-
-				Node->PositionKeyTrack.Add(PosKey);
-			}
+			Node->PositionKeyTrack.Reserve(Node->PositionKeyTrack.Num() + AnimType1.Count + 1);
+			FAniKeyDecoder::AppendPositionKeys(DecodedKeys, Node->PositionKeyTrack);
 
 			if (Node->PositionKeyTrack.Num() > 0)
 			{
@@ -413,14 +351,15 @@ bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 		}
 		else if (AnimType1.CountType == 16)
 		{
-			for (int i = 0; i < AnimType1.Count; i++)
+			if (!Reader.CanRead(AnimType1.Count, sizeof(FVecKey)))
 			{
-				FVecKey PosKey;
-				if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PosKey, sizeof(PosKey), BinaryData, Offset))
-				{
-					return false;
-				}
-				Node->PositionKeyTrack.Add(PosKey);
+				return false;
+			}
+
+			Node->PositionKeyTrack.Reserve(Node->PositionKeyTrack.Num() + AnimType1.Count + 1);
+			if (!Reader.ReadArray(AnimType1.Count, Node->PositionKeyTrack))
+			{
+				return false;
 			}
 
 			if (Node->PositionKeyTrack.Num() > 0)
@@ -437,49 +376,27 @@ bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 	}
 
 	FAnimType AnimType2;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType2, sizeof(AnimType2), BinaryData, Offset))
+	if (!Reader.Read(AnimType2))
 	{
 		return false;
 	}
 
 	if (AnimType2.Count > 0)
 	{
-		if (AnimType2.CountType == 10)
+		if (AnimType2.CountType == FAniKeyDecoder::ShortVecKeySize || AnimType2.CountType == FAniKeyDecoder::UniqueVecKeySize)
 		{
-			TArray<FShortVecKey> ShortVecKeys;
-			for (int i = 0; i < AnimType2.Count; i++)
+			const bool bReadKeys = AnimType2.CountType == FAniKeyDecoder::ShortVecKeySize ?
+				FAniKeyDecoder::ReadShortVecKeys(Reader, AnimType2.Count, DecodedKeys, true) :
+				FAniKeyDecoder::ReadUniqueVecKeys(Reader, AnimType2.Count, DecodedKeys, true);
+			if (!bReadKeys)
 			{
-				FShortVecKey ShortVecKey;
-				if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&ShortVecKey, 10 /*sizeof(ShortVecKey)*/, BinaryData, Offset))
-				{
-					return false;
-				}
-				ShortVecKeys.Add(ShortVecKey);
+				return false;
 			}
 
-			for (const FShortVecKey& ShortVecKey : ShortVecKeys)
-			{
-				FRotKey RotKey;
-
-				RotKey.Frame = ShortVecKey.Frame;
-				RotKey.Quat.X = ShortVecKey.X();
-				RotKey.Quat.Y = ShortVecKey.Y();
-				RotKey.Quat.Z = ShortVecKey.Z();
-
-				float fTol = RotKey.Quat.X * RotKey.Quat.X + RotKey.Quat.Y * RotKey.Quat.Y + RotKey.Quat.Z * RotKey.Quat.Z;
-				if (fTol <= 1.f)
-				{
-					float sub1 = 1.0f - fTol;
-					float fSqrt = FMath::Sqrt(sub1);
-					RotKey.Quat.W = fSqrt;
-				}
-				else
-				{
-					RotKey.Quat.W = 0.f;
-				}
+			FAniKeyDecoder::ReconstructQuatW(DecodedKeys);
 
-				Node->RotationKeyTrack.Add(RotKey);
-			}
+			Node->RotationKeyTrack.Reserve(Node->RotationKeyTrack.Num() + AnimType2.Count + 1);
+			FAniKeyDecoder::AppendRotationKeys(DecodedKeys, Node->RotationKeyTrack);
 
 			if (Node->RotationKeyTrack.Num() > 0)
 			{
@@ -487,58 +404,17 @@ bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 				Node->RotationKeyTrack.Add(RotKey);
 			}
 		}
-		else if (AnimType2.CountType == 16)
+		else if (AnimType2.CountType == 20)
 		{
-			TArray<FUniqueVecKey> UniVecKeys;
-			for (int i = 0; i < AnimType2.Count; i++)
+			if (!Reader.CanRead(AnimType2.Count, sizeof(FRotKey)))
 			{
-				FUniqueVecKey uvecKey;
-				if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&uvecKey, sizeof(uvecKey), BinaryData, Offset))
-				{
-					return false;
-				}
-				UniVecKeys.Add(uvecKey);
-			}
-
-			for (const FUniqueVecKey& uvecKey : UniVecKeys)
-			{
-				FRotKey RotKey;
-				RotKey.Frame = uvecKey.Frame;
-				RotKey.Quat.X = uvecKey.Key.X;
-				RotKey.Quat.Y = uvecKey.Key.Y;
-				RotKey.Quat.Z = uvecKey.Key.Z;
-
-				float fTol = RotKey.Quat.X * RotKey.Quat.X + RotKey.Quat.Y * RotKey.Quat.Y + RotKey.Quat.Z * RotKey.Quat.Z;
-				if (fTol <= 1.f)
-				{
-					float sub1 = 1.0f - fTol;
-					float fSqrt = FMath::Sqrt(sub1);
-					RotKey.Quat.W = fSqrt;
-				}
-				else
-				{
-					RotKey.Quat.W = 0.f;
-				}
-
-				Node->RotationKeyTrack.Add(RotKey);
+				return false;
 			}
 
-			if (Node->RotationKeyTrack.Num() > 0)
-			{
-				FRotKey RotKey = Node->RotationKeyTrack[Node->RotationKeyTrack.Num() - 1];
-				Node->RotationKeyTrack.Add(RotKey);
-			}
-		}
-		else if (AnimType2.CountType == 20)
-		{
-			for (int i = 0; i < AnimType2.Count; i++)
+			Node->RotationKeyTrack.Reserve(Node->RotationKeyTrack.Num() + AnimType2.Count + 1);
+			if (!Reader.ReadArray(AnimType2.Count, Node->RotationKeyTrack))
 			{
-				FRotKey RotKey;
-				if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&RotKey, sizeof(RotKey), BinaryData, Offset))
-				{
-					return false;
-				}
-				Node->RotationKeyTrack.Add(RotKey);
+				return false;
 			}
 
 			if (Node->RotationKeyTrack.Num() > 0)
@@ -550,19 +426,14 @@ bool FAnimationFileLoadImpl_v12::LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<u
 	}
 
 	FAnimType AnimType3;
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AnimType3, sizeof(AnimType3), BinaryData, Offset))
+	if (!Reader.Read(AnimType3))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < AnimType3.Count; i++)
+	if (!Reader.ReadArray(AnimType3.Count, Node->ScaleKeyTrack))
 	{
-		FVecKey ScaleKey;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&ScaleKey, sizeof(ScaleKey), BinaryData, Offset))
-		{
-			return false;
-		}
-		Node->ScaleKeyTrack.Add(ScaleKey);
+		return false;
 	}
 
 	return true;
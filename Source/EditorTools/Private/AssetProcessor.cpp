@@ -4,6 +4,7 @@
 #include "AssetProcessor.h"
 #include "EOD.h"
 #include "RaiderzXmlUtilities.h"
+#include "RaiderzXmlDatabase.h"
 #include "EditorFunctionLibrary.h"
 
 #include "Sound/SoundClass.h"
@@ -80,9 +81,7 @@ bool UAssetProcessor::NormalizeBoneScale(UAnimSequence* AnimSeq)
 
 void UAssetProcessor::ImportRaiderzSoundSettings(USoundAttenuation* Attenuation)
 {
-	FXmlFile SoundFileObj(URaiderzXmlUtilities::SoundXmlFilePath);
-	FXmlNode* RootSoundNode = SoundFileObj.GetRootNode();
-	TArray<FXmlNode*> SoundNodes = URaiderzXmlUtilities::GetNodesWithTag(RootSoundNode, TEXT("SOUND"));
+	const TArray<FRaiderzXmlElement>& SoundNodes = FRaiderzXmlDatabase::Get().GetAllSounds();
 
 
 	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
@@ -128,38 +127,27 @@ void UAssetProcessor::ImportRaiderzSoundSettings(USoundAttenuation* Attenuation)
 	FScopedSlowTask SlowTask(SoundNodes.Num(), FText::FromString("Importing Raiderz Sound Settings!"));
 	SlowTask.MakeDialog();
 
-	TArray<FAssetData> AllSoundAssets = UEditorFunctionLibrary::GetAllSoundAssets();
+	const TMap<FName, FAssetData> SoundAssetsByName = UEditorFunctionLibrary::GetAllSoundAssetsByName();
 
-	for (FXmlNode* Node : SoundNodes)
+	for (const FRaiderzXmlElement& Node : SoundNodes)
 	{
 		SlowTask.EnterProgressFrame();
 
-		check(Node);
-
-		const FString& SoundFilePath = Node->GetAttribute(TEXT("filename"));
+		const FString& SoundFilePath = Node.GetAttribute(TEXT("filename"));
 		const FString& SoundFileName = FPaths::GetCleanFilename(SoundFilePath);
 		const FString& ProbableEditorSoundName = URaiderzXmlUtilities::GetRaiderzBaseFileName(SoundFileName);
 		const FString& EditorSoundName = PackageTools::SanitizePackageName(ProbableEditorSoundName);
 
-		USoundWave* SoundFile = nullptr;
-		for (const FAssetData& SoundAsset : AllSoundAssets)
-		{
-			if (SoundAsset.AssetName.ToString() == EditorSoundName)
-			{
-				USoundWave* Sound = Cast<USoundWave>(SoundAsset.GetAsset());
-				if (Sound)
-				{
-					SoundFile = Sound;
-				}
-			}
-		}
+		const FName SoundAssetName(*EditorSoundName, FNAME_Find);
+		const FAssetData* SoundAsset = SoundAssetName.IsNone() ? nullptr : SoundAssetsByName.Find(SoundAssetName);
+		USoundWave* SoundFile = SoundAsset ? Cast<USoundWave>(SoundAsset->GetAsset()) : nullptr;
 
 		if (SoundFile == nullptr)
 		{
 			continue;
 		}
 
-		const FString& LoopString = Node->GetAttribute(TEXT("loop"));
+		const FString& LoopString = Node.GetAttribute(TEXT("loop"));
 		if (LoopString == TEXT("true") && SoundFile->bLooping != true)
 		{
 			SoundFile->Modify();
@@ -168,10 +156,10 @@ void UAssetProcessor::ImportRaiderzSoundSettings(USoundAttenuation* Attenuation)
 		}
 
 		/*
-		const FString& TypeString = Node->GetAttribute(TEXT("type"));
-		const FString& PriorityString = Node->GetAttribute(TEXT("priority"));
-		const FString& MaxdistString = Node->GetAttribute(TEXT("maxdist"));
-		const FString& VolumeString = Node->GetAttribute(TEXT("volume"));
+		const FString& TypeString = Node.GetAttribute(TEXT("type"));
+		const FString& PriorityString = Node.GetAttribute(TEXT("priority"));
+		const FString& MaxdistString = Node.GetAttribute(TEXT("maxdist"));
+		const FString& VolumeString = Node.GetAttribute(TEXT("volume"));
 
 		if (TypeString == TEXT("bgm") && SoundFile->GetSoundClass() != MusicSC)
 		{
@@ -4,6 +4,7 @@
 #include "CollisionImporter.h"
 #include "EOD.h"
 #include "RaiderzXmlUtilities.h"
+#include "RaiderzXmlDatabase.h"
 #include "EditorFunctionLibrary.h"
 #include "AnimNotify_CapsuleCollision.h"
 
@@ -32,9 +33,8 @@ void UCollisionImporter::ImportCollisionForSkeletalMesh(USkeletalMesh* Mesh)
 	FScopedSlowTask SlowTask(4, FText::FromString("Finding and parsing XML files!"));
 	SlowTask.MakeDialog();
 
-	FXmlFile NPCFileObj(URaiderzXmlUtilities::NPCXmlFilePath);
-	FXmlNode* NPCRootNode = NPCFileObj.GetRootNode();
-	FXmlNode* NPCNode = GetNPCNode(NPCRootNode, CurrentMeshName);
+	FRaiderzXmlDatabase& XmlDatabase = FRaiderzXmlDatabase::Get();
+	const FRaiderzXmlElement* NPCNode = XmlDatabase.FindNPCByMeshName(CurrentMeshName);
 	if (NPCNode == nullptr)
 	{
 		PrintError(TEXT("Import failed because we couldn't find a proper NPC ID for the given skeletal mesh"));
@@ -45,9 +45,7 @@ void UCollisionImporter::ImportCollisionForSkeletalMesh(USkeletalMesh* Mesh)
 	const FString& NPCID = NPCNode->GetAttribute(TEXT("id"));
 	const FString& NPCAniPrefix = NPCNode->GetAttribute(TEXT("AniPrefix"));
 
-	FXmlFile TalentFileObj(URaiderzXmlUtilities::TalentXmlFilePath);
-	FXmlNode* TalentRootNode = TalentFileObj.GetRootNode();
-	TArray<FXmlNode*> TalentNodes = GetNPCTalents(TalentRootNode, NPCID);
+	const TArray<const FRaiderzXmlElement*>& TalentNodes = XmlDatabase.GetNPCTalents(NPCID);
 	if (TalentNodes.Num() == 0)
 	{
 		PrintWarning(TEXT("Couldn't find any talent associated with the given skeletal mesh"));
@@ -67,23 +65,20 @@ void UCollisionImporter::ImportCollisionForSkeletalMesh(USkeletalMesh* Mesh)
 	TArray<FXmlNode*> AddAnimationNodes = URaiderzXmlUtilities::GetNodesWithTag(RootAnimNode, TEXT("AddAnimation"));
 	SlowTask.EnterProgressFrame();
 
-	FXmlFile TalentHitInfoFileObj(URaiderzXmlUtilities::TalentHitInfoXmlFilePath);
-	FXmlNode* RootTalentHitInfoNode = TalentHitInfoFileObj.GetRootNode();
-	TArray<FXmlNode*> TalentHitNodes = URaiderzXmlUtilities::GetNodesWithTag(RootTalentHitInfoNode, TEXT("TALENT_HIT"));
-	check(TalentHitNodes.Num() != 0);
+	// Parse talent_hit_info.xml as part of the XML stage rather than on the first hit info lookup
+	XmlDatabase.GetTable(ERaiderzXmlTable::TalentHitInfo);
 	SlowTask.EnterProgressFrame();
 
 	TArray<FAssetData> MeshAnimAssets = UEditorFunctionLibrary::GetAllAnimationsForSkeletalMesh(Mesh);
-	TArray<FCollisionInfo> CollisionInfoArray = GenerateCollisionInfoArray(NPCNode, TalentNodes, AddAnimationNodes, TalentHitNodes, MeshAnimAssets);
+	TArray<FCollisionInfo> CollisionInfoArray = GenerateCollisionInfoArray(NPCNode, TalentNodes, AddAnimationNodes, MeshAnimAssets);
 
 	CreateAndApplyCollisionNotifies(CollisionInfoArray);
 }
 
 TArray<FCollisionInfo> UCollisionImporter::GenerateCollisionInfoArray(
-	FXmlNode* NPCNode,
-	const TArray<FXmlNode*>& TalentNodes,
+	const FRaiderzXmlElement* NPCNode,
+	const TArray<const FRaiderzXmlElement*>& TalentNodes,
 	const TArray<FXmlNode*>& AddAnimNodes,
-	const TArray<FXmlNode*>& TalentHitNodes,
 	const TArray<FAssetData>& MeshAnimAssets)
 {
 	FScopedSlowTask GenTask(TalentNodes.Num(), FText::FromString("Generating CollisionInfo Array!"));
@@ -95,7 +90,7 @@ TArray<FCollisionInfo> UCollisionImporter::GenerateCollisionInfoArray(
 	}
 
 	TArray<FCollisionInfo> CollisionInfoArray;
-	for (FXmlNode* TalentNode : TalentNodes)
+	for (const FRaiderzXmlElement* TalentNode : TalentNodes)
 	{
 		if (!TalentNode)
 		{
@@ -112,7 +107,7 @@ TArray<FCollisionInfo> UCollisionImporter::GenerateCollisionInfoArray(
 		}
 
 		FCollisionInfo CollisionInfo;
-		bool bSuccess = GetCollisionInfo(NPCNode, TalentNode, AddAnimNodes, TalentHitNodes, AnimationFileName, MeshAnimAssets, CollisionInfo);
+		bool bSuccess = GetCollisionInfo(NPCNode, TalentNode, AddAnimNodes, AnimationFileName, MeshAnimAssets, CollisionInfo);
 		if (bSuccess)
 		{
 			CollisionInfoArray.Add(CollisionInfo);
@@ -129,10 +124,9 @@ TArray<FCollisionInfo> UCollisionImporter::GenerateCollisionInfoArray(
 }
 
 bool UCollisionImporter::GetCollisionInfo(
-	FXmlNode* NPCNode,
-	FXmlNode* TalentNode,
+	const FRaiderzXmlElement* NPCNode,
+	const FRaiderzXmlElement* TalentNode,
 	const TArray<FXmlNode*>& AddAnimNodes,
-	const TArray<FXmlNode*>& TalentHitNodes,
 	const FString& AnimationFileName,
 	const TArray<FAssetData>& MeshAnimAssets,
 	FCollisionInfo& OutCollisionInfo)
@@ -156,54 +150,45 @@ bool UCollisionImporter::GetCollisionInfo(
 		OutCollisionInfo.AnimationName = AnimationName;
 		OutCollisionInfo.AnimationFileName = AnimationFileName;
 		OutCollisionInfo.AnimationAssetData = AssetData;
-		OutCollisionInfo.FrameToCollisionStringMap = GetFrameToCollisionStringMap(TalentHitNodes, TalentNode, NPCNode);
+		OutCollisionInfo.FrameToCollisionStringMap = GetFrameToCollisionStringMap(TalentNode, NPCNode);
 		return true;
 	}
 
 	return false;
 }
 
-TMap<FString, TArray<FString>> UCollisionImporter::GetFrameToCollisionStringMap(const TArray<FXmlNode*>& TalentHitNodes, FXmlNode* TalentNode, FXmlNode* NPCNode)
+TMap<FString, TArray<FString>> UCollisionImporter::GetFrameToCollisionStringMap(const FRaiderzXmlElement* TalentNode, const FRaiderzXmlElement* NPCNode)
 {
 	check(NPCNode && TalentNode);
-	check(TalentHitNodes.Num() != 0);
 
 	const FString& TalentID = TalentNode->GetAttribute(TEXT("id"));
-	FXmlNode* TalentHitNode = GetTalentHitNodeWithID(TalentHitNodes, TalentID);
+	const FRaiderzXmlElement* TalentHitNode = FRaiderzXmlDatabase::Get().FindTalentHitInfo(TalentID);
 
 	TMap<FString, TArray<FString>> FrameToCollisionStringMap;
-	TArray<FXmlNode*> HitSegmentNodes = URaiderzXmlUtilities::GetNodesWithTag(TalentHitNode, TEXT("HitSegment"));
-	for (FXmlNode* HitSegmentNode : HitSegmentNodes)
+	if (!TalentHitNode)
+	{
+		return FrameToCollisionStringMap;
+	}
+
+	TArray<const FRaiderzXmlElement*> HitSegmentNodes = TalentHitNode->GetElementsWithTag(TEXT("HitSegment"));
+	for (const FRaiderzXmlElement* HitSegmentNode : HitSegmentNodes)
 	{
 		check(HitSegmentNode);
 		const FString& CheckTime = HitSegmentNode->GetAttribute(TEXT("CheckTime"));
 
 		FrameToCollisionStringMap.Add(CheckTime);
-		TArray<FXmlNode*> CapsuleNodes = URaiderzXmlUtilities::GetNodesWithTag(HitSegmentNode, TEXT("Capsule"));
-		for (FXmlNode* CapsuleNode : CapsuleNodes)
+		TArray<const FRaiderzXmlElement*> CapsuleNodes = HitSegmentNode->GetElementsWithTag(TEXT("Capsule"));
+		for (const FRaiderzXmlElement* CapsuleNode : CapsuleNodes)
 		{
 			check(CapsuleNode);
-			const FString& CapsuleStr = CapsuleNode->GetContent();
+			const FString& CapsuleStr = CapsuleNode->Content;
 			FrameToCollisionStringMap[CheckTime].Add(CapsuleStr);
 		}
 	}
 	return FrameToCollisionStringMap;
 }
 
-FXmlNode* UCollisionImporter::GetTalentHitNodeWithID(const TArray<FXmlNode*>& TalentHitNodes, const FString& TalentID)
-{
-	for (FXmlNode* HitNode : TalentHitNodes)
-	{
-		if (HitNode && HitNode->GetAttribute(TEXT("id")) == TalentID)
-		{
-			return HitNode;
-		}
-	}
-
-	return nullptr;
-}
-
-bool UCollisionImporter::GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, FXmlNode* TalentNode, FXmlNode* NPCNode, FString& OutFileName)
+bool UCollisionImporter::GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, const FRaiderzXmlElement* TalentNode, const FRaiderzXmlElement* NPCNode, FString& OutFileName)
 {
 	check(TalentNode);
 	check(NPCNode);
@@ -346,44 +331,3 @@ bool UCollisionImporter::HasCollisionNotify(UAnimSequenceBase* Animation, float
 	}
 	return false;
 }
-
-FXmlNode* UCollisionImporter::GetNPCNode(FXmlNode* NPCRootNode, const FString& MeshName)
-{
-	TArray<FXmlNode*> NPCNodes = URaiderzXmlUtilities::GetNodesWithTag(NPCRootNode, TEXT("NPC"));
-	for (FXmlNode* Node : NPCNodes)
-	{
-		if (Node && Node->GetAttribute(TEXT("MeshName")) == MeshName)
-		{
-			return Node;
-		}
-	}
-	return nullptr;
-}
-
-TArray<FXmlNode*> UCollisionImporter::GetNPCTalents(FXmlNode* TalentRootNode, const FString& InNPCID)
-{
-	TArray<FXmlNode*> AllTalentNodes = URaiderzXmlUtilities::GetNodesWithTag(TalentRootNode, TEXT("TALENT"));
-	TArray<FXmlNode*> ResultNodes;
-	for (FXmlNode* Node : AllTalentNodes)
-	{
-		FString NPCAttribute = Node ? Node->GetAttribute(TEXT("NPC")) : TEXT("");
-		if (NPCAttribute == TEXT(""))
-		{
-			continue;
-		}
-
-		TArray<FString> NPCIDs;
-		NPCAttribute.ParseIntoArray(NPCIDs, TEXT(","));
-
-		for (FString NPCID : NPCIDs)
-		{
-			FString TrimmedNPCID = NPCID.TrimStartAndEnd();
-			if (TrimmedNPCID == InNPCID)
-			{
-				ResultNodes.Add(Node);
-				break;
-			}
-		}
-	}
-	return ResultNodes;
-}
@@ -3,6 +3,7 @@
 
 #include "EditorFunctionLibrary.h"
 #include "EOD.h"
+#include "RaiderzAnimationIndex.h"
 #include "Gameplay/Skills/ActiveSkillBase.h"
 
 #include "Misc/Paths.h"
@@ -113,33 +114,7 @@ TArray<FAssetData> UEditorFunctionLibrary::GetAllAnimationsForSkeletalMesh(USkel
 		return TArray<FAssetData>();
 	}
 
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	TArray<FAssetData> AllAnimations;
-	AssetRegistryModule.Get().GetAssetsByClass(FName("AnimSequenceBase"), AllAnimations, true);
-
-	int32 AssetNum = AllAnimations.Num();
-	TArray<FAssetData> MeshAnimations;
-
-	FString TaskMessage = TEXT("Finding animations for mesh '") + SkeletalMesh->GetFName().ToString() + TEXT("'");
-	FScopedSlowTask FindAnimationTask(AssetNum, FText::FromString(TaskMessage));
-	FindAnimationTask.MakeDialog();
-
-	for (int i = 0; i < AssetNum; i++)
-	{
-		FAssetData AssetData = AllAnimations[i];
-		FAssetDataTagMapSharedView::FFindTagResult TagResult = AssetData.TagsAndValues.FindTag(TEXT("Skeleton"));
-		const FString& Result = TagResult.GetValue();
-		FSoftObjectPath ResultPath(Result);
-
-		if (ResultPath == SkeletonSoftPath)
-		{
-			MeshAnimations.Add(AssetData);
-		}
-
-		FindAnimationTask.EnterProgressFrame();
-	}
-
-	return MeshAnimations;
+	return FRaiderzAnimationIndex::Get().GetAnimationsForSkeleton(SkeletonSoftPath);
 }
 
 TArray<FAssetData> UEditorFunctionLibrary::GetAllSoundAssets()
@@ -149,3 +124,19 @@ TArray<FAssetData> UEditorFunctionLibrary::GetAllSoundAssets()
 	AssetRegistryModule.Get().GetAssetsByClass(FName("SoundBase"), SoundAssets, true);
 	return SoundAssets;
 }
+
+TMap<FName, FAssetData> UEditorFunctionLibrary::GetAllSoundAssetsByName()
+{
+	TArray<FAssetData> SoundAssets = GetAllSoundAssets();
+
+	TMap<FName, FAssetData> SoundAssetsByName;
+	SoundAssetsByName.Reserve(SoundAssets.Num());
+	for (FAssetData& SoundAsset : SoundAssets)
+	{
+		if (!SoundAssetsByName.Contains(SoundAsset.AssetName))
+		{
+			SoundAssetsByName.Add(SoundAsset.AssetName, MoveTemp(SoundAsset));
+		}
+	}
+	return SoundAssetsByName;
+}
@@ -1,4 +1,5 @@
 #include "EditorTools.h"
+#include "RaiderzAnimationIndex.h"
 
 void FEditorToolsModule::StartupModule()
 {
@@ -7,7 +8,7 @@ void FEditorToolsModule::StartupModule()
 
 void FEditorToolsModule::ShutdownModule()
 {
-
+	FRaiderzAnimationIndex::Get().Shutdown();
 }
 
 IMPLEMENT_GAME_MODULE(FEditorToolsModule, EditorTools);
@@ -4,8 +4,13 @@
 #include "EluImporter.h"
 #include "EOD.h"
 #include "RaiderzXmlUtilities.h"
+#include "RaiderzBinaryReader.h"
+#include "EluMeshCache.h"
+#include "EluMeshOptimizer.h"
 
 #include "Animation/AnimSequence.h"
+#include "Animation/AnimBoneCompressionSettings.h"
+#include "AnimationUtils.h"
 #include "ReferenceSkeleton.h"
 #include "RenderCommandFence.h"
 #include "PackageTools.h"
@@ -15,6 +20,8 @@
 #include "AssetRegistryModule.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/SkeletalMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "ConvexDecompTool.h"
 #include "UObject/Package.h"
 #include "PackageTools.h"
 #include "Misc/PackageName.h"
@@ -30,6 +37,33 @@ UEluImporter::UEluImporter(const FObjectInitializer& ObjectInitializer) : Super(
 {
 }
 
+/**
+ * Loads the asset of PackageName so that it can be rebuilt in place, which keeps every reference to it intact. OutAsset is null if the package doesn't exist yet.
+ * Returns false if the package exists and can't be rebuilt, either because bReplaceExisting is false or the package doesn't hold a T named AssetName.
+ */
+template<typename T>
+static bool GetAssetToReplace(const FString& PackageName, const FString& AssetName, bool bReplaceExisting, T*& OutAsset)
+{
+	OutAsset = nullptr;
+	if (!FPackageName::DoesPackageExist(PackageName))
+	{
+		return true;
+	}
+
+	if (!bReplaceExisting)
+	{
+		return false;
+	}
+
+	OutAsset = LoadObject<T>(nullptr, *(PackageName + TEXT(".") + AssetName), nullptr, LOAD_NoWarn);
+	if (!OutAsset)
+	{
+		PrintWarning(FString::Printf(TEXT("Can't replace %s because it doesn't contain a %s named %s"), *PackageName, *T::StaticClass()->GetName(), *AssetName));
+		return false;
+	}
+	return true;
+}
+
 void UEluImporter::ImportEluStaticMesh()
 {
 	FString EluFile;
@@ -92,68 +126,241 @@ void UEluImporter::ImportEluAnimation(USkeletalMesh* Mesh)
 		return;
 	}
 
-	FString PackageName = FString("/Game/RaiderZ/Zunk/TeshAni");
-	bool bPackageExists = FPackageName::DoesPackageExist(PackageName);
-	if (bPackageExists)
+	// Created next to the mesh with the A_ prefixed name that UCollisionImporter and USoundImporter look animations up by
+	const FString AssetName = TEXT("A_") + PackageTools::SanitizePackageName(URaiderzXmlUtilities::GetRaiderzBaseFileName(AniFilePath));
+	const FString PackageName = FPackageName::GetLongPackagePath(Mesh->GetOutermost()->GetName()) / AssetName;
+	UAnimSequence* AnimSeq = CreateAnimSequence(AniData, Mesh->Skeleton, PackageName, AssetName);
+	if (!AnimSeq)
 	{
-		return;
+		PrintWarning(TEXT("Couldn't create animation ") + PackageName + TEXT(". It either exists already or the mesh has no skeleton"));
 	}
+}
 
-	// If package doesn't exist, it's safe to create new package
-	PackageName = PackageTools::SanitizePackageName(PackageName);
-	UPackage* Package = CreatePackage(*PackageName);
-	Package->FullyLoad();
+UAnimSequence* UEluImporter::CreateAnimSequence(
+	const FAniFileData& AniData,
+	USkeleton* Skeleton,
+	const FString& PackageName,
+	const FString& AssetName,
+	const FEluAnimationImportOptions& Options)
+{
+	UAnimSequence* AnimSeq = nullptr;
+	if (!Skeleton || !GetAssetToReplace(PackageName, AssetName, Options.bReplaceExisting, AnimSeq))
+	{
+		return nullptr;
+	}
 
-	UAnimSequence* AnimSeq = NewObject<UAnimSequence>(Package, UAnimSequence::StaticClass(), *FString("TestAni"), EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
-	AnimSeq->SetSkeleton(Mesh->Skeleton);
-	AnimSeq->Interpolation = EAnimInterpolationType::Linear;
+	if ((EAnimationType)AniData.AniHeader.ani_type != EAnimationType::AniType_Bone)
+	{
+		PrintWarning(TEXT("Only bone animations can be imported as animation sequences: ") + AssetName);
+		return nullptr;
+	}
 
-	// AnimSeq->AdditiveAnimType = EAdditiveAnimationType::AAT_LocalSpaceBase;
+	check(Options.SampleRate > 0.f);
+	const float TicksPerSample = (float)TICKSPERSECOND / Options.SampleRate;
 
-	int32 NodeSize = AniData.AniNodes.Num();
-	for (int i = 0; i < NodeSize; i++)
+	// maxframe is in ticks, but isn't always set, so the last key of every track counts as well
+	int32 MaxTick = AniData.AniHeader.maxframe;
+	for (const TSharedPtr<FAniNode>& Node : AniData.AniNodes)
 	{
-		// FRawAnimSequenceTrack* AnimSequenceTrack;
-		// AnimSeq->AddKeyToSequence()
-		// AnimSeq->RawCurveData
-		// AnimSeq->
+		check(Node.IsValid());
+		MaxTick = FMath::Max(MaxTick, Node->PositionKeyTrack.Num() > 0 ? Node->PositionKeyTrack.Last().Frame : 0);
+		MaxTick = FMath::Max(MaxTick, Node->RotationKeyTrack.Num() > 0 ? Node->RotationKeyTrack.Last().Frame : 0);
+		MaxTick = FMath::Max(MaxTick, Node->ScaleKeyTrack.Num() > 0 ? Node->ScaleKeyTrack.Last().Frame : 0);
+	}
 
+	// Sequences need a non zero length, so even a single pose gets two frames
+	const int32 NumFrames = FMath::Max(FMath::FloorToInt(MaxTick / TicksPerSample) + 1, 2);
 
-		/*
-		TSharedPtr<FAniNode> Node = AniData.AniNodes[i];
-		check(Node.IsValid());
+	const bool bCreated = AnimSeq == nullptr;
+	if (bCreated)
+	{
+		// If package doesn't exist, it's safe to create new package
+		UPackage* Package = CreatePackage(*PackageTools::SanitizePackageName(PackageName));
+		Package->FullyLoad();
+
+		AnimSeq = NewObject<UAnimSequence>(Package, UAnimSequence::StaticClass(), *AssetName, EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
+	}
+	else
+	{
+		// Only the key data is rebuilt, notifies stay where they are
+		AnimSeq->Modify();
+		AnimSeq->CleanAnimSequenceForImport();
+	}
 
-		FString BoneName = Node->NodeName;
-		FString SanitizedBoneName = PackageTools::SanitizePackageName(BoneName);
+	AnimSeq->SetSkeleton(Skeleton);
+	AnimSeq->Interpolation = EAnimInterpolationType::Linear;
+	AnimSeq->SetRawNumberOfFrame(NumFrames);
+	AnimSeq->SequenceLength = (float)(NumFrames - 1) / Options.SampleRate;
+	AnimSeq->BoneCompressionSettings = Options.BoneCompressionSettings ? Options.BoneCompressionSettings : FAnimationUtils::GetDefaultAnimationBoneCompressionSettings();
 
-		FTransform BaseTransform = AniData.AniHeader.ver == EXPORTER_ANI_VER12 ? FTransform(Node->BaseRotation, Node->BaseTranslation, Node->BaseScale) : FTransform(Node->LocalMatrix);
-		AnimSeq->AddKeyToSequence(0.f, FName(*SanitizedBoneName), BaseTransform);
+	const FReferenceSkeleton& RefSkeleton = Skeleton->GetReferenceSkeleton();
+	const bool bHasBaseTransform = AniData.AniHeader.ver == EXPORTER_ANI_VER12;
 
-		FVector DefaultScale(1.f, 1.f, 1.f);
-		*/
+	int32 NumTracks = 0;
+	int32 NumRefPoseBones = 0;
+	int32 NumKeys = 0;
+	TArray<FString> MissingBones;
 
-		/*
-		for (const FVecKey& VecKey : Node->PositionKeyTrack)
+	FRawAnimSequenceTrack Track;
+	for (const TSharedPtr<FAniNode>& Node : AniData.AniNodes)
+	{
+		// Bones of skeletons imported through FBX have spaces replaced with underscores
+		FName BoneName = Node->NodeName;
+		int32 BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+		if (BoneIndex == INDEX_NONE)
 		{
-			FTransform Transform(FQuat(), VecKey.Key, DefaultScale);
-			float Frame = (float)VecKey.Frame / (float)TICKSPERFRAME;
-			
-			AnimSeq->AddKeyToSequence(Frame, FName(*SanitizedBoneName), Transform);
+			BoneName = FName(*Node->NodeName.ToString().Replace(TEXT(" "), TEXT("_")));
+			BoneIndex = RefSkeleton.FindBoneIndex(BoneName);
 		}
-		*/
 
-		/*
-		int32 PosNum = Node->PositionKeyTrack.Num();
-		int32 RotNum = Node->RotationKeyTrack.Num();
-		int32 ScaleNum = Node->ScaleKeyTrack.Num();
+		if (BoneIndex == INDEX_NONE)
+		{
+			MissingBones.Add(Node->NodeName.ToString());
+			continue;
+		}
 
-		FString Log = TEXT("Node name: ") + Node->NodeName + TEXT(", PosNum: ") + FString::FromInt(PosNum) + TEXT(", RotNum: ") + FString::FromInt(RotNum) + TEXT(", ScaleNum: ") + FString::FromInt(ScaleNum);
-		PrintWarning(Log);
-		*/
+		SampleAniNode(*Node, bHasBaseTransform, NumFrames, TicksPerSample, Track);
+		if (!ReduceRawTrack(Track, RefSkeleton.GetRefBonePose()[BoneIndex], Options))
+		{
+			NumRefPoseBones++;
+			continue;
+		}
+
+		NumKeys += Track.PosKeys.Num() + Track.RotKeys.Num() + Track.ScaleKeys.Num();
+		if (AnimSeq->AddNewRawTrack(BoneName, &Track) != INDEX_NONE)
+		{
+			NumTracks++;
+		}
+	}
+
+	if (MissingBones.Num() > 0)
+	{
+		PrintWarning(FString::Printf(TEXT("%s: %d animated nodes aren't in skeleton %s: %s"),
+			*AssetName, MissingBones.Num(), *Skeleton->GetName(), *FString::Join(MissingBones, TEXT(", "))));
 	}
 
+	// Fills in missing tracks, cleans up the raw data and compresses the sequence with its bone compression settings
+	AnimSeq->MarkRawDataAsModified();
+	AnimSeq->PostProcessSequence();
+
+	PrintLog(FString::Printf(TEXT("%s: %d frames, %d tracks (%d bones left at reference pose), %d raw keys, %d bytes raw, %d bytes compressed"),
+		*AssetName, NumFrames, NumTracks, NumRefPoseBones, NumKeys, AnimSeq->GetApproxRawSize(), AnimSeq->GetApproxCompressedSize()));
+
 	AnimSeq->MarkPackageDirty();
-	FAssetRegistryModule::AssetCreated(AnimSeq);
+	if (bCreated)
+	{
+		FAssetRegistryModule::AssetCreated(AnimSeq);
+	}
+
+	return AnimSeq;
+}
+
+/** Returns the index of the last key at or before Tick, starting the search at Cursor. Keys are sorted by frame, and samples are taken in order, so the search only moves forward */
+template<typename KeyType>
+static int32 AdvanceKeyCursor(const TArray<KeyType>& Keys, float Tick, int32 Cursor)
+{
+	while (Cursor + 1 < Keys.Num() && Keys[Cursor + 1].Frame <= Tick)
+	{
+		++Cursor;
+	}
+	return Cursor;
+}
+
+/** Returns how far Tick is between the key at Cursor and the next one */
+template<typename KeyType>
+static float GetKeyAlpha(const TArray<KeyType>& Keys, float Tick, int32 Cursor)
+{
+	if (Cursor + 1 >= Keys.Num() || Tick <= Keys[Cursor].Frame)
+	{
+		return 0.f;
+	}
+
+	const float FrameDelta = (float)(Keys[Cursor + 1].Frame - Keys[Cursor].Frame);
+	return FrameDelta > 0.f ? FMath::Clamp((Tick - Keys[Cursor].Frame) / FrameDelta, 0.f, 1.f) : 0.f;
+}
+
+void UEluImporter::SampleAniNode(const FAniNode& Node, bool bHasBaseTransform, int32 NumFrames, float TicksPerSample, FRawAnimSequenceTrack& OutTrack)
+{
+	// Components without any keys hold the node's rest transform
+	const FTransform RestTransform = bHasBaseTransform ? FTransform(Node.BaseRotation, Node.BaseTranslation, Node.BaseScale) : FTransform(Node.LocalMatrix);
+
+	OutTrack.PosKeys.Reset(NumFrames);
+	OutTrack.RotKeys.Reset(NumFrames);
+	OutTrack.ScaleKeys.Reset(NumFrames);
+
+	int32 PosCursor = 0;
+	int32 RotCursor = 0;
+	int32 ScaleCursor = 0;
+	for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+	{
+		const float Tick = FrameIndex * TicksPerSample;
+
+		FVector Position = RestTransform.GetTranslation();
+		if (Node.PositionKeyTrack.Num() > 0)
+		{
+			PosCursor = AdvanceKeyCursor(Node.PositionKeyTrack, Tick, PosCursor);
+			const float Alpha = GetKeyAlpha(Node.PositionKeyTrack, Tick, PosCursor);
+			const int32 NextCursor = FMath::Min(PosCursor + 1, Node.PositionKeyTrack.Num() - 1);
+			Position = FMath::Lerp(Node.PositionKeyTrack[PosCursor].Key, Node.PositionKeyTrack[NextCursor].Key, Alpha);
+		}
+		OutTrack.PosKeys.Add(Position);
+
+		FQuat Rotation = RestTransform.GetRotation();
+		if (Node.RotationKeyTrack.Num() > 0)
+		{
+			RotCursor = AdvanceKeyCursor(Node.RotationKeyTrack, Tick, RotCursor);
+			const float Alpha = GetKeyAlpha(Node.RotationKeyTrack, Tick, RotCursor);
+			const int32 NextCursor = FMath::Min(RotCursor + 1, Node.RotationKeyTrack.Num() - 1);
+			Rotation = FQuat::Slerp(Node.RotationKeyTrack[RotCursor].Quat, Node.RotationKeyTrack[NextCursor].Quat, Alpha);
+		}
+		Rotation.Normalize();
+
+		// Keep neighbouring samples in the same hemisphere so that interpolating between them takes the short way around
+		if (OutTrack.RotKeys.Num() > 0 && (OutTrack.RotKeys.Last() | Rotation) < 0.f)
+		{
+			Rotation = FQuat(-Rotation.X, -Rotation.Y, -Rotation.Z, -Rotation.W);
+		}
+		OutTrack.RotKeys.Add(Rotation);
+
+		FVector Scale = RestTransform.GetScale3D();
+		if (Node.ScaleKeyTrack.Num() > 0)
+		{
+			ScaleCursor = AdvanceKeyCursor(Node.ScaleKeyTrack, Tick, ScaleCursor);
+			const float Alpha = GetKeyAlpha(Node.ScaleKeyTrack, Tick, ScaleCursor);
+			const int32 NextCursor = FMath::Min(ScaleCursor + 1, Node.ScaleKeyTrack.Num() - 1);
+			Scale = FMath::Lerp(Node.ScaleKeyTrack[ScaleCursor].Key, Node.ScaleKeyTrack[NextCursor].Key, Alpha);
+		}
+		OutTrack.ScaleKeys.Add(Scale);
+	}
+}
+
+bool UEluImporter::ReduceRawTrack(FRawAnimSequenceTrack& Track, const FTransform& RefPose, const FEluAnimationImportOptions& Options)
+{
+	// Raw tracks either have a key for every frame or a single key, so the in between keys are left for the compression codec to remove
+	const FVector FirstPosition = Track.PosKeys[0];
+	if (!Track.PosKeys.ContainsByPredicate([&](const FVector& Key) { return FVector::Dist(Key, FirstPosition) > Options.PositionTolerance; }))
+	{
+		Track.PosKeys.SetNum(1);
+	}
+
+	const FQuat FirstRotation = Track.RotKeys[0];
+	if (!Track.RotKeys.ContainsByPredicate([&](const FQuat& Key) { return Key.AngularDistance(FirstRotation) > Options.RotationTolerance; }))
+	{
+		Track.RotKeys.SetNum(1);
+	}
+
+	const FVector FirstScale = Track.ScaleKeys[0];
+	if (!Track.ScaleKeys.ContainsByPredicate([&](const FVector& Key) { return FVector::Dist(Key, FirstScale) > Options.ScaleTolerance; }))
+	{
+		Track.ScaleKeys.SetNum(1);
+	}
+
+	const bool bAtRefPose =
+		Track.PosKeys.Num() == 1 && FVector::Dist(FirstPosition, RefPose.GetTranslation()) <= Options.PositionTolerance &&
+		Track.RotKeys.Num() == 1 && FirstRotation.AngularDistance(RefPose.GetRotation()) <= Options.RotationTolerance &&
+		Track.ScaleKeys.Num() == 1 && FVector::Dist(FirstScale, RefPose.GetScale3D()) <= Options.ScaleTolerance;
+
+	return !bAtRefPose;
 }
 
 bool UEluImporter::PickEluFile(FString& OutFilePath)
@@ -189,17 +396,25 @@ FEluFileData UEluImporter::LoadEluData(const FString& EluFilePath)
 {
 	FEluFileData EluData;
 
-	TArray<uint8> BinaryData;
-	bool bSuccess = FFileHelper::LoadFileToArray(BinaryData, *EluFilePath);
-	if (!bSuccess)
+	FRaiderzBinaryReader Reader;
+	if (!Reader.OpenFile(EluFilePath))
 	{
 		EluData.bLoadSuccess = false;
 		return EluData;
 	}
 
-	UINT Offset = 0;
+	const FString CacheKey = FEluMeshCache::GetCacheKey(Reader.GetData(), Reader.GetSize());
+	if (FEluMeshCache::Load(CacheKey, EluData))
+	{
+		return EluData;
+	}
+
 	FEluHeader EluHeader;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&EluHeader, sizeof(EluHeader), BinaryData, Offset);
+	if (!Reader.Read(EluHeader))
+	{
+		EluData.bLoadSuccess = false;
+		return EluData;
+	}
 
 	if (EluHeader.Signature != EXPORTER_SIG)
 	{
@@ -280,8 +495,13 @@ FEluFileData UEluImporter::LoadEluData(const FString& EluFilePath)
 	for (int i = 0; i < EluHeader.MeshNum; i++)
 	{
 		TSharedPtr<FEluMeshNode> EluMeshNode(new FEluMeshNode());
-		bool bLoadSuccessful = EluMeshNodeLoader->Load(EluMeshNode, BinaryData, Offset);
-		check(bLoadSuccessful);
+		bool bLoadSuccessful = EluMeshNodeLoader->Load(EluMeshNode, Reader);
+		if (!bLoadSuccessful)
+		{
+			PrintError(TEXT("Failed to load mesh node ") + FString::FromInt(i) + TEXT(" of elu file: ") + FPaths::GetCleanFilename(EluFilePath));
+			EluData.bLoadSuccess = false;
+			return EluData;
+		}
 		EluMeshNodes.Add(EluMeshNode);
 	}
 
@@ -289,6 +509,8 @@ FEluFileData UEluImporter::LoadEluData(const FString& EluFilePath)
 	EluData.EluHeader = EluHeader;
 	EluData.EluMeshNodes = EluMeshNodes;
 
+	FEluMeshCache::Save(CacheKey, EluData);
+
 	return EluData;
 }
 
@@ -296,17 +518,19 @@ FAniFileData UEluImporter::LoadAniData(const FString& AniFilePath)
 {
 	FAniFileData AniData;
 
-	TArray<uint8> BinaryData;
-	bool bSuccess = FFileHelper::LoadFileToArray(BinaryData, *AniFilePath);
-	if (!bSuccess)
+	FRaiderzBinaryReader Reader;
+	if (!Reader.OpenFile(AniFilePath))
 	{
 		AniData.bLoadSuccess = false;
 		return AniData;
 	}
 
-	UINT Offset = 0;
 	FAniHeader AniHeader;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AniHeader, sizeof(AniHeader), BinaryData, Offset);
+	if (!Reader.Read(AniHeader))
+	{
+		AniData.bLoadSuccess = false;
+		return AniData;
+	}
 
 	int AniNodeCount = AniHeader.model_num;
 	EAnimationType AniType = (EAnimationType)AniHeader.ani_type;
@@ -349,6 +573,13 @@ FAniFileData UEluImporter::LoadAniData(const FString& AniFilePath)
 		return AniData;
 	}
 
+	if (!AnimNodeLoader)
+	{
+		PrintError(TEXT("Animation file version ") + FString::FromInt(AniHeader.ver) + TEXT(" is not supported: ") + FPaths::GetCleanFilename(AniFilePath));
+		AniData.bLoadSuccess = false;
+		return AniData;
+	}
+
 	TArray<TSharedPtr<FAniNode>> AniNodes;
 	for (int i = 0; i < AniHeader.model_num; i++)
 	{
@@ -358,10 +589,10 @@ FAniFileData UEluImporter::LoadAniData(const FString& AniFilePath)
 		switch ((EAnimationType)AniHeader.ani_type)
 		{
 		case EAnimationType::AniType_Vertex:
-			bLoadSuccessful = AnimNodeLoader->LoadVertexAni(AniNode, BinaryData, Offset, AniHeader.ver);
+			bLoadSuccessful = AnimNodeLoader->LoadVertexAni(AniNode, Reader, AniHeader.ver);
 			break;
 		case EAnimationType::AniType_Bone:
-			bLoadSuccessful = AnimNodeLoader->LoadBoneAni(AniNode, BinaryData, Offset, AniHeader.ver);
+			bLoadSuccessful = AnimNodeLoader->LoadBoneAni(AniNode, Reader, AniHeader.ver);
 			break;
 		case EAnimationType::AniType_TransForm:
 		case EAnimationType::AniType_Tm:
@@ -371,9 +602,17 @@ FAniFileData UEluImporter::LoadAniData(const FString& AniFilePath)
 			return AniData;
 			break;
 		}
-		check(bLoadSuccessful);
-		bLoadSuccessful = AnimNodeLoader->LoadVisibilityKey(AniNode, BinaryData, Offset, AniHeader.ver);
-		check(bLoadSuccessful);
+		if (bLoadSuccessful)
+		{
+			bLoadSuccessful = AnimNodeLoader->LoadVisibilityKey(AniNode, Reader, AniHeader.ver);
+		}
+
+		if (!bLoadSuccessful)
+		{
+			PrintError(TEXT("Failed to load animation node ") + FString::FromInt(i) + TEXT(" of ani file: ") + FPaths::GetCleanFilename(AniFilePath));
+			AniData.bLoadSuccess = false;
+			return AniData;
+		}
 		AniNodes.Add(AniNode);
 	}
 
@@ -390,14 +629,57 @@ FAniFileData UEluImporter::LoadAniData(const FString& AniFilePath)
 	return AniData;
 }
 
-bool UEluImporter::ImportEluStaticMesh_Internal(const FString& EluFilePath)
+float FEluStaticMeshImportOptions::GetLODScreenSize(int32 LODIndex) const
 {
-	FEluFileData EluData = LoadEluData(EluFilePath);
-	if (!EluData.bLoadSuccess)
+	if (LODScreenSizes.IsValidIndex(LODIndex))
 	{
-		return false;
+		return LODScreenSizes[LODIndex];
 	}
 
+	const float LastScreenSize = LODScreenSizes.Num() > 0 ? LODScreenSizes.Last() : 1.f;
+	return LastScreenSize * FMath::Pow(0.5f, (float)(LODIndex - LODScreenSizes.Num() + 1));
+}
+
+uint32 FEluStaticMeshImportOptions::GetSettingsHash() const
+{
+	uint32 Hash = HashCombine(GetTypeHash(bImportLODs), GetTypeHash(bImportSimpleCollision));
+	for (float ScreenSize : LODScreenSizes)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(ScreenSize));
+	}
+	return Hash;
+}
+
+uint32 FEluAnimationImportOptions::GetSettingsHash() const
+{
+	uint32 Hash = GetTypeHash(SampleRate);
+	Hash = HashCombine(Hash, GetTypeHash(PositionTolerance));
+	Hash = HashCombine(Hash, GetTypeHash(RotationTolerance));
+	Hash = HashCombine(Hash, GetTypeHash(ScaleTolerance));
+
+	// By path rather than by pointer, since the hash is compared across editor sessions
+	Hash = HashCombine(Hash, GetTypeHash(BoneCompressionSettings ? BoneCompressionSettings->GetPathName() : FString()));
+	return Hash;
+}
+
+/** Whether the node only exists for collision */
+static bool IsCollisionNode(const FEluMeshNode& MeshNode)
+{
+	return (MeshNode.dwFlag & (RM_FLAG_COLLISION_MESH | RM_FLAG_COLLISION_MESHONLY)) != 0;
+}
+
+/** Whether the node has render geometry, as opposed to dummies, helpers, collision and hidden nodes */
+static bool IsStaticMeshRenderNode(const FEluMeshNode& MeshNode)
+{
+	return !IsCollisionNode(MeshNode) && !MeshNode.NodeName.ToString().Contains(TEXT("hide")) && MeshNode.PointsTable.Num() > 0;
+}
+
+UStaticMesh* UEluImporter::CreateStaticMesh(
+	const FEluFileData& EluData,
+	const FString& PackageName,
+	const FString& AssetName,
+	const FEluStaticMeshImportOptions& Options)
+{
 	const TArray<TSharedPtr<FEluMeshNode>>& EluMeshNodes = EluData.EluMeshNodes;
 
 	/*
@@ -413,124 +695,468 @@ bool UEluImporter::ImportEluStaticMesh_Internal(const FString& EluFilePath)
 	}
 	*/
 
-	FString PackageName = FString("/Game/RaiderZ/Zunk/WAKA");
-	bool bPackageExists = FPackageName::DoesPackageExist(PackageName);
+	UStaticMesh* StaticMesh = nullptr;
+	if (EluMeshNodes.Num() == 0 || !GetAssetToReplace(PackageName, AssetName, Options.bReplaceExisting, StaticMesh))
+	{
+		return nullptr;
+	}
 
-	// If package doesn't exist, it's safe to create new package
-	PackageName = PackageTools::SanitizePackageName(PackageName);
-	UPackage* Package = CreatePackage(*PackageName);
-	Package->FullyLoad();
+	// RaiderZ LOD levels present in the file, from the most detailed one to the least
+	TArray<int32> LODProjectIndices;
+	for (const TSharedPtr<FEluMeshNode>& MeshNode : EluMeshNodes)
+	{
+		check(MeshNode.IsValid());
+		if (IsStaticMeshRenderNode(*MeshNode))
+		{
+			LODProjectIndices.AddUnique(MeshNode->LODProjectIndex);
+		}
+	}
+	LODProjectIndices.Sort();
+
+	if (LODProjectIndices.Num() == 0)
+	{
+		LODProjectIndices.Add(0);
+	}
+
+	const int32 MaxLODs = Options.bImportLODs ? MAX_STATIC_MESH_LODS : 1;
+	if (LODProjectIndices.Num() > MaxLODs)
+	{
+		if (Options.bImportLODs)
+		{
+			PrintWarning(FString::Printf(TEXT("%s has %d LOD levels, only the first %d are imported"), *AssetName, LODProjectIndices.Num(), MaxLODs));
+		}
+		LODProjectIndices.SetNum(MaxLODs);
+	}
 
-	if (!bPackageExists && EluMeshNodes.Num() != 0)
+	const bool bCreated = StaticMesh == nullptr;
+	if (bCreated)
 	{
-		UStaticMesh* StaticMesh = NewObject<UStaticMesh>(Package, UStaticMesh::StaticClass(), *FString("WAKA"), EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
-		StaticMesh->AddSourceModel();
-		StaticMesh->LightingGuid = FGuid::NewGuid();
-		StaticMesh->LightMapCoordinateIndex = 1;
-		StaticMesh->LightMapResolution = 64;
+		// If package doesn't exist, it's safe to create new package
+		UPackage* Package = CreatePackage(*PackageTools::SanitizePackageName(PackageName));
+		Package->FullyLoad();
+
+		StaticMesh = NewObject<UStaticMesh>(Package, UStaticMesh::StaticClass(), *AssetName, EObjectFlags::RF_Public | EObjectFlags::RF_Standalone);
+	}
+	else
+	{
+		// Rebuilt from scratch. Only the object itself is kept, so that whatever references it keeps working
+		StaticMesh->Modify();
+		StaticMesh->SetNumSourceModels(0);
+		if (StaticMesh->BodySetup)
+		{
+			StaticMesh->BodySetup->RemoveSimpleCollision();
+			StaticMesh->BodySetup->CollisionTraceFlag = CTF_UseDefault;
+			StaticMesh->BodySetup->WalkableSlopeOverride = FWalkableSlopeOverride();
+		}
+	}
+
+	StaticMesh->LightingGuid = FGuid::NewGuid();
+	StaticMesh->LightMapCoordinateIndex = 1;
+	StaticMesh->LightMapResolution = 64;
 
+	for (int32 LODProjectIndex : LODProjectIndices)
+	{
 		FRawMesh RawMesh;
-		int32 PointsOffset = 0;
+		BuildStaticMeshLOD(EluMeshNodes, LODProjectIndex, RawMesh);
 
-		int32 NodeNum = EluMeshNodes.Num();
-		for (int i = 0; i < NodeNum; i++)
+		// LOD levels whose nodes are all dummies would make the build fail
+		const int32 LODIndex = StaticMesh->GetNumSourceModels();
+		if (LODIndex > 0 && RawMesh.FaceMaterialIndices.Num() == 0)
 		{
-			TSharedPtr<FEluMeshNode> MeshNode = EluMeshNodes[i];
-			check(MeshNode.IsValid());
+			PrintWarning(FString::Printf(TEXT("Skipping LOD level %d of %s, it has no faces"), LODProjectIndex, *AssetName));
+			continue;
+		}
+
+		FEluMeshOptimizer::OptimizeRawMesh(RawMesh, FString::Printf(TEXT("%s LOD %d"), *AssetName, LODIndex));
+
+		FStaticMeshSourceModel& SourceModel = StaticMesh->AddSourceModel();
+		SourceModel.ScreenSize.Default = Options.GetLODScreenSize(LODIndex);
+		SourceModel.SaveRawMesh(RawMesh);
+	}
+	StaticMesh->bAutoComputeLODScreenSize = StaticMesh->GetNumSourceModels() == 1;
+
+	TArray<FText> ErrorText;
+	StaticMesh->Build(false, &ErrorText);
+
+	if (Options.bImportSimpleCollision)
+	{
+		StaticMesh->CreateBodySetup();
+		UBodySetup* BodySetup = StaticMesh->BodySetup;
+		bool bSimpleCollisionIsExact = false;
+		if (BuildSimpleCollision(EluMeshNodes, BodySetup, bSimpleCollisionIsExact) > 0)
+		{
+			// Traces run against the few collision shapes instead of every render triangle, but only if those shapes
+			// match the collision nodes. Decomposed concave nodes are approximations, so complex traces keep the render mesh
+			BodySetup->CollisionTraceFlag = bSimpleCollisionIsExact ? CTF_UseSimpleAsComplex : CTF_UseDefault;
+			BodySetup->InvalidatePhysicsData();
+			BodySetup->CreatePhysicsMeshes();
+		}
+	}
+
+	StaticMesh->MarkPackageDirty();
+	if (bCreated)
+	{
+		FAssetRegistryModule::AssetCreated(StaticMesh);
+	}
+
+	return StaticMesh;
+}
+
+int32 UEluImporter::BuildSimpleCollision(const TArray<TSharedPtr<FEluMeshNode>>& EluMeshNodes, UBodySetup* BodySetup, bool& bOutIsExact)
+{
+	check(BodySetup);
 
-			if (MeshNode->LODProjectIndex != 0 || MeshNode->NodeName.Contains("hide") || MeshNode->PointsTable.Num() == 0)
+	// Flat nodes, like floors and walls, are given this thickness (cm) since a convex hull needs volume
+	static const float MinCollisionThickness = 1.f;
+
+	// Concave nodes are split into at most this many hulls of at most this many vertices each
+	static const uint32 MaxHullsPerConcaveNode = 8;
+	static const int32 MaxVerticesPerHull = 16;
+
+	FKAggregateGeom& AggGeom = BodySetup->AggGeom;
+	AggGeom.EmptyElements();
+	bOutIsExact = true;
+
+	int32 NumNotWalkable = 0;
+	int32 NumApproximatedNodes = 0;
+	for (const TSharedPtr<FEluMeshNode>& MeshNode : EluMeshNodes)
+	{
+		check(MeshNode.IsValid());
+		if (!IsCollisionNode(*MeshNode) || MeshNode->PointsTable.Num() == 0)
+		{
+			continue;
+		}
+
+		// There's no per shape physical material, so what the node is meant for is kept in the shape name
+		FString ShapeName = MeshNode->NodeName.ToString();
+		if (MeshNode->dwFlag & RM_FLAG_NOTWALKABLE)
+		{
+			ShapeName += TEXT("_NotWalkable");
+			NumNotWalkable++;
+		}
+		if (MeshNode->dwFlag & (RM_FLAG_PASSTHROUGH | RM_FLAG_PASSBULLET | RM_FLAG_PASSROCKET))
+		{
+			ShapeName += TEXT("_PassProjectiles");
+		}
+
+		const FBox LocalBounds(MeshNode->PointsTable);
+		const FVector LocalSize = LocalBounds.GetSize();
+		const FVector Tolerance = FVector(KINDA_SMALL_NUMBER) + LocalSize * 0.001f;
+
+		int32 ThinAxis = 0;
+		for (int32 Axis = 1; Axis < 3; ++Axis)
+		{
+			ThinAxis = LocalSize[Axis] < LocalSize[ThinAxis] ? Axis : ThinAxis;
+		}
+		const bool bIsFlat = LocalSize[ThinAxis] < MinCollisionThickness;
+
+		// Flat nodes only need to be rectangles, whatever their slight thickness
+		FVector CornerTolerance = Tolerance;
+		if (bIsFlat)
+		{
+			CornerTolerance[ThinAxis] = LocalSize[ThinAxis] + KINDA_SMALL_NUMBER;
+		}
+		const bool bIsBox = HasAllBoxCorners(MeshNode->PointsTable, LocalBounds, CornerTolerance) && (bIsFlat || IsConvexNode(*MeshNode, Tolerance.GetMax()));
+
+		if (bIsBox)
+		{
+			// Flat rectangles are thickened, so their box is slightly larger than the node
+			if (bIsFlat)
 			{
-				continue;
+				NumApproximatedNodes++;
+				bOutIsExact = false;
 			}
 
-			FString LogMessage = TEXT("Processing node: ") + MeshNode->NodeName;
-			PrintWarning(LogMessage);
-			// LogMessage = TEXT("Local matrix: \n") + MeshNode->LocalMatrix.ToString();
-			// PrintWarning(LogMessage);
+			const FTransform NodeTransform(MeshNode->LocalMatrix);
+			const FVector Scale = NodeTransform.GetScale3D().GetAbs();
+
+			FKBoxElem Box;
+			Box.Center = NodeTransform.TransformPosition(LocalBounds.GetCenter());
+			Box.Rotation = NodeTransform.Rotator();
+			Box.X = FMath::Max(LocalSize.X * Scale.X, MinCollisionThickness);
+			Box.Y = FMath::Max(LocalSize.Y * Scale.Y, MinCollisionThickness);
+			Box.Z = FMath::Max(LocalSize.Z * Scale.Z, MinCollisionThickness);
+			Box.SetName(FName(*ShapeName));
+			AggGeom.BoxElems.Add(Box);
+		}
+		else if (bIsFlat)
+		{
+			// Other flat nodes are extruded into a slab, since a hull of coplanar points has no volume.
+			// The slab is thicker than the node and covers the whole outline even if the outline is concave
+			const float SlabCenter = LocalBounds.GetCenter()[ThinAxis];
+			FKConvexElem Convex;
+			Convex.VertexData.Reserve(MeshNode->PointsTable.Num() * 2);
+			TSet<FVector> UniquePoints;
+			UniquePoints.Reserve(MeshNode->PointsTable.Num() * 2);
+			for (const FVector& Point : MeshNode->PointsTable)
+			{
+				for (const float Offset : { -0.5f * MinCollisionThickness, 0.5f * MinCollisionThickness })
+				{
+					FVector SlabPoint = Point;
+					SlabPoint[ThinAxis] = SlabCenter + Offset;
 
-			PointsOffset = RawMesh.VertexPositions.Num();
-			// RawMesh.VertexPositions += MeshNode->PointsTable;
+					bool bIsAlreadyInSet = false;
+					UniquePoints.Add(SlabPoint, &bIsAlreadyInSet);
+					if (!bIsAlreadyInSet)
+					{
+						Convex.VertexData.Add(MeshNode->LocalMatrix.TransformPosition(SlabPoint));
+					}
+				}
+			}
+			Convex.UpdateElemBox();
+			Convex.SetName(FName(*ShapeName));
+			AggGeom.ConvexElems.Add(Convex);
 
+			NumApproximatedNodes++;
+			bOutIsExact = false;
+		}
+		else if (IsConvexNode(*MeshNode, Tolerance.GetMax()))
+		{
+			FKConvexElem Convex;
+			Convex.VertexData.Reserve(MeshNode->PointsTable.Num());
+			TSet<FVector> UniquePoints;
+			UniquePoints.Reserve(MeshNode->PointsTable.Num());
 			for (const FVector& Point : MeshNode->PointsTable)
 			{
-				const FVector& TransformedPoint = MeshNode->LocalMatrix.TransformPosition(Point);
-				RawMesh.VertexPositions.Add(TransformedPoint);
+				bool bIsAlreadyInSet = false;
+				UniquePoints.Add(Point, &bIsAlreadyInSet);
+				if (!bIsAlreadyInSet)
+				{
+					Convex.VertexData.Add(MeshNode->LocalMatrix.TransformPosition(Point));
+				}
+			}
+			Convex.UpdateElemBox();
+			Convex.SetName(FName(*ShapeName));
+			AggGeom.ConvexElems.Add(Convex);
+		}
+		else
+		{
+			// The hull of a concave node would fill in its hollows, e.g. close off the inside of an arch
+			TArray<FVector> Vertices;
+			Vertices.Reserve(MeshNode->PointsTable.Num());
+			for (const FVector& Point : MeshNode->PointsTable)
+			{
+				Vertices.Add(MeshNode->LocalMatrix.TransformPosition(Point));
 			}
 
-			int32 PolyNum = MeshNode->PolygonTable.Num();
-			for (int j = PolyNum - 1; j >= 0; j--)
+			TArray<uint32> Indices;
+			for (const FMeshPolygonData& PolyData : MeshNode->PolygonTable)
 			{
-				const FMeshPolygonData& PolyData = MeshNode->PolygonTable[j];
+				const TArrayView<const FFaceSubData> SubDatas = MeshNode->GetPolygonSubDatas(PolyData);
+				for (int32 Index = 2; Index < SubDatas.Num(); ++Index)
+				{
+					if (Vertices.IsValidIndex(SubDatas[0].p) && Vertices.IsValidIndex(SubDatas[Index - 1].p) && Vertices.IsValidIndex(SubDatas[Index].p))
+					{
+						Indices.Add(SubDatas[0].p);
+						Indices.Add(SubDatas[Index - 1].p);
+						Indices.Add(SubDatas[Index].p);
+					}
+				}
+			}
 
-				RawMesh.FaceMaterialIndices.Add(PolyData.MaterialID);
-				RawMesh.FaceSmoothingMasks.Add(1);
+			UBodySetup* DecomposedBodySetup = NewObject<UBodySetup>(GetTransientPackage());
+			if (Indices.Num() > 0)
+			{
+				DecomposeMeshToHulls(DecomposedBodySetup, Vertices, Indices, MaxHullsPerConcaveNode, MaxVerticesPerHull);
+			}
 
-				int32 SubNum = PolyData.FaceSubDatas.Num();
-				for (int k = SubNum - 1; k >= 0; k--)
-				{
-					const FFaceSubData& FaceData = PolyData.FaceSubDatas[k];
+			if (DecomposedBodySetup->AggGeom.ConvexElems.Num() == 0)
+			{
+				PrintWarning(FString::Printf(TEXT("Failed to decompose concave collision node %s, it will have no simple collision"), *MeshNode->NodeName.ToString()));
+			}
+			for (FKConvexElem& Convex : DecomposedBodySetup->AggGeom.ConvexElems)
+			{
+				Convex.SetName(FName(*ShapeName));
+				AggGeom.ConvexElems.Add(Convex);
+			}
 
-					RawMesh.WedgeIndices.Add(PointsOffset + FaceData.p);
+			NumApproximatedNodes++;
+			bOutIsExact = false;
+		}
+	}
 
-					if (MeshNode->TangentTanTable.Num() > FaceData.n_tan)
-					{
-						const FVector& Tangent_X = MeshNode->TangentTanTable[FaceData.n_tan];
-						RawMesh.WedgeTangentX.Add(Tangent_X);
-					}
-					else
-					{
-						RawMesh.WedgeTangentX.Add(FVector::ZeroVector);
-					}
+	// Walkability can only be overridden for the whole body
+	const int32 NumShapes = AggGeom.GetElementCount();
+	if (NumShapes > 0 && NumNotWalkable == NumShapes)
+	{
+		BodySetup->WalkableSlopeOverride = FWalkableSlopeOverride(WalkableSlope_Unwalkable, 0.f);
+	}
 
+	PrintLog(FString::Printf(TEXT("Built %d box and %d convex collision shapes, %d flat or concave nodes were approximated"), AggGeom.BoxElems.Num(), AggGeom.ConvexElems.Num(), NumApproximatedNodes));
+	return NumShapes;
+}
 
-					if (MeshNode->TangentBinTable.Num() > FaceData.n_bin)
-					{
-						const FVector& Tangent_Y = MeshNode->TangentBinTable[FaceData.n_bin];
-						RawMesh.WedgeTangentY.Add(Tangent_Y);
-					}
-					else
-					{
-						RawMesh.WedgeTangentY.Add(FVector::ZeroVector);
-					}
+bool UEluImporter::HasAllBoxCorners(const TArray<FVector>& Points, const FBox& Bounds, const FVector& Tolerance)
+{
+	// Wedges, ramps and tetrahedra also have all of their points on the planes of their bounds, but miss some of the corners
+	uint8 FoundCorners = 0;
+	for (const FVector& Point : Points)
+	{
+		bool bIsOnBoundsPlanes = true;
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			const FVector CornerPoint((Corner & 1) ? Bounds.Max.X : Bounds.Min.X, (Corner & 2) ? Bounds.Max.Y : Bounds.Min.Y, (Corner & 4) ? Bounds.Max.Z : Bounds.Min.Z);
+			const FVector Distance = (Point - CornerPoint).GetAbs();
+			if (Distance.X <= Tolerance.X && Distance.Y <= Tolerance.Y && Distance.Z <= Tolerance.Z)
+			{
+				FoundCorners |= 1 << Corner;
+			}
+		}
 
-					if (MeshNode->NormalsTable.Num() > FaceData.n)
-					{
-						const FVector& Normal = MeshNode->NormalsTable[FaceData.n];
-						RawMesh.WedgeTangentZ.Add(Normal);
-					}
-					else
-					{
-						RawMesh.WedgeTangentZ.Add(FVector::ZeroVector);
-					}
+		for (int32 Axis = 0; Axis < 3 && bIsOnBoundsPlanes; ++Axis)
+		{
+			bIsOnBoundsPlanes = FMath::Abs(Point[Axis] - Bounds.Min[Axis]) <= Tolerance[Axis] || FMath::Abs(Point[Axis] - Bounds.Max[Axis]) <= Tolerance[Axis];
+		}
+		if (!bIsOnBoundsPlanes)
+		{
+			return false;
+		}
+	}
 
-					RawMesh.WedgeColors.Add(FColor(0, 0, 0));
+	return FoundCorners == 0xFF;
+}
 
-					if (MeshNode->TexCoordTable.Num() > FaceData.uv)
-					{
-						FVector TexCoord = MeshNode->TexCoordTable[FaceData.uv];
-						RawMesh.WedgeTexCoords[0].Add(FVector2D(TexCoord.X, TexCoord.Y));
-						RawMesh.WedgeTexCoords[1].Add(FVector2D(0, 0));
-					}
-					else
-					{
-						RawMesh.WedgeTexCoords[0].Add(FVector2D(0, 0));
-						RawMesh.WedgeTexCoords[1].Add(FVector2D(0, 0));
-					}
+bool UEluImporter::IsConvexNode(const FEluMeshNode& MeshNode, float Tolerance)
+{
+	// A shape is convex if none of its points lie in front of the plane of any of its faces.
+	// The winding of collision nodes isn't reliable, so the points only have to be on the same side of every plane
+	for (const FMeshPolygonData& PolyData : MeshNode.PolygonTable)
+	{
+		const TArrayView<const FFaceSubData> SubDatas = MeshNode.GetPolygonSubDatas(PolyData);
+		if (SubDatas.Num() < 3 || !MeshNode.PointsTable.IsValidIndex(SubDatas[0].p) ||
+			!MeshNode.PointsTable.IsValidIndex(SubDatas[1].p) || !MeshNode.PointsTable.IsValidIndex(SubDatas[2].p))
+		{
+			continue;
+		}
 
+		const FVector& A = MeshNode.PointsTable[SubDatas[0].p];
+		const FVector& B = MeshNode.PointsTable[SubDatas[1].p];
+		const FVector& C = MeshNode.PointsTable[SubDatas[2].p];
+		const FVector Normal = ((B - A) ^ (C - A)).GetSafeNormal();
+		if (Normal.IsZero())
+		{
+			continue;
+		}
 
-					// if (MeshNode->PointColorTable.Num() > FaceData.)
+		bool bHasPointInFront = false;
+		bool bHasPointBehind = false;
+		for (const FVector& Point : MeshNode.PointsTable)
+		{
+			const float Distance = (Point - A) | Normal;
+			bHasPointInFront |= Distance > Tolerance;
+			bHasPointBehind |= Distance < -Tolerance;
+			if (bHasPointInFront && bHasPointBehind)
+			{
+				return false;
+			}
+		}
+	}
 
-				}
+	return true;
+}
+
+void UEluImporter::BuildStaticMeshLOD(const TArray<TSharedPtr<FEluMeshNode>>& EluMeshNodes, int32 LODProjectIndex, FRawMesh& OutRawMesh)
+{
+	// Size every stream up front. Polygons of higher degree are split into fans, so each one adds Vertices - 2 triangles
+	int32 NumPoints = 0;
+	int32 NumTriangles = 0;
+	for (const TSharedPtr<FEluMeshNode>& MeshNode : EluMeshNodes)
+	{
+		check(MeshNode.IsValid());
+		if (MeshNode->LODProjectIndex == LODProjectIndex && IsStaticMeshRenderNode(*MeshNode))
+		{
+			NumPoints += MeshNode->PointsTable.Num();
+			for (const FMeshPolygonData& PolyData : MeshNode->PolygonTable)
+			{
+				NumTriangles += FMath::Max(PolyData.Vertices - 2, 0);
 			}
 		}
+	}
 
-		StaticMesh->GetSourceModels()[0].SaveRawMesh(RawMesh);
+	const int32 NumWedges = NumTriangles * 3;
 
-		TArray<FText> ErrorText;
-		StaticMesh->Build(false, &ErrorText);
-		StaticMesh->MarkPackageDirty();
-		FAssetRegistryModule::AssetCreated(StaticMesh);
+	OutRawMesh.VertexPositions.Reserve(NumPoints);
+	OutRawMesh.FaceMaterialIndices.Reserve(NumTriangles);
+	OutRawMesh.FaceSmoothingMasks.Reserve(NumTriangles);
+	OutRawMesh.WedgeIndices.Reserve(NumWedges);
+	OutRawMesh.WedgeTangentX.Reserve(NumWedges);
+	OutRawMesh.WedgeTangentY.Reserve(NumWedges);
+	OutRawMesh.WedgeTangentZ.Reserve(NumWedges);
+	OutRawMesh.WedgeColors.Reserve(NumWedges);
+	OutRawMesh.WedgeTexCoords[0].Reserve(NumWedges);
+	OutRawMesh.WedgeTexCoords[1].Reserve(NumWedges);
+
+	int32 PointsOffset = 0;
+
+	int32 NodeNum = EluMeshNodes.Num();
+	for (int i = 0; i < NodeNum; i++)
+	{
+		TSharedPtr<FEluMeshNode> MeshNode = EluMeshNodes[i];
+		check(MeshNode.IsValid());
+
+		if (MeshNode->LODProjectIndex != LODProjectIndex || !IsStaticMeshRenderNode(*MeshNode))
+		{
+			continue;
+		}
+
+		FString LogMessage = TEXT("Processing node: ") + MeshNode->NodeName.ToString();
+		PrintWarning(LogMessage);
+
+		PointsOffset = OutRawMesh.VertexPositions.Num();
+		for (const FVector& Point : MeshNode->PointsTable)
+		{
+			OutRawMesh.VertexPositions.Add(MeshNode->LocalMatrix.TransformPosition(Point));
+		}
+
+		auto AddWedge = [&OutRawMesh, &MeshNode, PointsOffset](const FFaceSubData& FaceData)
+		{
+			OutRawMesh.WedgeIndices.Add(PointsOffset + FaceData.p);
+			OutRawMesh.WedgeTangentX.Add(MeshNode->TangentTanTable.Num() > FaceData.n_tan ? FVector(MeshNode->TangentTanTable[FaceData.n_tan]) : FVector::ZeroVector);
+			OutRawMesh.WedgeTangentY.Add(MeshNode->TangentBinTable.Num() > FaceData.n_bin ? MeshNode->TangentBinTable[FaceData.n_bin] : FVector::ZeroVector);
+			OutRawMesh.WedgeTangentZ.Add(MeshNode->NormalsTable.Num() > FaceData.n ? MeshNode->NormalsTable[FaceData.n] : FVector::ZeroVector);
+			OutRawMesh.WedgeColors.Add(FColor(0, 0, 0));
+
+			if (MeshNode->TexCoordTable.Num() > FaceData.uv)
+			{
+				const FVector& TexCoord = MeshNode->TexCoordTable[FaceData.uv];
+				OutRawMesh.WedgeTexCoords[0].Add(FVector2D(TexCoord.X, TexCoord.Y));
+			}
+			else
+			{
+				OutRawMesh.WedgeTexCoords[0].Add(FVector2D(0, 0));
+			}
+			OutRawMesh.WedgeTexCoords[1].Add(FVector2D(0, 0));
+		};
+
+		int32 PolyNum = MeshNode->PolygonTable.Num();
+		for (int j = PolyNum - 1; j >= 0; j--)
+		{
+			const FMeshPolygonData& PolyData = MeshNode->PolygonTable[j];
+			const TArrayView<const FFaceSubData> SubDatas = MeshNode->GetPolygonSubDatas(PolyData);
+
+			// RaiderZ winds faces the other way around, so corners are added in reverse
+			for (int k = 1; k + 1 < SubDatas.Num(); k++)
+			{
+				OutRawMesh.FaceMaterialIndices.Add(PolyData.MaterialID);
+				OutRawMesh.FaceSmoothingMasks.Add(1);
+
+				AddWedge(SubDatas[k + 1]);
+				AddWedge(SubDatas[k]);
+				AddWedge(SubDatas[0]);
+			}
+		}
 	}
+}
+
+bool UEluImporter::ImportEluStaticMesh_Internal(const FString& EluFilePath)
+{
+	FEluFileData EluData = LoadEluData(EluFilePath);
+	if (!EluData.bLoadSuccess)
+	{
+		return false;
+	}
+
+	UStaticMesh* StaticMesh = CreateStaticMesh(EluData, FString("/Game/RaiderZ/Zunk/WAKA"), FString("WAKA"));
 
 	/*
 	IMeshUtilities& MeshUtilities = FModuleManager::Get().LoadModuleChecked<IMeshUtilities>("MeshUtilities");
@@ -559,7 +1185,7 @@ bool UEluImporter::ImportEluStaticMesh_Internal(const FString& EluFilePath)
 	// ImportAllStaticMesh(RootNodeToImport, FbxImporter, Flags, NodeIndex, InterestingNodeCount, SceneInfoPtr);
 
 
-	return true;
+	return StaticMesh != nullptr;
 }
 
 bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
@@ -655,7 +1281,7 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 			int32 ExistingPolygonNum = TempData.Faces.Num();
 			for (int PolygonIndex = 0; PolygonIndex < NumPolygon; PolygonIndex++)
 			{
-				FMeshPolygonData PolyData = MeshNode->PolygonTable[PolygonIndex];
+				const FMeshPolygonData& PolyData = MeshNode->PolygonTable[PolygonIndex];
 				
 				
 			}
@@ -752,12 +1378,12 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 		TSharedPtr<FEluMeshNode> MeshNode = EluMeshNodes[i];
 		check(MeshNode.IsValid());
 
-		if (MeshNode->LODProjectIndex != 0 || MeshNode->NodeName.Contains("hide") || MeshNode->PointsTable.Num() == 0)
+		if (MeshNode->LODProjectIndex != 0 || MeshNode->NodeName.ToString().Contains("hide") || MeshNode->PointsTable.Num() == 0)
 		{
 			continue;
 		}
 
-		FString LogMessage = TEXT("Processing node: ") + MeshNode->NodeName;
+		FString LogMessage = TEXT("Processing node: ") + MeshNode->NodeName.ToString();
 		PrintLog(LogMessage);
 
 		PointsOffset = Points.Num();
@@ -772,7 +1398,8 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 		for (int j = PolyNum - 1; j >= 0; j--)
 		{
 			const FMeshPolygonData& PolyData = MeshNode->PolygonTable[j];
-			int32 SubNum = PolyData.FaceSubDatas.Num();
+			const TArrayView<const FFaceSubData> SubDatas = MeshNode->GetPolygonSubDatas(PolyData);
+			int32 SubNum = SubDatas.Num();
 			check(SubNum == 3);
 
 			SkeletalMeshImportData::FMeshFace MeshFace;
@@ -781,7 +1408,7 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 
 			for (int k = SubNum - 1; k >= 0; k--)
 			{
-				const FFaceSubData& FaceData = PolyData.FaceSubDatas[k];
+				const FFaceSubData& FaceData = SubDatas[k];
 
 				SkeletalMeshImportData::FMeshWedge MeshWedge;
 				MeshWedge.iVertex = PointsOffset + FaceData.p;
@@ -841,7 +1468,7 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 					const FPhysiqueInfo& PhysiqueInfo = MeshNode->PhysiqueTable[FaceData.p];
 					for (const FPhysiqueSubData& PhysiqueSubData : PhysiqueInfo.PhysiqueSubDatas)
 					{
-						FString BoneName = EluMeshNodes[MeshNode->BoneTableIndex[PhysiqueSubData.cid]]->NodeName;
+						FString BoneName = EluMeshNodes[MeshNode->BoneTableIndex[PhysiqueSubData.cid]]->NodeName.ToString();
 						FString SanitizedBoneName = PackageTools::SanitizePackageName(BoneName);
 
 						int32 BoneIndex = SkeletalMesh->RefSkeleton.FindBoneIndex(FName(*SanitizedBoneName));
@@ -877,7 +1504,7 @@ bool UEluImporter::ImportEluSkeletalMesh_Internal(const FString& EluFilePath)
 			const FPhysiqueInfo& PhysiqueInfo = MeshNode->PhysiqueTable[j];
 			for (const FPhysiqueSubData& PhysiqueSubData : PhysiqueInfo.PhysiqueSubDatas)
 			{
-				FString BoneName = EluMeshNodes[MeshNode->BoneTableIndex[PhysiqueSubData.cid]]->NodeName;
+				FString BoneName = EluMeshNodes[MeshNode->BoneTableIndex[PhysiqueSubData.cid]]->NodeName.ToString();
 				FString SanitizedBoneName = PackageTools::SanitizePackageName(BoneName);
 
 				int32 BoneIndex = SkeletalMesh->RefSkeleton.FindBoneIndex(FName(*SanitizedBoneName));
@@ -0,0 +1,245 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "EluMeshCache.h"
+#include "EOD.h"
+#include "EluImporter.h"
+
+#include "Misc/Paths.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTLS.h"
+#include "Templates/UniquePtr.h"
+
+/** Bump whenever the layout of FEluMeshNode, the serialization below or the elu parse itself changes */
+static const int32 EluMeshCacheVersion = 3;
+
+static const uint32 EluMeshCacheMagic = 0x43554c45; // 'ELUC'
+
+/** Serializes an array of plain data with a single block copy. The blobs are only read back by the same build, so endianness and padding don't matter */
+template<typename T>
+static void SerializePlainArray(FArchive& Ar, TArray<T>& Array)
+{
+	static_assert(TIsTriviallyCopyConstructible<T>::Value, "SerializePlainArray only supports plain data types");
+
+	int32 Num = Array.Num();
+	Ar << Num;
+	if (Ar.IsLoading())
+	{
+		if (Num < 0 || (int64)Num * sizeof(T) > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Array.SetNumUninitialized(Num);
+	}
+	Ar.Serialize(Array.GetData(), (int64)Num * sizeof(T));
+}
+
+FString FEluMeshCache::GetCacheKey(const uint8* FileData, int64 FileSize)
+{
+	// CityHash64 takes a 32 bit length, so large files are hashed in chunks
+	uint64 Hash = 0;
+	int64 Offset = 0;
+	do
+	{
+		const uint32 ChunkSize = (uint32)FMath::Min<int64>(FileSize - Offset, MAX_int32);
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(FileData + Offset), ChunkSize, Hash);
+		Offset += ChunkSize;
+	}
+	while (Offset < FileSize);
+
+	return FString::Printf(TEXT("%016llx%08llx"), Hash, (uint64)FileSize);
+}
+
+FString FEluMeshCache::GetCacheFolderPath()
+{
+	return FPaths::ProjectDir() / TEXT("DerivedDataCache") / TEXT("RaiderZ") / TEXT("Elu");
+}
+
+bool FEluMeshCache::Load(const FString& CacheKey, FEluFileData& OutEluData)
+{
+	const FString CacheFilePath = GetCacheFolderPath() / CacheKey + TEXT(".bin");
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*CacheFilePath, FILEREAD_Silent));
+	if (!Reader.IsValid())
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	*Reader << Magic << Version;
+	if (Magic != EluMeshCacheMagic || Version != EluMeshCacheVersion)
+	{
+		return false;
+	}
+
+	FEluFileData CachedData;
+	SerializeEluData(*Reader, CachedData);
+	if (Reader->IsError())
+	{
+		PrintWarning(TEXT("Ignoring corrupt elu cache entry: ") + CacheFilePath);
+		return false;
+	}
+
+	CachedData.bLoadSuccess = true;
+	OutEluData = MoveTemp(CachedData);
+	return true;
+}
+
+void FEluMeshCache::Save(const FString& CacheKey, const FEluFileData& EluData)
+{
+	check(EluData.bLoadSuccess);
+
+	// Written to a temporary file first so that a crash or a concurrent import of the same file never leaves a truncated entry behind
+	const FString CacheFilePath = GetCacheFolderPath() / CacheKey + TEXT(".bin");
+	const FString TempFilePath = CacheFilePath + FString::Printf(TEXT(".%u.%u.tmp"), FPlatformProcess::GetCurrentProcessId(), FPlatformTLS::GetCurrentThreadId());
+
+	{
+		TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+		if (!Writer.IsValid())
+		{
+			PrintWarning(TEXT("Failed to write elu cache entry: ") + CacheFilePath);
+			return;
+		}
+
+		uint32 Magic = EluMeshCacheMagic;
+		int32 Version = EluMeshCacheVersion;
+		*Writer << Magic << Version;
+
+		// Serialization is symmetric, so the data only gets read despite the const_cast
+		SerializeEluData(*Writer, const_cast<FEluFileData&>(EluData));
+		if (!Writer->Close())
+		{
+			Writer.Reset();
+			IFileManager::Get().Delete(*TempFilePath, false, false, true);
+			return;
+		}
+	}
+
+	if (!IFileManager::Get().Move(*CacheFilePath, *TempFilePath, true, true, false, true))
+	{
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+	}
+}
+
+void FEluMeshCache::SerializeEluData(FArchive& Ar, FEluFileData& EluData)
+{
+	Ar.Serialize(&EluData.EluHeader, sizeof(EluData.EluHeader));
+
+	int32 NumNodes = EluData.EluMeshNodes.Num();
+	Ar << NumNodes;
+	if (Ar.IsLoading())
+	{
+		if (NumNodes < 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		EluData.EluMeshNodes.Reset(NumNodes);
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			EluData.EluMeshNodes.Add(MakeShareable(new FEluMeshNode()));
+		}
+	}
+
+	for (const TSharedPtr<FEluMeshNode>& MeshNode : EluData.EluMeshNodes)
+	{
+		check(MeshNode.IsValid());
+		SerializeMeshNode(Ar, *MeshNode);
+		if (Ar.IsError())
+		{
+			return;
+		}
+	}
+}
+
+void FEluMeshCache::SerializeMeshNode(FArchive& Ar, FEluMeshNode& MeshNode)
+{
+	// DWORD and enums don't have archive operators of their own, and plain file archives don't serialize names
+	uint32 Flag = (uint32)MeshNode.dwFlag;
+	int32 MeshAlign = (int32)MeshNode.MeshAlign;
+	FString NodeName = MeshNode.NodeName.ToString();
+	FString NodeParentName = MeshNode.NodeParentName.ToString();
+	Ar << MeshNode.BipID;
+	Ar << NodeName;
+	Ar << NodeParentName;
+	Ar << MeshNode.ParentNodeID;
+	Ar << Flag;
+	Ar << MeshAlign;
+	Ar << MeshNode.BaseVisibility;
+	Ar << MeshNode.LODProjectIndex;
+	Ar << MeshNode.LocalMatrix;
+	MeshNode.dwFlag = Flag;
+	MeshNode.MeshAlign = (RMESH_ALIGN)MeshAlign;
+	if (Ar.IsLoading())
+	{
+		MeshNode.NodeName = FName(*NodeName);
+		MeshNode.NodeParentName = FName(*NodeParentName);
+	}
+
+	Ar << MeshNode.PointsCount;
+	SerializePlainArray(Ar, MeshNode.PointsTable);
+	Ar << MeshNode.NormalsCount;
+	SerializePlainArray(Ar, MeshNode.NormalsTable);
+	Ar << MeshNode.TangentTanCount;
+	SerializePlainArray(Ar, MeshNode.TangentTanTable);
+	Ar << MeshNode.TangentBinCount;
+	SerializePlainArray(Ar, MeshNode.TangentBinTable);
+	Ar << MeshNode.TexCoordCount;
+	SerializePlainArray(Ar, MeshNode.TexCoordTable);
+	Ar << MeshNode.TexCoordExtraCount;
+	SerializePlainArray(Ar, MeshNode.TexCoordExtraTable);
+
+	Ar << MeshNode.FaceCount;
+	SerializePlainArray(Ar, MeshNode.PolygonTable);
+	SerializePlainArray(Ar, MeshNode.FaceSubDataTable);
+	if (Ar.IsLoading())
+	{
+		for (const FMeshPolygonData& Polygon : MeshNode.PolygonTable)
+		{
+			if (Polygon.FirstSubData < 0 || Polygon.Vertices < 0 || Polygon.FirstSubData + Polygon.Vertices > MeshNode.FaceSubDataTable.Num())
+			{
+				Ar.SetError();
+				return;
+			}
+		}
+	}
+	Ar << MeshNode.TotalDegree;
+	Ar << MeshNode.TotalTriangles;
+
+	Ar << MeshNode.PointColorCount;
+	SerializePlainArray(Ar, MeshNode.PointColorTable);
+	Ar << MeshNode.MaterialID;
+
+	Ar << MeshNode.PhysiqueCount;
+	int32 NumPhysiqueInfos = MeshNode.PhysiqueTable.Num();
+	Ar << NumPhysiqueInfos;
+	if (Ar.IsLoading())
+	{
+		if (NumPhysiqueInfos < 0 || NumPhysiqueInfos > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		MeshNode.PhysiqueTable.SetNum(NumPhysiqueInfos);
+	}
+	for (FPhysiqueInfo& PhysiqueInfo : MeshNode.PhysiqueTable)
+	{
+		Ar << PhysiqueInfo.Num;
+		SerializePlainArray(Ar, PhysiqueInfo.PhysiqueSubDatas);
+	}
+
+	Ar << MeshNode.BoneCount;
+	SerializePlainArray(Ar, MeshNode.BoneTable);
+	SerializePlainArray(Ar, MeshNode.BoneTableIndex);
+	Ar << MeshNode.VertexIndexCount;
+	SerializePlainArray(Ar, MeshNode.VertexIndexTable);
+	Ar << MeshNode.FaceIndexCount;
+	SerializePlainArray(Ar, MeshNode.FaceIndexTable);
+	Ar << MeshNode.MaterialInfoCount;
+	SerializePlainArray(Ar, MeshNode.MaterialInfoTable);
+
+	Ar << MeshNode.BoundingBox.vmin;
+	Ar << MeshNode.BoundingBox.vmax;
+}
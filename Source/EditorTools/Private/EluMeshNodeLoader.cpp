@@ -1,7 +1,6 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "EluMeshNodeLoader.h"
-#include "RaiderzXmlUtilities.h"
 #include "EluLibrary.h"
 
 FEluMeshNodeLoader::FEluMeshNodeLoader()
@@ -12,32 +11,109 @@ FEluMeshNodeLoader::~FEluMeshNodeLoader()
 {
 }
 
-bool FEluMeshNodeLoader_v12::Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader::LoadPolygonTable(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
+{
+	if (!Reader.Read(MeshNode->TotalDegree) || !Reader.Read(MeshNode->TotalTriangles))
+	{
+		return false;
+	}
+
+	// Every face starts with its degree
+	if (!Reader.CanRead(MeshNode->TotalDegree, sizeof(FFaceSubData)) || !Reader.CanRead(MeshNode->FaceCount, sizeof(int)))
+	{
+		return false;
+	}
+
+	// Every corner goes into the shared sub data table so that a node takes two allocations no matter how many polygons it has
+	MeshNode->PolygonTable.Reserve(MeshNode->PolygonTable.Num() + MeshNode->FaceCount);
+	MeshNode->FaceSubDataTable.Reserve(MeshNode->FaceSubDataTable.Num() + MeshNode->TotalDegree);
+
+	int Total = 0;
+	for (int i = 0; i < MeshNode->FaceCount; i++)
+	{
+		int Deg = 0;
+		if (!Reader.Read(Deg))
+		{
+			return false;
+		}
+
+		FMeshPolygonData& PolyData = MeshNode->PolygonTable.AddDefaulted_GetRef();
+		PolyData.FirstSubData = MeshNode->FaceSubDataTable.Num();
+		PolyData.Vertices = Deg;
+		if (!Reader.ReadArray(Deg, MeshNode->FaceSubDataTable) || !Reader.Read(PolyData.MaterialID))
+		{
+			return false;
+		}
+
+		Total += Deg;
+	}
+
+	// Malformed files fail the load instead of asserting, so batch imports can skip them
+	return Total == MeshNode->TotalDegree;
+}
+
+void FEluMeshNodeLoader::SelectPhysiqueWeights(FPhysiqueInfo& PhysiqueInfo)
+{
+	check(PhysiqueInfo.Num > PHYSIQUE_MAX_WEIGHT && PhysiqueInfo.PhysiqueSubDatas.Num() == PhysiqueInfo.Num);
+
+	// Partial selection sort that only moves the PHYSIQUE_MAX_WEIGHT heaviest weights to the front
+	TArray<FPhysiqueSubData>& SubDatas = PhysiqueInfo.PhysiqueSubDatas;
+	for (int m = 0; m < PHYSIQUE_MAX_WEIGHT; m++)
+	{
+		int MaxIndex = m;
+		for (int n = m + 1; n < PhysiqueInfo.Num; n++)
+		{
+			if (SubDatas[n].weight > SubDatas[MaxIndex].weight)
+			{
+				MaxIndex = n;
+			}
+		}
+
+		if (MaxIndex != m)
+		{
+			Swap(SubDatas[m], SubDatas[MaxIndex]);
+		}
+	}
+
+	float WeightSum = 0.f;
+	for (int m = 0; m < PHYSIQUE_MAX_WEIGHT; m++)
+	{
+		WeightSum += SubDatas[m].weight;
+	}
+	for (int m = 0; m < PHYSIQUE_MAX_WEIGHT; m++)
+	{
+		SubDatas[m].weight = SubDatas[m].weight / WeightSum;
+	}
+
+	PhysiqueInfo.Num = PHYSIQUE_MAX_WEIGHT;
+}
+
+bool FEluMeshNodeLoader_v12::Load(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	check(MeshNode);
-	check(BinaryData.GetData());
+	check(Reader.IsOpen());
 
-	if (!LoadName(MeshNode, BinaryData, Offset))
+	if (!LoadName(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadInfo(MeshNode, BinaryData, Offset))
+	if (!LoadInfo(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadVertex(MeshNode, BinaryData, Offset))
+	if (!LoadVertex(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadFace(MeshNode, BinaryData, Offset))
+	if (!LoadFace(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadVertexInfo(MeshNode, BinaryData, Offset))
+	if (!LoadVertexInfo(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadEtc(MeshNode, BinaryData, Offset))
+	if (!LoadEtc(MeshNode, Reader))
 	{
 		return false;
 	}
@@ -51,30 +127,30 @@ bool FEluMeshNodeLoader_v12::Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadName(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadName(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(MeshNode->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(MeshNode->NodeName))
 	{
 		return false;
 	}
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(MeshNode->NodeParentName, BinaryData, Offset))
+	if (!Reader.ReadName(MeshNode->NodeParentName))
 	{
 		return false;
 	}
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->ParentNodeID, sizeof(MeshNode->ParentNodeID), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->ParentNodeID))
 	{
 		return false;
 	}
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->dwFlag, sizeof(MeshNode->dwFlag), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->dwFlag))
 	{
 		return false;
 	}
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MeshAlign, sizeof(MeshNode->MeshAlign), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->MeshAlign))
 	{
 		return false;
 	}
@@ -83,21 +159,21 @@ bool FEluMeshNodeLoader_v12::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 	{
 		// What the fuck are these used for?
 		int AniPartsType;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&AniPartsType, sizeof(AniPartsType), BinaryData, Offset);
+		Reader.Read(AniPartsType);
 		int PartsPosInfoType;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PartsPosInfoType, sizeof(PartsPosInfoType), BinaryData, Offset);
+		Reader.Read(PartsPosInfoType);
 		int PartsType;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PartsType, sizeof(PartsType), BinaryData, Offset);
+		Reader.Read(PartsType);
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->LocalMatrix, sizeof(MeshNode->LocalMatrix), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->LocalMatrix))
 	{
 		return false;
 	}
 
 	if (CurrentEluVersion >= EXPORTER_MESH_VER11)
 	{
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BaseVisibility, sizeof(MeshNode->BaseVisibility), BinaryData, Offset))
+		if (!Reader.Read(MeshNode->BaseVisibility))
 		{
 			return false;
 		}
@@ -106,84 +182,69 @@ bool FEluMeshNodeLoader_v12::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
+	{
+		return false;
+	}
+	if (!Reader.CanRead(MeshNode->TangentTanCount, sizeof(FVector)))
 	{
 		return false;
 	}
+	MeshNode->TangentTanTable.Reserve(MeshNode->TangentTanTable.Num() + MeshNode->TangentTanCount);
 	for (int i = 0; i < MeshNode->TangentTanCount; i++)
 	{
 		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
+		if (!Reader.Read(Point))
 		{
 			return false;
 		}
 		MeshNode->TangentTanTable.Add(FVector4(Point));
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->FaceCount, sizeof(MeshNode->FaceCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->FaceCount))
 	{
 		return false;
 	}
@@ -192,20 +253,22 @@ bool FEluMeshNodeLoader_v12::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 	{
 		if (CurrentEluVersion < EXPORTER_MESH_VER12)
 		{
+			if (!Reader.CanRead((int64)MeshNode->FaceCount * 3, sizeof(FFaceSubData)))
+			{
+				return false;
+			}
+
+			MeshNode->PolygonTable.Reserve(MeshNode->PolygonTable.Num() + MeshNode->FaceCount);
+			MeshNode->FaceSubDataTable.Reserve(MeshNode->FaceSubDataTable.Num() + MeshNode->FaceCount * 3);
 			for (int i = 0; i < MeshNode->FaceCount; i++)
 			{
-				FMeshPolygonData PolyData;
+				FMeshPolygonData& PolyData = MeshNode->PolygonTable.AddDefaulted_GetRef();
+				PolyData.FirstSubData = MeshNode->FaceSubDataTable.Num();
 				PolyData.Vertices = 3;
-				for (int j = 0; j < 3; j++)
+				if (!Reader.ReadArray(3, MeshNode->FaceSubDataTable) || !Reader.Read(PolyData.MaterialID))
 				{
-					FFaceSubData FaceSubData;
-					URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceSubData, sizeof(FaceSubData), BinaryData, Offset);
-					PolyData.FaceSubDatas.Add(FaceSubData);
-
+					return false;
 				}
-				
-				URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PolyData.MaterialID, sizeof(PolyData.MaterialID), BinaryData, Offset);
-				MeshNode->PolygonTable.Add(PolyData);
 			}
 			
 			MeshNode->TotalDegree = MeshNode->FaceCount * 3;
@@ -213,62 +276,23 @@ bool FEluMeshNodeLoader_v12::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 		}
 		else
 		{
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TotalDegree, sizeof(MeshNode->TotalDegree), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TotalTriangles, sizeof(MeshNode->TotalTriangles), BinaryData, Offset);
-
-			for (int i = 0; i < MeshNode->FaceCount; i++)
-			{
-				int Deg = 0;
-				URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Deg, sizeof(Deg), BinaryData, Offset);
-
-				FMeshPolygonData PolyData;
-				PolyData.Vertices = Deg;
-
-				for (int j = 0; j < Deg; j++)
-				{
-					FFaceSubData FaceSubData;
-					URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceSubData, sizeof(FaceSubData), BinaryData, Offset);
-					PolyData.FaceSubDatas.Add(FaceSubData);
-				}
-
-				URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PolyData.MaterialID, sizeof(PolyData.MaterialID), BinaryData, Offset);
-				MeshNode->PolygonTable.Add(PolyData);
-			}
-
-			//~ Begin MeshNode->TotalDegree verification
-			int Total = 0;
-			for (FMeshPolygonData PolyData : MeshNode->PolygonTable)
-			{
-				for (FFaceSubData FaceSubData : PolyData.FaceSubDatas)
-				{
-					Total++;
-				}
-			}
-
-			check(Total == MeshNode->TotalDegree);
-			//~ End MeshNode->TotalDegree verification
-
+			return LoadPolygonTable(MeshNode, Reader);
 		}
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadVertexInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadVertexInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointColorCount, sizeof(MeshNode->PointColorCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointColorCount))
 	{
 		return false;
 	}
 
-	for (int i = 0; i < MeshNode->PointColorCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointColorCount, MeshNode->PointColorTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointColorTable.Add(Point);
+		return false;
 	}
 
 	if (MeshNode->PointsCount == 0 || MeshNode->FaceCount == 0)
@@ -276,101 +300,67 @@ bool FEluMeshNodeLoader_v12::LoadVertexInfo(TSharedPtr<FEluMeshNode> MeshNode, T
 		MeshNode->AddFlag(RM_FLAG_DUMMY_MESH);
 	}
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MaterialID, sizeof(MeshNode->MaterialID), BinaryData, Offset);
+	Reader.Read(MeshNode->MaterialID);
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PhysiqueCount, sizeof(MeshNode->PhysiqueCount), BinaryData, Offset);
+	Reader.Read(MeshNode->PhysiqueCount);
 
-	if (MeshNode->PhysiqueCount)
+	if (MeshNode->PhysiqueCount && MeshNode->PointsCount != MeshNode->PhysiqueCount)
 	{
-		check(MeshNode->PointsCount == MeshNode->PhysiqueCount);
+		return false;
 	}
 
-	for (int i = 0; i < MeshNode->PhysiqueCount; i++)
+	if (!Reader.CanRead(MeshNode->PhysiqueCount, sizeof(int)))
 	{
-		FPhysiqueInfo PhysiqueInfo;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PhysiqueInfo.Num, sizeof(PhysiqueInfo.Num), BinaryData, Offset);
+		return false;
+	}
 
-		for (int k = 0; k < PhysiqueInfo.Num; k++)
+	MeshNode->PhysiqueTable.Reserve(MeshNode->PhysiqueTable.Num() + MeshNode->PhysiqueCount);
+	for (int i = 0; i < MeshNode->PhysiqueCount; i++)
+	{
+		FPhysiqueInfo& PhysiqueInfo = MeshNode->PhysiqueTable.AddDefaulted_GetRef();
+		if (!Reader.Read(PhysiqueInfo.Num) || !Reader.ReadArray(PhysiqueInfo.Num, PhysiqueInfo.PhysiqueSubDatas))
 		{
-			FPhysiqueSubData PhysiqueSubData;
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PhysiqueSubData, sizeof(PhysiqueSubData), BinaryData, Offset);
-			PhysiqueInfo.PhysiqueSubDatas.Add(PhysiqueSubData);
+			return false;
 		}
 
 		if (PhysiqueInfo.Num > PHYSIQUE_MAX_WEIGHT)
 		{
-			for (int m = 0; m < PhysiqueInfo.Num; m++)
-			{
-				for (int n = m + 1; n < PhysiqueInfo.Num; n++)
-				{
-					if (PhysiqueInfo.PhysiqueSubDatas[m].weight < PhysiqueInfo.PhysiqueSubDatas[n].weight)
-					{
-						FPhysiqueSubData temp;
-						temp = PhysiqueInfo.PhysiqueSubDatas[m];
-						PhysiqueInfo.PhysiqueSubDatas[m] = PhysiqueInfo.PhysiqueSubDatas[n];
-						PhysiqueInfo.PhysiqueSubDatas[n] = temp;
-
-					}
-				}
-			}
-
-#if PHYSIQUE_MAX_WEIGHT == 4
-			float fSum3 = PhysiqueInfo.PhysiqueSubDatas[0].weight + PhysiqueInfo.PhysiqueSubDatas[1].weight + PhysiqueInfo.PhysiqueSubDatas[2].weight + PhysiqueInfo.PhysiqueSubDatas[3].weight;
-			PhysiqueInfo.PhysiqueSubDatas[0].weight = PhysiqueInfo.PhysiqueSubDatas[0].weight / fSum3;
-			PhysiqueInfo.PhysiqueSubDatas[1].weight = PhysiqueInfo.PhysiqueSubDatas[1].weight / fSum3;
-			PhysiqueInfo.PhysiqueSubDatas[2].weight = PhysiqueInfo.PhysiqueSubDatas[2].weight / fSum3;
-			PhysiqueInfo.PhysiqueSubDatas[3].weight = PhysiqueInfo.PhysiqueSubDatas[3].weight / fSum3;
-			PhysiqueInfo.Num = 4;
-#else
-			float fSum3 = PhysiqueInfo.PhysiqueSubDatas[0].weight + PhysiqueInfo.PhysiqueSubDatas[1].weight + PhysiqueInfo.PhysiqueSubDatas[2].weight;
-			PhysiqueInfo.PhysiqueSubDatas[0].weight = PhysiqueInfo.PhysiqueSubDatas[0].weight / fSum3;
-			PhysiqueInfo.PhysiqueSubDatas[1].weight = PhysiqueInfo.PhysiqueSubDatas[1].weight / fSum3;
-			PhysiqueInfo.PhysiqueSubDatas[2].weight = PhysiqueInfo.PhysiqueSubDatas[2].weight / fSum3;
-			PhysiqueInfo.Num = 3;
-#endif
+			SelectPhysiqueWeights(PhysiqueInfo);
 		}
-
-		MeshNode->PhysiqueTable.Add(PhysiqueInfo);
-
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoneCount, sizeof(MeshNode->BoneCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->BoneCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTable))
 	{
-		FMatrix BoneMatrix;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneMatrix, sizeof(BoneMatrix), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTable.Add(BoneMatrix);
+		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTableIndex))
 	{
-		WORD BoneIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneIndex, sizeof(BoneIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTableIndex.Add(BoneIndex);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->VertexIndexCount, sizeof(MeshNode->VertexIndexCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->VertexIndexCount))
 	{
 		return false;
 	}
+	if (!Reader.CanRead(MeshNode->VertexIndexCount, sizeof(FVertexIndex_v12)))
+	{
+		return false;
+	}
+	MeshNode->VertexIndexTable.Reserve(MeshNode->VertexIndexTable.Num() + MeshNode->VertexIndexCount);
 	for (int i = 0; i < MeshNode->VertexIndexCount; i++)
 	{
 		FVertexIndex VertexIndex;
 		FVertexIndex_v12 VertexIndex_v12;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VertexIndex_v12, sizeof(VertexIndex_v12), BinaryData, Offset))
+		if (!Reader.Read(VertexIndex_v12))
 		{
 			return false;
 		}
@@ -389,14 +379,9 @@ bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	{
 		MeshNode->FaceIndexCount = MeshNode->FaceCount * 3;
 
-		for (int i = 0; i < MeshNode->FaceIndexCount; i++)
+		if (!Reader.ReadArray(MeshNode->FaceIndexCount, MeshNode->FaceIndexTable))
 		{
-			WORD FaceIndex;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceIndex, sizeof(FaceIndex), BinaryData, Offset))
-			{
-				return false;
-			}
-			MeshNode->FaceIndexTable.Add(FaceIndex);
+			return false;
 		}
 
 	}
@@ -404,35 +389,36 @@ bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	{
 		//~ Begin neglected data
 		int PrimitiveType;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PrimitiveType, sizeof(PrimitiveType), BinaryData, Offset);
+		Reader.Read(PrimitiveType);
 		//~ End neglected data
 
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->FaceIndexCount, sizeof(MeshNode->FaceIndexCount), BinaryData, Offset);
+		Reader.Read(MeshNode->FaceIndexCount);
 
-		for (int i = 0; i < MeshNode->FaceIndexCount; i++)
+		if (!Reader.ReadArray(MeshNode->FaceIndexCount, MeshNode->FaceIndexTable))
 		{
-			WORD FaceIndex;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceIndex, sizeof(FaceIndex), BinaryData, Offset))
-			{
-				return false;
-			}
-			MeshNode->FaceIndexTable.Add(FaceIndex);
+			return false;
 		}
 
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MaterialInfoCount, sizeof(MeshNode->MaterialInfoCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->MaterialInfoCount))
 	{
 		return false;
 	}
 	if (CurrentEluVersion < EXPORTER_MESH_VER9)
 	{
+		// Old files store the material id, offset and count of every entry
+		if (!Reader.CanRead(MeshNode->MaterialInfoCount, sizeof(int) + sizeof(WORD) * 2))
+		{
+			return false;
+		}
+		MeshNode->MaterialInfoTable.Reserve(MeshNode->MaterialInfoTable.Num() + MeshNode->MaterialInfoCount);
 		for (int i = 0; i < MeshNode->MaterialInfoCount; i++)
 		{
 			FMtrlTableInfo MtrlTableInfo;
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.mtrlid, sizeof(MtrlTableInfo.mtrlid), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.offset, sizeof(MtrlTableInfo.offset), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.count, sizeof(MtrlTableInfo.count), BinaryData, Offset);
+			Reader.Read(MtrlTableInfo.mtrlid);
+			Reader.Read(MtrlTableInfo.offset);
+			Reader.Read(MtrlTableInfo.count);
 			MtrlTableInfo.nSubMaterialIDForDrawMasking = 0;
 			
 			MeshNode->MaterialInfoTable.Add(MtrlTableInfo);
@@ -440,13 +426,9 @@ bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	}
 	else
 	{
-		for (int i = 0; i < MeshNode->MaterialInfoCount; i++)
+		if (!Reader.ReadArray(MeshNode->MaterialInfoCount, MeshNode->MaterialInfoTable))
 		{
-			FMtrlTableInfo MtrlTableInfo;
-
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo, sizeof(MtrlTableInfo), BinaryData, Offset);
-
-			MeshNode->MaterialInfoTable.Add(MtrlTableInfo);
+			return false;
 		}
 	}
 
@@ -456,32 +438,32 @@ bool FEluMeshNodeLoader_v12::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	return true;
 }
 
-bool FEluMeshNodeLoader_v13::Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v13::Load(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	check(MeshNode);
-	check(BinaryData.GetData());
+	check(Reader.IsOpen());
 
-	if (!LoadName(MeshNode, BinaryData, Offset))
+	if (!LoadName(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadInfo(MeshNode, BinaryData, Offset))
+	if (!LoadInfo(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadVertex(MeshNode, BinaryData, Offset))
+	if (!LoadVertex(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadFace(MeshNode, BinaryData, Offset))
+	if (!LoadFace(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadVertexInfo(MeshNode, BinaryData, Offset))
+	if (!LoadVertexInfo(MeshNode, Reader))
 	{
 		return false;
 	}
-	if (!LoadEtc(MeshNode, BinaryData, Offset))
+	if (!LoadEtc(MeshNode, Reader))
 	{
 		return false;
 	}
@@ -491,210 +473,141 @@ bool FEluMeshNodeLoader_v13::Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint
 	return true;
 }
 
-bool FEluMeshNodeLoader_v13::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v13::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!FEluMeshNodeLoader_v12::LoadEtc(MeshNode, BinaryData, Offset))
+	if (!FEluMeshNodeLoader_v12::LoadEtc(MeshNode, Reader))
 	{
 		return false;
 	}
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmin, sizeof(FVector), BinaryData, Offset);
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmax, sizeof(FVector), BinaryData, Offset);
+	Reader.Read(MeshNode->BoundingBox.vmin);
+	Reader.Read(MeshNode->BoundingBox.vmax);
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v15::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v15::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	// @unknown
 	DWORD dwFVF;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&dwFVF, sizeof(dwFVF), BinaryData, Offset);
+	Reader.Read(dwFVF);
 
 	//~ Begin neglected data
 	int LightMapID;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&LightMapID, sizeof(LightMapID), BinaryData, Offset);
+	Reader.Read(LightMapID);
 	//~ End neglected data
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
+	{
+		return false;
+	}
+	if (!Reader.CanRead(MeshNode->TangentTanCount, sizeof(FVector)))
 	{
 		return false;
 	}
+	MeshNode->TangentTanTable.Reserve(MeshNode->TangentTanTable.Num() + MeshNode->TangentTanCount);
 	for (int i = 0; i < MeshNode->TangentTanCount; i++)
 	{
 		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
+		if (!Reader.Read(Point))
 		{
 			return false;
 		}
 		MeshNode->TangentTanTable.Add(FVector4(Point));
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
 	//~ Begin neglected data
 	int LightMapTexCoordTableCount;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&LightMapTexCoordTableCount, sizeof(LightMapTexCoordTableCount), BinaryData, Offset);
-	Offset += sizeof(FVector) * LightMapTexCoordTableCount;
+	Reader.Read(LightMapTexCoordTableCount);
+	Reader.Skip(sizeof(FVector) * LightMapTexCoordTableCount);
 	//~ End neglected data
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v15::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v15::LoadFace(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->FaceCount, sizeof(MeshNode->FaceCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->FaceCount))
 	{
 		return false;
 	}
 	if (MeshNode->FaceCount)
 	{
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TotalDegree, sizeof(MeshNode->TotalDegree), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TotalTriangles, sizeof(MeshNode->TotalTriangles), BinaryData, Offset);
-
-			for (int i = 0; i < MeshNode->FaceCount; i++)
-			{
-				int Deg = 0;
-				URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Deg, sizeof(Deg), BinaryData, Offset);
-
-				FMeshPolygonData PolyData;
-				PolyData.Vertices = Deg;
-
-				for (int j = 0; j < Deg; j++)
-				{
-					FFaceSubData FaceSubData;
-					URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceSubData, sizeof(FaceSubData), BinaryData, Offset);
-					PolyData.FaceSubDatas.Add(FaceSubData);
-				}
-
-				URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PolyData.MaterialID, sizeof(PolyData.MaterialID), BinaryData, Offset);
-				MeshNode->PolygonTable.Add(PolyData);
-			}
-
-			//~ Begin MeshNode->TotalDegree verification
-			int Total = 0;
-			for (FMeshPolygonData PolyData : MeshNode->PolygonTable)
-			{
-				for (FFaceSubData FaceSubData : PolyData.FaceSubDatas)
-				{
-					Total++;
-				}
-			}
-
-			check(Total == MeshNode->TotalDegree);
-			//~ End MeshNode->TotalDegree verification
+		return LoadPolygonTable(MeshNode, Reader);
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v15::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v15::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoneCount, sizeof(MeshNode->BoneCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->BoneCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTable))
 	{
-		FMatrix BoneMatrix;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneMatrix, sizeof(BoneMatrix), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTable.Add(BoneMatrix);
+		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTableIndex))
 	{
-		WORD BoneIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneIndex, sizeof(BoneIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTableIndex.Add(BoneIndex);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->VertexIndexCount, sizeof(MeshNode->VertexIndexCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->VertexIndexCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->VertexIndexCount; i++)
+	if (!Reader.ReadArray(MeshNode->VertexIndexCount, MeshNode->VertexIndexTable))
 	{
-		FVertexIndex VertexIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VertexIndex, sizeof(VertexIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-
-		MeshNode->VertexIndexTable.Add(VertexIndex);
+		return false;
 	}
 
 	if (CurrentEluVersion < EXPORTER_MESH_VER12)
 	{
 		MeshNode->FaceIndexCount = MeshNode->FaceCount * 3;
 
-		for (int i = 0; i < MeshNode->FaceIndexCount; i++)
+		if (!Reader.ReadArray(MeshNode->FaceIndexCount, MeshNode->FaceIndexTable))
 		{
-			WORD FaceIndex;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceIndex, sizeof(FaceIndex), BinaryData, Offset))
-			{
-				return false;
-			}
-			MeshNode->FaceIndexTable.Add(FaceIndex);
+			return false;
 		}
 
 	}
@@ -702,35 +615,36 @@ bool FEluMeshNodeLoader_v15::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	{
 		//~ Begin neglected data
 		int PrimitiveType;
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PrimitiveType, sizeof(PrimitiveType), BinaryData, Offset);
+		Reader.Read(PrimitiveType);
 		//~ End neglected data
 
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->FaceIndexCount, sizeof(MeshNode->FaceIndexCount), BinaryData, Offset);
+		Reader.Read(MeshNode->FaceIndexCount);
 
-		for (int i = 0; i < MeshNode->FaceIndexCount; i++)
+		if (!Reader.ReadArray(MeshNode->FaceIndexCount, MeshNode->FaceIndexTable))
 		{
-			WORD FaceIndex;
-			if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceIndex, sizeof(FaceIndex), BinaryData, Offset))
-			{
-				return false;
-			}
-			MeshNode->FaceIndexTable.Add(FaceIndex);
+			return false;
 		}
 
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MaterialInfoCount, sizeof(MeshNode->MaterialInfoCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->MaterialInfoCount))
 	{
 		return false;
 	}
 	if (CurrentEluVersion < EXPORTER_MESH_VER9)
 	{
+		// Old files store the material id, offset and count of every entry
+		if (!Reader.CanRead(MeshNode->MaterialInfoCount, sizeof(int) + sizeof(WORD) * 2))
+		{
+			return false;
+		}
+		MeshNode->MaterialInfoTable.Reserve(MeshNode->MaterialInfoTable.Num() + MeshNode->MaterialInfoCount);
 		for (int i = 0; i < MeshNode->MaterialInfoCount; i++)
 		{
 			FMtrlTableInfo MtrlTableInfo;
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.mtrlid, sizeof(MtrlTableInfo.mtrlid), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.offset, sizeof(MtrlTableInfo.offset), BinaryData, Offset);
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo.count, sizeof(MtrlTableInfo.count), BinaryData, Offset);
+			Reader.Read(MtrlTableInfo.mtrlid);
+			Reader.Read(MtrlTableInfo.offset);
+			Reader.Read(MtrlTableInfo.count);
 			MtrlTableInfo.nSubMaterialIDForDrawMasking = 0;
 
 			MeshNode->MaterialInfoTable.Add(MtrlTableInfo);
@@ -738,309 +652,225 @@ bool FEluMeshNodeLoader_v15::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	}
 	else
 	{
-		for (int i = 0; i < MeshNode->MaterialInfoCount; i++)
+		if (!Reader.ReadArray(MeshNode->MaterialInfoCount, MeshNode->MaterialInfoTable))
 		{
-			FMtrlTableInfo MtrlTableInfo;
-
-			URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo, sizeof(MtrlTableInfo), BinaryData, Offset);
-
-			MeshNode->MaterialInfoTable.Add(MtrlTableInfo);
+			return false;
 		}
 	}
 
 	// @todo add BipID if it's needed anywhere
 	// MeshNode->BipID = 
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmin, sizeof(FVector), BinaryData, Offset);
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmax, sizeof(FVector), BinaryData, Offset);
+	Reader.Read(MeshNode->BoundingBox.vmin);
+	Reader.Read(MeshNode->BoundingBox.vmax);
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v16::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v16::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	// @unknown
 	DWORD dwFVF;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&dwFVF, sizeof(dwFVF), BinaryData, Offset);
+	Reader.Read(dwFVF);
 
 	//~ Begin neglected data
 	int LightMapID;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&LightMapID, sizeof(LightMapID), BinaryData, Offset);
+	Reader.Read(LightMapID);
 	//~ End neglected data
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentTanCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentTanCount, MeshNode->TangentTanTable))
 	{
-		FVector4 Point4;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point4, sizeof(Point4), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentTanTable.Add(Point4);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
 	//~ Begin neglected data
 	int LightMapTexCoordTableCount;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&LightMapTexCoordTableCount, sizeof(LightMapTexCoordTableCount), BinaryData, Offset);
-	Offset += sizeof(FVector) * LightMapTexCoordTableCount;
+	Reader.Read(LightMapTexCoordTableCount);
+	Reader.Skip(sizeof(FVector) * LightMapTexCoordTableCount);
 	//~ End neglected data
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v17::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v17::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	// @unknown
 	DWORD dwFVF;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&dwFVF, sizeof(dwFVF), BinaryData, Offset);
+	Reader.Read(dwFVF);
 
 	//~ Begin neglected data
 	int LightMapID;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&LightMapID, sizeof(LightMapID), BinaryData, Offset);
+	Reader.Read(LightMapID);
 	//~ End neglected data
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentTanCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentTanCount, MeshNode->TangentTanTable))
 	{
-		FVector4 Point4;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point4, sizeof(Point4), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentTanTable.Add(Point4);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v18::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v18::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentTanCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentTanCount, MeshNode->TangentTanTable))
 	{
-		FVector4 Point4;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point4, sizeof(Point4), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentTanTable.Add(Point4);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordExtraCount, sizeof(MeshNode->TexCoordExtraCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordExtraCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordExtraCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordExtraCount, MeshNode->TexCoordExtraTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordExtraTable.Add(Point);
+		return false;
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v20::LoadName(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v20::LoadName(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(MeshNode->NodeName, BinaryData, Offset))
+	if (!Reader.ReadName(MeshNode->NodeName))
 	{
 		// UE_LOG(LogTemp, Warning, TEXT("v20 : Reading node name failed"));
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->ParentNodeID, sizeof(MeshNode->ParentNodeID), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->ParentNodeID))
 	{
 		// UE_LOG(LogTemp, Warning, TEXT("v20 : Reading parent node ID failed"));
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::ReadStringFromBinaryData(MeshNode->NodeParentName, BinaryData, Offset))
+	if (!Reader.ReadName(MeshNode->NodeParentName))
 	{
 		// UE_LOG(LogTemp, Warning, TEXT("v20 : Reading parent node name failed"));
 		return false;
@@ -1048,29 +878,29 @@ bool FEluMeshNodeLoader_v20::LoadName(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 	return true;
 }
 
-bool FEluMeshNodeLoader_v20::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v20::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->LocalMatrix, sizeof(MeshNode->LocalMatrix), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->LocalMatrix))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BaseVisibility, sizeof(MeshNode->BaseVisibility), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->BaseVisibility))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->dwFlag, sizeof(MeshNode->dwFlag), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->dwFlag))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MeshAlign, sizeof(MeshNode->MeshAlign), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->MeshAlign))
 	{
 		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->LODProjectIndex, sizeof(MeshNode->LODProjectIndex), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->LODProjectIndex))
 	{
 		return false;
 	}
@@ -1078,171 +908,116 @@ bool FEluMeshNodeLoader_v20::LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<
 	return true;
 }
 
-bool FEluMeshNodeLoader_v20::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v20::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordExtraCount, sizeof(MeshNode->TexCoordExtraCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordExtraCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordExtraCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordExtraCount, MeshNode->TexCoordExtraTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordExtraTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentTanCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentTanCount, MeshNode->TangentTanTable))
 	{
-		FVector4 Point4;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point4, sizeof(Point4), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentTanTable.Add(Point4);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
 	return true;
 }
 
-bool FEluMeshNodeLoader_v20::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v20::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	//~ Begin neglected data
 	int PrimitiveType;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&PrimitiveType, sizeof(PrimitiveType), BinaryData, Offset);
+	Reader.Read(PrimitiveType);
 	//~ End neglected data
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->VertexIndexCount, sizeof(MeshNode->VertexIndexCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->VertexIndexCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->VertexIndexCount; i++)
+	if (!Reader.ReadArray(MeshNode->VertexIndexCount, MeshNode->VertexIndexTable))
 	{
-		FVertexIndex VertexIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&VertexIndex, sizeof(VertexIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-
-		MeshNode->VertexIndexTable.Add(VertexIndex);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoneCount, sizeof(MeshNode->BoneCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->BoneCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTable))
 	{
-		FMatrix BoneMatrix;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneMatrix, sizeof(BoneMatrix), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTable.Add(BoneMatrix);
+		return false;
 	}
-	for (int i = 0; i < MeshNode->BoneCount; i++)
+	if (!Reader.ReadArray(MeshNode->BoneCount, MeshNode->BoneTableIndex))
 	{
-		WORD BoneIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&BoneIndex, sizeof(BoneIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->BoneTableIndex.Add(BoneIndex);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->MaterialInfoCount, sizeof(MeshNode->MaterialInfoCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->MaterialInfoCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->MaterialInfoCount; i++)
+	if (!Reader.ReadArray(MeshNode->MaterialInfoCount, MeshNode->MaterialInfoTable))
 	{
-		FMtrlTableInfo MtrlTableInfo;
-
-		URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MtrlTableInfo, sizeof(MtrlTableInfo), BinaryData, Offset);
-
-		MeshNode->MaterialInfoTable.Add(MtrlTableInfo);
+		return false;
 	}
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->FaceIndexCount, sizeof(MeshNode->FaceIndexCount), BinaryData, Offset);
-	for (int i = 0; i < MeshNode->FaceIndexCount; i++)
+	Reader.Read(MeshNode->FaceIndexCount);
+	if (!Reader.ReadArray(MeshNode->FaceIndexCount, MeshNode->FaceIndexTable))
 	{
-		WORD FaceIndex;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&FaceIndex, sizeof(FaceIndex), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->FaceIndexTable.Add(FaceIndex);
+		return false;
 	}
 
 	// @todo add BipID if it's needed anywhere
 	// MeshNode->BipID = 
 
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmin, sizeof(FVector), BinaryData, Offset);
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->BoundingBox.vmax, sizeof(FVector), BinaryData, Offset);
+	Reader.Read(MeshNode->BoundingBox.vmin);
+	Reader.Read(MeshNode->BoundingBox.vmax);
 
 	if (MeshNode->BoundingBox.vmin.X == FLT_MAX)
 	{
@@ -1253,82 +1028,67 @@ bool FEluMeshNodeLoader_v20::LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<u
 	return true;
 }
 
-bool FEluMeshNodeLoader_v14::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset)
+bool FEluMeshNodeLoader_v14::LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader)
 {
 	// @unknown
 	DWORD dwFVF;
-	URaiderzXmlUtilities::WriteBinaryDataToBuffer(&dwFVF, sizeof(dwFVF), BinaryData, Offset);
+	Reader.Read(dwFVF);
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->PointsCount, sizeof(MeshNode->PointsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->PointsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->PointsCount; i++)
+	if (!Reader.ReadArray(MeshNode->PointsCount, MeshNode->PointsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->PointsTable.Add(Point);
+		return false;
 	}
 
 	MeshNode->CalculateLocalBoundingBox();
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->NormalsCount, sizeof(MeshNode->NormalsCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->NormalsCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->NormalsCount; i++)
+	if (!Reader.ReadArray(MeshNode->NormalsCount, MeshNode->NormalsTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->NormalsTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentTanCount, sizeof(MeshNode->TangentTanCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentTanCount))
+	{
+		return false;
+	}
+	if (!Reader.CanRead(MeshNode->TangentTanCount, sizeof(FVector)))
 	{
 		return false;
 	}
+	MeshNode->TangentTanTable.Reserve(MeshNode->TangentTanTable.Num() + MeshNode->TangentTanCount);
 	for (int i = 0; i < MeshNode->TangentTanCount; i++)
 	{
 		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
+		if (!Reader.Read(Point))
 		{
 			return false;
 		}
 		MeshNode->TangentTanTable.Add(FVector4(Point));
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TangentBinCount, sizeof(MeshNode->TangentBinCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TangentBinCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TangentBinCount; i++)
+	if (!Reader.ReadArray(MeshNode->TangentBinCount, MeshNode->TangentBinTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TangentBinTable.Add(Point);
+		return false;
 	}
 
-	if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&MeshNode->TexCoordCount, sizeof(MeshNode->TexCoordCount), BinaryData, Offset))
+	if (!Reader.Read(MeshNode->TexCoordCount))
 	{
 		return false;
 	}
-	for (int i = 0; i < MeshNode->TexCoordCount; i++)
+	if (!Reader.ReadArray(MeshNode->TexCoordCount, MeshNode->TexCoordTable))
 	{
-		FVector Point;
-		if (!URaiderzXmlUtilities::WriteBinaryDataToBuffer(&Point, sizeof(Point), BinaryData, Offset))
-		{
-			return false;
-		}
-		MeshNode->TexCoordTable.Add(Point);
+		return false;
 	}
 
 	return true;
@@ -0,0 +1,399 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "EluMeshOptimizer.h"
+#include "EOD.h"
+
+#include "RawMesh.h"
+#include "Misc/Crc.h"
+
+/** The attributes of a wedge the static mesh builder welds by. Compared bitwise, so it must not have padding */
+struct FEluWedgeKey
+{
+	uint32 Position;
+	FVector TangentX;
+	FVector TangentY;
+	FVector TangentZ;
+	FVector2D UVs[MAX_MESH_TEXTURE_COORDS];
+	FColor Color;
+
+	FORCEINLINE bool operator==(const FEluWedgeKey& Other) const
+	{
+		return FMemory::Memcmp(this, &Other, sizeof(FEluWedgeKey)) == 0;
+	}
+
+	FORCEINLINE friend uint32 GetTypeHash(const FEluWedgeKey& Key)
+	{
+		return FCrc::MemCrc32(&Key, sizeof(FEluWedgeKey));
+	}
+};
+
+static_assert(sizeof(FEluWedgeKey) == sizeof(uint32) + sizeof(FVector) * 3 + sizeof(FVector2D) * MAX_MESH_TEXTURE_COORDS + sizeof(FColor), "FEluWedgeKey must not have padding");
+
+/** Moves the per face entries of Array into NewFaceOrder. Streams the mesh doesn't have are left empty */
+template<typename T>
+static void PermuteFaceStream(TArray<T>& Array, const TArray<int32>& NewFaceOrder, int32 NumPerFace)
+{
+	if (Array.Num() != NewFaceOrder.Num() * NumPerFace)
+	{
+		return;
+	}
+
+	TArray<T> Permuted;
+	Permuted.SetNumUninitialized(Array.Num());
+	for (int32 NewIndex = 0; NewIndex < NewFaceOrder.Num(); ++NewIndex)
+	{
+		FMemory::Memcpy(&Permuted[NewIndex * NumPerFace], &Array[NewFaceOrder[NewIndex] * NumPerFace], sizeof(T) * NumPerFace);
+	}
+	Array = MoveTemp(Permuted);
+}
+
+void FEluMeshOptimizer::OptimizeRawMesh(FRawMesh& RawMesh, const FString& MeshName)
+{
+	const int32 NumPositions = RawMesh.VertexPositions.Num();
+	const int32 NumWeldedPositions = NumPositions - WeldVertexPositions(RawMesh);
+
+	TArray<int32> VertexIDs;
+	const int32 NumVertices = GetWedgeVertexIDs(RawMesh, VertexIDs);
+	const float ACMRBefore = ComputeACMR(VertexIDs, NumVertices);
+
+	OptimizeFaceOrder(RawMesh);
+
+	GetWedgeVertexIDs(RawMesh, VertexIDs);
+	const float ACMRAfter = ComputeACMR(VertexIDs, NumVertices);
+
+	PrintLog(FString::Printf(
+		TEXT("Optimized %s: %d positions welded to %d, %d wedges share %d vertices, ACMR %.3f -> %.3f"),
+		*MeshName,
+		NumPositions,
+		NumWeldedPositions,
+		RawMesh.WedgeIndices.Num(),
+		NumVertices,
+		ACMRBefore,
+		ACMRAfter));
+}
+
+int32 FEluMeshOptimizer::WeldVertexPositions(FRawMesh& RawMesh)
+{
+	const int32 NumPositions = RawMesh.VertexPositions.Num();
+
+	TBitArray<> UsedPositions(false, NumPositions);
+	for (uint32 WedgeIndex : RawMesh.WedgeIndices)
+	{
+		if ((int32)WedgeIndex < NumPositions)
+		{
+			UsedPositions[WedgeIndex] = true;
+		}
+	}
+
+	TArray<int32> PositionRemap;
+	PositionRemap.Init(INDEX_NONE, NumPositions);
+
+	TArray<FVector> WeldedPositions;
+	WeldedPositions.Reserve(NumPositions);
+
+	TMap<FVector, int32> UniquePositions;
+	UniquePositions.Reserve(NumPositions);
+
+	for (int32 Index = 0; Index < NumPositions; ++Index)
+	{
+		if (!UsedPositions[Index])
+		{
+			continue;
+		}
+
+		const FVector& Position = RawMesh.VertexPositions[Index];
+		if (const int32* WeldedIndex = UniquePositions.Find(Position))
+		{
+			PositionRemap[Index] = *WeldedIndex;
+		}
+		else
+		{
+			const int32 NewIndex = WeldedPositions.Add(Position);
+			UniquePositions.Add(Position, NewIndex);
+			PositionRemap[Index] = NewIndex;
+		}
+	}
+
+	for (uint32& WedgeIndex : RawMesh.WedgeIndices)
+	{
+		if ((int32)WedgeIndex < NumPositions)
+		{
+			WedgeIndex = (uint32)PositionRemap[WedgeIndex];
+		}
+	}
+
+	RawMesh.VertexPositions = MoveTemp(WeldedPositions);
+	return NumPositions - RawMesh.VertexPositions.Num();
+}
+
+int32 FEluMeshOptimizer::GetWedgeVertexIDs(const FRawMesh& RawMesh, TArray<int32>& OutVertexIDs)
+{
+	const int32 NumWedges = RawMesh.WedgeIndices.Num();
+
+	// Optional streams are either empty or have an entry per wedge
+	const bool bHasTangentX = RawMesh.WedgeTangentX.Num() == NumWedges;
+	const bool bHasTangentY = RawMesh.WedgeTangentY.Num() == NumWedges;
+	const bool bHasTangentZ = RawMesh.WedgeTangentZ.Num() == NumWedges;
+	const bool bHasColors = RawMesh.WedgeColors.Num() == NumWedges;
+
+	OutVertexIDs.SetNumUninitialized(NumWedges);
+
+	TMap<FEluWedgeKey, int32> UniqueVertices;
+	UniqueVertices.Reserve(NumWedges);
+
+	FEluWedgeKey Key;
+	FMemory::Memzero(Key);
+	for (int32 WedgeIndex = 0; WedgeIndex < NumWedges; ++WedgeIndex)
+	{
+		Key.Position = RawMesh.WedgeIndices[WedgeIndex];
+		Key.TangentX = bHasTangentX ? RawMesh.WedgeTangentX[WedgeIndex] : FVector::ZeroVector;
+		Key.TangentY = bHasTangentY ? RawMesh.WedgeTangentY[WedgeIndex] : FVector::ZeroVector;
+		Key.TangentZ = bHasTangentZ ? RawMesh.WedgeTangentZ[WedgeIndex] : FVector::ZeroVector;
+		Key.Color = bHasColors ? RawMesh.WedgeColors[WedgeIndex] : FColor(0, 0, 0, 0);
+		for (int32 UVIndex = 0; UVIndex < MAX_MESH_TEXTURE_COORDS; ++UVIndex)
+		{
+			const TArray<FVector2D>& TexCoords = RawMesh.WedgeTexCoords[UVIndex];
+			Key.UVs[UVIndex] = TexCoords.Num() == NumWedges ? TexCoords[WedgeIndex] : FVector2D::ZeroVector;
+		}
+
+		if (const int32* VertexID = UniqueVertices.Find(Key))
+		{
+			OutVertexIDs[WedgeIndex] = *VertexID;
+		}
+		else
+		{
+			OutVertexIDs[WedgeIndex] = UniqueVertices.Add(Key, UniqueVertices.Num());
+		}
+	}
+
+	return UniqueVertices.Num();
+}
+
+void FEluMeshOptimizer::OptimizeFaceOrder(FRawMesh& RawMesh, int32 CacheSize)
+{
+	const int32 NumFaces = RawMesh.FaceMaterialIndices.Num();
+	if (NumFaces == 0 || RawMesh.WedgeIndices.Num() != NumFaces * 3)
+	{
+		return;
+	}
+
+	TArray<int32> VertexIDs;
+	const int32 NumVertices = GetWedgeVertexIDs(RawMesh, VertexIDs);
+
+	// The builder splits faces into sections by material, so only the order within a material matters
+	TArray<int32> MaterialOrder;
+	TMap<int32, TArray<int32>> MaterialFaces;
+	for (int32 FaceIndex = 0; FaceIndex < NumFaces; ++FaceIndex)
+	{
+		const int32 MaterialIndex = RawMesh.FaceMaterialIndices[FaceIndex];
+		TArray<int32>* Faces = MaterialFaces.Find(MaterialIndex);
+		if (!Faces)
+		{
+			MaterialOrder.Add(MaterialIndex);
+			Faces = &MaterialFaces.Add(MaterialIndex);
+		}
+		Faces->Add(FaceIndex);
+	}
+
+	TArray<int32> NewFaceOrder;
+	NewFaceOrder.Reserve(NumFaces);
+
+	TArray<int32> LocalVertexIDs;
+	LocalVertexIDs.Init(INDEX_NONE, NumVertices);
+	TArray<int32> LocalIndices;
+	TArray<int32> TriangleOrder;
+
+	for (int32 MaterialIndex : MaterialOrder)
+	{
+		const TArray<int32>& Faces = MaterialFaces.FindChecked(MaterialIndex);
+
+		// Tipsify wants the vertices of the triangle list numbered from 0 without gaps
+		int32 NumLocalVertices = 0;
+		LocalIndices.Reset();
+		for (int32 FaceIndex : Faces)
+		{
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				const int32 VertexID = VertexIDs[FaceIndex * 3 + Corner];
+				if (LocalVertexIDs[VertexID] == INDEX_NONE)
+				{
+					LocalVertexIDs[VertexID] = NumLocalVertices++;
+				}
+				LocalIndices.Add(LocalVertexIDs[VertexID]);
+			}
+		}
+
+		TipsifyTriangles(LocalIndices, NumLocalVertices, CacheSize, TriangleOrder);
+		for (int32 Triangle : TriangleOrder)
+		{
+			NewFaceOrder.Add(Faces[Triangle]);
+		}
+
+		for (int32 FaceIndex : Faces)
+		{
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				LocalVertexIDs[VertexIDs[FaceIndex * 3 + Corner]] = INDEX_NONE;
+			}
+		}
+	}
+
+	check(NewFaceOrder.Num() == NumFaces);
+
+	PermuteFaceStream(RawMesh.FaceMaterialIndices, NewFaceOrder, 1);
+	PermuteFaceStream(RawMesh.FaceSmoothingMasks, NewFaceOrder, 1);
+	PermuteFaceStream(RawMesh.WedgeIndices, NewFaceOrder, 3);
+	PermuteFaceStream(RawMesh.WedgeTangentX, NewFaceOrder, 3);
+	PermuteFaceStream(RawMesh.WedgeTangentY, NewFaceOrder, 3);
+	PermuteFaceStream(RawMesh.WedgeTangentZ, NewFaceOrder, 3);
+	PermuteFaceStream(RawMesh.WedgeColors, NewFaceOrder, 3);
+	for (int32 UVIndex = 0; UVIndex < MAX_MESH_TEXTURE_COORDS; ++UVIndex)
+	{
+		PermuteFaceStream(RawMesh.WedgeTexCoords[UVIndex], NewFaceOrder, 3);
+	}
+}
+
+float FEluMeshOptimizer::ComputeACMR(const TArray<int32>& Indices, int32 NumVertices, int32 CacheSize)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	if (NumTriangles == 0)
+	{
+		return 0.f;
+	}
+
+	// A vertex is in the FIFO cache if fewer than CacheSize misses happened since it was loaded
+	TArray<int32> LoadTimes;
+	LoadTimes.Init(-CacheSize - 1, NumVertices);
+
+	int32 NumMisses = 0;
+	for (int32 Vertex : Indices)
+	{
+		if (NumMisses - LoadTimes[Vertex] >= CacheSize)
+		{
+			LoadTimes[Vertex] = NumMisses++;
+		}
+	}
+
+	return (float)NumMisses / NumTriangles;
+}
+
+void FEluMeshOptimizer::TipsifyTriangles(const TArray<int32>& Indices, int32 NumVertices, int32 CacheSize, TArray<int32>& OutTriangleOrder)
+{
+	const int32 NumTriangles = Indices.Num() / 3;
+	OutTriangleOrder.Reset(NumTriangles);
+	if (NumTriangles == 0)
+	{
+		return;
+	}
+
+	// Triangles using each vertex, packed into one array with AdjacencyStarts[Vertex] pointing at the first of them
+	TArray<int32> AdjacencyStarts;
+	AdjacencyStarts.SetNumZeroed(NumVertices + 1);
+	for (int32 Vertex : Indices)
+	{
+		AdjacencyStarts[Vertex + 1]++;
+	}
+	for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+	{
+		AdjacencyStarts[Vertex + 1] += AdjacencyStarts[Vertex];
+	}
+
+	TArray<int32> Adjacency;
+	Adjacency.SetNumUninitialized(Indices.Num());
+	TArray<int32> AdjacencyEnds(AdjacencyStarts.GetData(), NumVertices);
+	for (int32 Index = 0; Index < Indices.Num(); ++Index)
+	{
+		Adjacency[AdjacencyEnds[Indices[Index]]++] = Index / 3;
+	}
+
+	TArray<int32> LiveTriangles;
+	LiveTriangles.SetNumUninitialized(NumVertices);
+	for (int32 Vertex = 0; Vertex < NumVertices; ++Vertex)
+	{
+		LiveTriangles[Vertex] = AdjacencyStarts[Vertex + 1] - AdjacencyStarts[Vertex];
+	}
+
+	TArray<int32> CacheTimeStamps;
+	CacheTimeStamps.SetNumZeroed(NumVertices);
+
+	TBitArray<> EmittedTriangles(false, NumTriangles);
+	TArray<int32> DeadEndStack;
+	TArray<int32> Candidates;
+
+	int32 FanningVertex = 0;
+	int32 TimeStamp = CacheSize + 1;
+	int32 Cursor = 1;
+
+	while (FanningVertex >= 0)
+	{
+		// Emit every remaining triangle around the fanning vertex
+		Candidates.Reset();
+		for (int32 AdjacencyIndex = AdjacencyStarts[FanningVertex]; AdjacencyIndex < AdjacencyStarts[FanningVertex + 1]; ++AdjacencyIndex)
+		{
+			const int32 Triangle = Adjacency[AdjacencyIndex];
+			if (EmittedTriangles[Triangle])
+			{
+				continue;
+			}
+
+			for (int32 Corner = 0; Corner < 3; ++Corner)
+			{
+				const int32 Vertex = Indices[Triangle * 3 + Corner];
+				DeadEndStack.Push(Vertex);
+				Candidates.Add(Vertex);
+				LiveTriangles[Vertex]--;
+
+				if (TimeStamp - CacheTimeStamps[Vertex] > CacheSize)
+				{
+					CacheTimeStamps[Vertex] = TimeStamp++;
+				}
+			}
+
+			EmittedTriangles[Triangle] = true;
+			OutTriangleOrder.Add(Triangle);
+		}
+
+		// Fan around the candidate that is still in the cache and will stay there the longest while its triangles are emitted
+		int32 NextVertex = INDEX_NONE;
+		int32 BestPriority = -1;
+		for (int32 Vertex : Candidates)
+		{
+			if (LiveTriangles[Vertex] <= 0)
+			{
+				continue;
+			}
+
+			int32 Priority = 0;
+			if (TimeStamp - CacheTimeStamps[Vertex] + 2 * LiveTriangles[Vertex] <= CacheSize)
+			{
+				Priority = TimeStamp - CacheTimeStamps[Vertex];
+			}
+
+			if (Priority > BestPriority)
+			{
+				BestPriority = Priority;
+				NextVertex = Vertex;
+			}
+		}
+
+		// Dead end. Continue from the most recently used vertex that still has triangles, or failing that the next one in input order
+		while (NextVertex == INDEX_NONE && DeadEndStack.Num() > 0)
+		{
+			const int32 Vertex = DeadEndStack.Pop(false);
+			if (LiveTriangles[Vertex] > 0)
+			{
+				NextVertex = Vertex;
+			}
+		}
+		while (NextVertex == INDEX_NONE && Cursor < NumVertices)
+		{
+			if (LiveTriangles[Cursor] > 0)
+			{
+				NextVertex = Cursor;
+			}
+			++Cursor;
+		}
+
+		FanningVertex = NextVertex;
+	}
+}
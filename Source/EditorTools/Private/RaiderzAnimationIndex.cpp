@@ -0,0 +1,137 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzAnimationIndex.h"
+#include "EOD.h"
+
+#include "AssetRegistryModule.h"
+#include "Animation/AnimSequenceBase.h"
+
+FRaiderzAnimationIndex& FRaiderzAnimationIndex::Get()
+{
+	static FRaiderzAnimationIndex Index;
+	return Index;
+}
+
+FRaiderzAnimationIndex::FRaiderzAnimationIndex() :
+	bInitialized(false)
+{
+}
+
+TArray<FAssetData> FRaiderzAnimationIndex::GetAnimationsForSkeleton(const FSoftObjectPath& SkeletonPath)
+{
+	ConditionalInitialize();
+	const TArray<FAssetData>* Animations = SkeletonAnimations.Find(SkeletonPath);
+	return Animations ? *Animations : TArray<FAssetData>();
+}
+
+void FRaiderzAnimationIndex::Shutdown()
+{
+	if (!bInitialized)
+	{
+		return;
+	}
+
+	if (FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+	}
+
+	SkeletonAnimations.Empty();
+	AnimationSkeletons.Empty();
+	bInitialized = false;
+}
+
+void FRaiderzAnimationIndex::ConditionalInitialize()
+{
+	if (bInitialized)
+	{
+		return;
+	}
+	bInitialized = true;
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	// Assets the registry discovers after this (e.g. while it's still scanning on editor startup) come in through OnAssetAdded
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FRaiderzAnimationIndex::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FRaiderzAnimationIndex::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FRaiderzAnimationIndex::OnAssetRenamed);
+
+	TArray<FAssetData> AllAnimations;
+	AssetRegistry.GetAssetsByClass(UAnimSequenceBase::StaticClass()->GetFName(), AllAnimations, true);
+
+	AnimationSkeletons.Reserve(AllAnimations.Num());
+	for (const FAssetData& AssetData : AllAnimations)
+	{
+		AddAnimation(AssetData);
+	}
+
+	PrintLog(FString::Printf(TEXT("Indexed %d animations of %d skeletons"), AnimationSkeletons.Num(), SkeletonAnimations.Num()));
+}
+
+void FRaiderzAnimationIndex::AddAnimation(const FAssetData& AssetData)
+{
+	FAssetDataTagMapSharedView::FFindTagResult TagResult = AssetData.TagsAndValues.FindTag(TEXT("Skeleton"));
+	if (!TagResult.IsSet())
+	{
+		return;
+	}
+
+	FSoftObjectPath SkeletonPath(TagResult.GetValue());
+	if (!SkeletonPath.IsValid())
+	{
+		return;
+	}
+
+	// The same asset can be reported again, e.g. when the registry finishes scanning a path it already had cached
+	RemoveAnimation(AssetData.ObjectPath);
+
+	SkeletonAnimations.FindOrAdd(SkeletonPath).Add(AssetData);
+	AnimationSkeletons.Add(AssetData.ObjectPath, SkeletonPath);
+}
+
+void FRaiderzAnimationIndex::RemoveAnimation(const FName& ObjectPath)
+{
+	FSoftObjectPath SkeletonPath;
+	if (!AnimationSkeletons.RemoveAndCopyValue(ObjectPath, SkeletonPath))
+	{
+		return;
+	}
+
+	TArray<FAssetData>& Animations = SkeletonAnimations.FindChecked(SkeletonPath);
+	Animations.RemoveAll([&ObjectPath](const FAssetData& AssetData) { return AssetData.ObjectPath == ObjectPath; });
+	if (Animations.Num() == 0)
+	{
+		SkeletonAnimations.Remove(SkeletonPath);
+	}
+}
+
+bool FRaiderzAnimationIndex::IsAnimationAsset(const FAssetData& AssetData)
+{
+	UClass* AssetClass = AssetData.GetClass();
+	return AssetClass && AssetClass->IsChildOf(UAnimSequenceBase::StaticClass());
+}
+
+void FRaiderzAnimationIndex::OnAssetAdded(const FAssetData& AssetData)
+{
+	if (IsAnimationAsset(AssetData))
+	{
+		AddAnimation(AssetData);
+	}
+}
+
+void FRaiderzAnimationIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	RemoveAnimation(AssetData.ObjectPath);
+}
+
+void FRaiderzAnimationIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	RemoveAnimation(FName(*OldObjectPath));
+	if (IsAnimationAsset(AssetData))
+	{
+		AddAnimation(AssetData);
+	}
+}
@@ -0,0 +1,156 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzBinaryReader.h"
+
+#include "Misc/FileHelper.h"
+#include "HAL/PlatformFilemanager.h"
+
+FRaiderzBinaryReader::FRaiderzBinaryReader() :
+	Data(nullptr),
+	Size(0),
+	Offset(0)
+{
+}
+
+FRaiderzBinaryReader::FRaiderzBinaryReader(const uint8* InData, int64 InSize) :
+	Data(InData),
+	Size(InData ? InSize : 0),
+	Offset(0)
+{
+	check(Size <= MAX_uint32);
+}
+
+FRaiderzBinaryReader::~FRaiderzBinaryReader()
+{
+	Close();
+}
+
+bool FRaiderzBinaryReader::OpenFile(const FString& FilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFileHandle.Reset(PlatformFile.OpenMapped(*FilePath));
+	if (MappedFileHandle.IsValid() && MappedFileHandle->GetFileSize() > 0)
+	{
+		MappedFileRegion.Reset(MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+	}
+
+	if (MappedFileRegion.IsValid())
+	{
+		Data = MappedFileRegion->GetMappedPtr();
+		Size = MappedFileRegion->GetMappedSize();
+	}
+	else
+	{
+		MappedFileHandle.Reset();
+		if (!FFileHelper::LoadFileToArray(FallbackData, *FilePath))
+		{
+			return false;
+		}
+
+		Data = FallbackData.GetData();
+		Size = FallbackData.Num();
+	}
+
+	// Offsets into RaiderZ files are 32 bit
+	if (Size > MAX_uint32)
+	{
+		Close();
+		return false;
+	}
+
+	return Data != nullptr;
+}
+
+void FRaiderzBinaryReader::Close()
+{
+	// The region has to be unmapped before its file handle gets closed
+	MappedFileRegion.Reset();
+	MappedFileHandle.Reset();
+	FallbackData.Empty();
+
+	Data = nullptr;
+	Size = 0;
+	Offset = 0;
+}
+
+bool FRaiderzBinaryReader::Skip(uint32 NumBytes)
+{
+	if ((int64)NumBytes > GetRemainingSize())
+	{
+		return false;
+	}
+
+	Offset += NumBytes;
+	return true;
+}
+
+bool FRaiderzBinaryReader::Read(void* Buffer, uint32 NumBytes)
+{
+	if (NumBytes == 0)
+	{
+		return true;
+	}
+
+	if ((int64)NumBytes > GetRemainingSize())
+	{
+		return false;
+	}
+
+	FMemory::Memcpy(Buffer, Data + Offset, NumBytes);
+	Offset += NumBytes;
+	return true;
+}
+
+bool FRaiderzBinaryReader::ReadString(FString& OutString)
+{
+	TArrayView<const ANSICHAR> Chars;
+	if (!ReadStringView(Chars))
+	{
+		return false;
+	}
+
+	OutString = FString(Chars.Num(), Chars.GetData());
+	return true;
+}
+
+bool FRaiderzBinaryReader::ReadName(FName& OutName)
+{
+	TArrayView<const ANSICHAR> Chars;
+	if (!ReadStringView(Chars))
+	{
+		return false;
+	}
+
+	OutName = Chars.Num() > 0 ? FName(Chars.Num(), Chars.GetData()) : NAME_None;
+	return true;
+}
+
+bool FRaiderzBinaryReader::ReadStringView(TArrayView<const ANSICHAR>& OutChars)
+{
+	const uint32 StartOffset = Offset;
+
+	int32 StringLength = 0;
+	if (!Read(StringLength))
+	{
+		return false;
+	}
+
+	TArrayView<const ANSICHAR> Chars;
+	if (!ReadView(StringLength, Chars))
+	{
+		Offset = StartOffset;
+		return false;
+	}
+
+	// Stored strings may or may not include their null terminator
+	int32 NumChars = 0;
+	while (NumChars < Chars.Num() && Chars[NumChars] != '\0')
+	{
+		++NumChars;
+	}
+
+	OutChars = Chars.Slice(0, NumChars);
+	return true;
+}
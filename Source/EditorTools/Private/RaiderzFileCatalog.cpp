@@ -0,0 +1,310 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzFileCatalog.h"
+#include "EOD.h"
+#include "RaiderzXmlUtilities.h"
+
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Templates/UniquePtr.h"
+
+/** Bump whenever the layout of the saved catalog changes */
+static const int32 RaiderzFileCatalogVersion = 2;
+
+const double FRaiderzFileCatalog::MinRefreshInterval = 10.0;
+
+FRaiderzFileCatalog& FRaiderzFileCatalog::Get()
+{
+	static FRaiderzFileCatalog Catalog;
+	return Catalog;
+}
+
+FRaiderzFileCatalog::FRaiderzFileCatalog() :
+	LastRefreshTime(0.0),
+	bInitialized(false),
+	bDirty(false)
+{
+}
+
+bool FRaiderzFileCatalog::FindFilePath(const FString& FileName, FString& OutFilePath)
+{
+	FRaiderzFileEntry Entry;
+	if (FindFile(FileName, Entry))
+	{
+		OutFilePath = Entry.Path;
+		return true;
+	}
+	return false;
+}
+
+bool FRaiderzFileCatalog::FindFile(const FString& FileName, FRaiderzFileEntry& OutEntry)
+{
+	FScopeLock Lock(&CatalogCritical);
+	ConditionalInitialize();
+
+	const FString FileKey = GetFileKey(FileName);
+	if (FindFile_Locked(FileKey, OutEntry))
+	{
+		return true;
+	}
+
+	// The file may have been added since the last refresh
+	if (FPlatformTime::Seconds() - LastRefreshTime < MinRefreshInterval)
+	{
+		return false;
+	}
+
+	Refresh_Locked();
+	return FindFile_Locked(FileKey, OutEntry);
+}
+
+void FRaiderzFileCatalog::Refresh()
+{
+	FScopeLock Lock(&CatalogCritical);
+	if (!bInitialized)
+	{
+		bInitialized = true;
+		Load();
+	}
+	Refresh_Locked();
+}
+
+FString FRaiderzFileCatalog::GetFileKey(const FString& FileName)
+{
+	return FPaths::GetCleanFilename(FileName).ToLower();
+}
+
+FString FRaiderzFileCatalog::GetCatalogFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("RaiderZ") / TEXT("FileCatalog.bin");
+}
+
+void FRaiderzFileCatalog::ConditionalInitialize()
+{
+	if (!bInitialized)
+	{
+		bInitialized = true;
+		Load();
+		Refresh_Locked();
+	}
+}
+
+bool FRaiderzFileCatalog::FindFile_Locked(const FString& FileKey, FRaiderzFileEntry& OutEntry)
+{
+	TArray<FRaiderzFileEntry>* Entries = Files.Find(FileKey);
+	if (!Entries)
+	{
+		return false;
+	}
+
+	while (Entries->Num() > 0)
+	{
+		FRaiderzFileEntry& Entry = (*Entries)[0];
+		FFileStatData FileStat = IFileManager::Get().GetStatData(*Entry.Path);
+		if (!FileStat.bIsValid || FileStat.bIsDirectory)
+		{
+			// The file got removed or renamed, so fall back to the next file of the same name. Its folder gets re-listed on the next refresh
+			Entries->RemoveAt(0);
+			bDirty = true;
+			continue;
+		}
+
+		if (FileStat.ModificationTime != Entry.ModificationTime || FileStat.FileSize != Entry.Size)
+		{
+			Entry.ModificationTime = FileStat.ModificationTime;
+			Entry.Size = FileStat.FileSize;
+			bDirty = true;
+		}
+
+		OutEntry = Entry;
+		return true;
+	}
+
+	Files.Remove(FileKey);
+	return false;
+}
+
+void FRaiderzFileCatalog::Refresh_Locked()
+{
+	LastRefreshTime = FPlatformTime::Seconds();
+
+	RefreshFolder(URaiderzXmlUtilities::DataFolderPath);
+
+	if (bDirty)
+	{
+		Save();
+	}
+}
+
+void FRaiderzFileCatalog::RefreshFolder(const FString& FolderPath)
+{
+	FFileStatData FolderStat = IFileManager::Get().GetStatData(*FolderPath);
+	if (!FolderStat.bIsValid || !FolderStat.bIsDirectory)
+	{
+		RemoveFolder(FolderPath);
+		return;
+	}
+
+	FRaiderzFolderEntry* Folder = Folders.Find(FolderPath);
+	if (!Folder || Folder->ModificationTime != FolderStat.ModificationTime)
+	{
+		ScanFolder(FolderPath, FolderStat.ModificationTime);
+	}
+
+	// Copied because refreshing child folders adds to Folders, which can invalidate references into it
+	const TArray<FString> SubFolders = Folders.FindChecked(FolderPath).SubFolders;
+	for (const FString& SubFolder : SubFolders)
+	{
+		RefreshFolder(FolderPath / SubFolder);
+	}
+}
+
+void FRaiderzFileCatalog::ScanFolder(const FString& FolderPath, const FDateTime& FolderModificationTime)
+{
+	FRaiderzFolderEntry NewFolder;
+	NewFolder.ModificationTime = FolderModificationTime;
+
+	IFileManager::Get().IterateDirectoryStat(*FolderPath, [this, &NewFolder](const TCHAR* Path, const FFileStatData& StatData)
+	{
+		const FString Name = FPaths::GetCleanFilename(Path);
+		if (StatData.bIsDirectory)
+		{
+			NewFolder.SubFolders.Add(Name);
+			return true;
+		}
+
+		const FString FileKey = Name.ToLower();
+		NewFolder.FileKeys.Add(FileKey);
+
+		TArray<FRaiderzFileEntry>& Entries = Files.FindOrAdd(FileKey);
+		FRaiderzFileEntry* Entry = Entries.FindByPredicate([Path](const FRaiderzFileEntry& Other) { return Other.Path == Path; });
+		if (!Entry)
+		{
+			Entry = &Entries.AddDefaulted_GetRef();
+			Entry->Path = Path;
+		}
+
+		Entry->ModificationTime = StatData.ModificationTime;
+		Entry->Size = StatData.FileSize;
+		return true;
+	});
+
+	TArray<FString> RemovedSubFolders;
+	if (const FRaiderzFolderEntry* OldFolder = Folders.Find(FolderPath))
+	{
+		TSet<FString> NewFileKeys(NewFolder.FileKeys);
+		for (const FString& FileKey : OldFolder->FileKeys)
+		{
+			if (!NewFileKeys.Contains(FileKey))
+			{
+				RemoveFileIfInFolder(FileKey, FolderPath);
+			}
+		}
+
+		for (const FString& SubFolder : OldFolder->SubFolders)
+		{
+			if (!NewFolder.SubFolders.Contains(SubFolder))
+			{
+				RemovedSubFolders.Add(FolderPath / SubFolder);
+			}
+		}
+	}
+
+	Folders.Add(FolderPath, MoveTemp(NewFolder));
+	for (const FString& RemovedSubFolder : RemovedSubFolders)
+	{
+		RemoveFolder(RemovedSubFolder);
+	}
+
+	bDirty = true;
+}
+
+void FRaiderzFileCatalog::RemoveFolder(const FString& FolderPath)
+{
+	FRaiderzFolderEntry Folder;
+	if (!Folders.RemoveAndCopyValue(FolderPath, Folder))
+	{
+		return;
+	}
+
+	for (const FString& FileKey : Folder.FileKeys)
+	{
+		RemoveFileIfInFolder(FileKey, FolderPath);
+	}
+
+	for (const FString& SubFolder : Folder.SubFolders)
+	{
+		RemoveFolder(FolderPath / SubFolder);
+	}
+
+	bDirty = true;
+}
+
+void FRaiderzFileCatalog::RemoveFileIfInFolder(const FString& FileKey, const FString& FolderPath)
+{
+	TArray<FRaiderzFileEntry>* Entries = Files.Find(FileKey);
+	if (!Entries)
+	{
+		return;
+	}
+
+	int32 NumRemoved = Entries->RemoveAll([&FolderPath](const FRaiderzFileEntry& Entry) { return FPaths::GetPath(Entry.Path) == FolderPath; });
+	if (Entries->Num() == 0)
+	{
+		Files.Remove(FileKey);
+	}
+	bDirty = bDirty || NumRemoved > 0;
+}
+
+void FRaiderzFileCatalog::Load()
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetCatalogFilePath()));
+	if (!Reader.IsValid())
+	{
+		return;
+	}
+
+	int32 Version = 0;
+	FString RootPath;
+	*Reader << Version;
+	if (Version != RaiderzFileCatalogVersion)
+	{
+		return;
+	}
+
+	// A catalog of a different data folder is useless
+	*Reader << RootPath;
+	if (RootPath != URaiderzXmlUtilities::DataFolderPath)
+	{
+		return;
+	}
+
+	*Reader << Folders << Files;
+	if (Reader->IsError())
+	{
+		PrintWarning(TEXT("RaiderZ file catalog is corrupt and will be rebuilt"));
+		Folders.Empty();
+		Files.Empty();
+	}
+}
+
+void FRaiderzFileCatalog::Save()
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetCatalogFilePath()));
+	if (!Writer.IsValid())
+	{
+		PrintWarning(TEXT("Failed to save RaiderZ file catalog to: ") + GetCatalogFilePath());
+		return;
+	}
+
+	int32 Version = RaiderzFileCatalogVersion;
+	FString RootPath = URaiderzXmlUtilities::DataFolderPath;
+	*Writer << Version << RootPath << Folders << Files;
+
+	if (Writer->Close())
+	{
+		bDirty = false;
+	}
+}
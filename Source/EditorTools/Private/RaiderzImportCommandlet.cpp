@@ -0,0 +1,634 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+
+#include "RaiderzImportCommandlet.h"
+#include "EOD.h"
+#include "EluImporter.h"
+#include "SoundImporter.h"
+#include "CollisionImporter.h"
+#include "RaiderzXmlUtilities.h"
+#include "EditorFunctionLibrary.h"
+
+#include "PackageTools.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "HAL/FileManager.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/SkeletalMesh.h"
+#include "Animation/Skeleton.h"
+#include "Animation/AnimBoneCompressionSettings.h"
+#include "Animation/AnimSequence.h"
+#include "Sound/SoundAttenuation.h"
+
+URaiderzImportCommandlet::URaiderzImportCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+
+	SkeletonOverride = nullptr;
+	AnimCompressionSettings = nullptr;
+	BatchSize = 64;
+	bForceImport = false;
+	NumImportedAssets = 0;
+	NumUpToDateAssets = 0;
+	NumSkippedSkinnedMeshes = 0;
+}
+
+int32 URaiderzImportCommandlet::Main(const FString& Params)
+{
+	TArray<FString> EluFiles;
+	TArray<FString> AniFiles;
+	if (!GatherSourceFiles(Params, EluFiles, AniFiles))
+	{
+		PrintError(TEXT("RaiderzImport needs either -Dir=<folder> or -Manifest=<file>"));
+		return 1;
+	}
+
+	DestinationPath = TEXT("/Game/RaiderZ/Imported");
+	FParse::Value(*Params, TEXT("Dest="), DestinationPath);
+	DestinationPath.RemoveFromEnd(TEXT("/"));
+
+	FParse::Value(*Params, TEXT("BatchSize="), BatchSize);
+	BatchSize = FMath::Max(BatchSize, 1);
+
+	bForceImport = FParse::Param(*Params, TEXT("Force"));
+
+	bool bImportMeshes = FParse::Param(*Params, TEXT("Meshes"));
+	bool bImportAnimations = FParse::Param(*Params, TEXT("Animations"));
+	bool bImportCollision = FParse::Param(*Params, TEXT("Collision"));
+	bool bImportSound = FParse::Param(*Params, TEXT("Sound"));
+	if (!bImportMeshes && !bImportAnimations && !bImportCollision && !bImportSound)
+	{
+		bImportMeshes = bImportAnimations = bImportCollision = bImportSound = true;
+	}
+
+	FString SkeletonPath;
+	if (FParse::Value(*Params, TEXT("Skeleton="), SkeletonPath))
+	{
+		SkeletonOverride = LoadObject<USkeleton>(nullptr, *SkeletonPath);
+		if (!SkeletonOverride)
+		{
+			PrintError(TEXT("Couldn't load skeleton: ") + SkeletonPath);
+			return 1;
+		}
+	}
+
+	USoundAttenuation* Attenuation = nullptr;
+	FString AttenuationPath;
+	if (FParse::Value(*Params, TEXT("Attenuation="), AttenuationPath))
+	{
+		Attenuation = LoadObject<USoundAttenuation>(nullptr, *AttenuationPath);
+		if (!Attenuation)
+		{
+			PrintError(TEXT("Couldn't load sound attenuation: ") + AttenuationPath);
+			return 1;
+		}
+	}
+
+	FString AnimCompressionPath;
+	if (FParse::Value(*Params, TEXT("AnimCompression="), AnimCompressionPath))
+	{
+		AnimCompressionSettings = LoadObject<UAnimBoneCompressionSettings>(nullptr, *AnimCompressionPath);
+		if (!AnimCompressionSettings)
+		{
+			PrintError(TEXT("Couldn't load bone compression settings: ") + AnimCompressionPath);
+			return 1;
+		}
+		AnimationOptions.BoneCompressionSettings = AnimCompressionSettings;
+	}
+
+	FParse::Value(*Params, TEXT("AnimSampleRate="), AnimationOptions.SampleRate);
+	FParse::Value(*Params, TEXT("AnimPosTolerance="), AnimationOptions.PositionTolerance);
+	FParse::Value(*Params, TEXT("AnimRotTolerance="), AnimationOptions.RotationTolerance);
+	if (AnimationOptions.SampleRate <= 0.f)
+	{
+		PrintError(TEXT("-AnimSampleRate has to be positive"));
+		return 1;
+	}
+
+	// Sources that changed since their asset was imported rebuild it
+	AnimationOptions.bReplaceExisting = true;
+	MeshOptions.bReplaceExisting = true;
+
+	MeshOptions.bImportLODs = !FParse::Param(*Params, TEXT("NoMeshLODs"));
+	MeshOptions.bImportSimpleCollision = !FParse::Param(*Params, TEXT("NoSimpleCollision"));
+
+	FString LODScreenSizes;
+	if (FParse::Value(*Params, TEXT("LODScreenSizes="), LODScreenSizes, false))
+	{
+		TArray<FString> ScreenSizes;
+		LODScreenSizes.ParseIntoArray(ScreenSizes, TEXT(","));
+
+		MeshOptions.LODScreenSizes.Reset();
+		for (const FString& ScreenSize : ScreenSizes)
+		{
+			MeshOptions.LODScreenSizes.Add(FCString::Atof(*ScreenSize));
+			if (MeshOptions.LODScreenSizes.Last() <= 0.f)
+			{
+				PrintError(TEXT("-LODScreenSizes has to be a comma separated list of positive numbers"));
+				return 1;
+			}
+		}
+	}
+
+	// Skeletal meshes, animations and sounds are looked up through the asset registry, so it needs to know about everything on disk
+	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	AssetRegistryModule.Get().SearchAllAssets(true);
+
+	UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: found %d elu and %d ani files, importing to %s"), EluFiles.Num(), AniFiles.Num(), *DestinationPath);
+
+	if (bImportMeshes)
+	{
+		ImportMeshes(EluFiles);
+	}
+
+	if (bImportAnimations)
+	{
+		ImportAnimations(AniFiles);
+	}
+
+	if (bImportCollision || bImportSound)
+	{
+		TArray<FString> SourceFiles = EluFiles;
+		SourceFiles.Append(AniFiles);
+		ImportNotifies(SourceFiles, bImportCollision, bImportSound, Attenuation);
+	}
+
+	// Sources that were only touched update their records even if nothing got imported
+	FRaiderzImportManifest::Get().SaveIfDirty();
+
+	UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: imported %d assets, %d were up to date, %d skinned models were skipped, %d files failed"),
+		NumImportedAssets, NumUpToDateAssets, NumSkippedSkinnedMeshes, FailedFiles.Num());
+	for (const FString& FailedFile : FailedFiles)
+	{
+		UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: failed file: %s"), *FailedFile);
+	}
+	return FailedFiles.Num() > 0 ? 1 : 0;
+}
+
+bool URaiderzImportCommandlet::GatherSourceFiles(const FString& Params, TArray<FString>& OutEluFiles, TArray<FString>& OutAniFiles)
+{
+	TArray<FString> SourceFiles;
+
+	FString SourceDir;
+	FString ManifestPath;
+	if (FParse::Value(*Params, TEXT("Dir="), SourceDir))
+	{
+		SourceRootPath = FPaths::ConvertRelativePathToFull(SourceDir);
+		IFileManager::Get().FindFilesRecursive(SourceFiles, *SourceRootPath, TEXT("*.elu"), true, false, false);
+		IFileManager::Get().FindFilesRecursive(SourceFiles, *SourceRootPath, TEXT("*.ani"), true, false, false);
+	}
+	else if (FParse::Value(*Params, TEXT("Manifest="), ManifestPath))
+	{
+		// Manifest entries are usually somewhere below the RaiderZ data folder
+		SourceRootPath = URaiderzXmlUtilities::DataFolderPath;
+
+		TArray<FString> ManifestLines;
+		if (!FFileHelper::LoadFileToStringArray(ManifestLines, *ManifestPath))
+		{
+			PrintError(TEXT("Couldn't read import manifest: ") + ManifestPath);
+			return false;
+		}
+
+		const FString ManifestDir = FPaths::GetPath(FPaths::ConvertRelativePathToFull(ManifestPath));
+		for (const FString& Line : ManifestLines)
+		{
+			FString FilePath = Line.TrimStartAndEnd();
+			if (FilePath.IsEmpty())
+			{
+				continue;
+			}
+
+			if (FPaths::IsRelative(FilePath))
+			{
+				FilePath = ManifestDir / FilePath;
+			}
+			SourceFiles.Add(FilePath);
+		}
+	}
+	else
+	{
+		return false;
+	}
+
+	FPaths::NormalizeDirectoryName(SourceRootPath);
+
+	for (FString& FilePath : SourceFiles)
+	{
+		FPaths::NormalizeFilename(FilePath);
+		if (FilePath.EndsWith(TEXT(".elu")))
+		{
+			OutEluFiles.AddUnique(FilePath);
+		}
+		else if (FilePath.EndsWith(TEXT(".ani")))
+		{
+			OutAniFiles.AddUnique(FilePath);
+		}
+		else
+		{
+			PrintWarning(TEXT("Skipping file that is neither .elu nor .ani: ") + FilePath);
+		}
+	}
+
+	return true;
+}
+
+FString URaiderzImportCommandlet::GetDestinationPackageName(const FString& SourceFilePath, const FString& AssetName) const
+{
+	const FString SourceFolder = FPaths::GetPath(SourceFilePath);
+
+	FString RelativeFolder;
+	if (!SourceRootPath.IsEmpty() && SourceFolder.StartsWith(SourceRootPath))
+	{
+		RelativeFolder = SourceFolder.RightChop(SourceRootPath.Len());
+	}
+	else
+	{
+		RelativeFolder = FPaths::GetCleanFilename(SourceFolder);
+	}
+	RelativeFolder.RemoveFromStart(TEXT("/"));
+
+	return PackageTools::SanitizePackageName(DestinationPath / RelativeFolder / AssetName);
+}
+
+USkeleton* URaiderzImportCommandlet::FindSkeletonForAnimation(const FString& AniFilePath)
+{
+	if (SkeletonOverride)
+	{
+		return SkeletonOverride;
+	}
+
+	const FString SourceFolder = FPaths::GetPath(AniFilePath);
+	if (USkeleton** FoundSkeleton = FolderSkeletons.Find(SourceFolder))
+	{
+		return *FoundSkeleton;
+	}
+
+	USkeletalMesh* SkeletalMesh = FindSkeletalMeshForFolder(SourceFolder);
+	USkeleton* Skeleton = SkeletalMesh ? SkeletalMesh->Skeleton : nullptr;
+	FolderSkeletons.Add(SourceFolder, Skeleton);
+	return Skeleton;
+}
+
+USkeletalMesh* URaiderzImportCommandlet::FindSkeletalMeshForFolder(const FString& FolderPath)
+{
+	if (SkeletalMeshAssets.Num() == 0)
+	{
+		FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		TArray<FAssetData> AllSkeletalMeshes;
+		AssetRegistryModule.Get().GetAssetsByClass(USkeletalMesh::StaticClass()->GetFName(), AllSkeletalMeshes, true);
+
+		for (const FAssetData& AssetData : AllSkeletalMeshes)
+		{
+			SkeletalMeshAssets.Add(AssetData.AssetName, AssetData);
+		}
+	}
+
+	const FString MeshName = TEXT("SK_") + FPaths::GetCleanFilename(FolderPath);
+	const FAssetData* AssetData = SkeletalMeshAssets.Find(FName(*MeshName));
+	return AssetData ? Cast<USkeletalMesh>(AssetData->GetAsset()) : nullptr;
+}
+
+void URaiderzImportCommandlet::MakeImportRecords(
+	const TArray<FString>& SourceFiles,
+	const TArray<FString>& PackageNames,
+	int32 ImporterVersion,
+	const TArray<uint32>& SettingsHashes,
+	TArray<FRaiderzImportRecord>& OutRecords,
+	TArray<bool>& OutUpToDate)
+{
+	check(SourceFiles.Num() == PackageNames.Num() && SourceFiles.Num() == SettingsHashes.Num());
+
+	const int32 NumSources = SourceFiles.Num();
+	OutRecords.SetNum(NumSources);
+	OutUpToDate.Init(false, NumSources);
+
+	// Assets that were deleted get imported again whatever the manifest says
+	TArray<bool> PackageExists;
+	PackageExists.SetNumUninitialized(NumSources);
+	for (int32 Index = 0; Index < NumSources; ++Index)
+	{
+		PackageExists[Index] = FPackageName::DoesPackageExist(PackageNames[Index]);
+	}
+
+	// Changed sources have to be read in full to be hashed, so like parsing this is spread over worker threads
+	FRaiderzImportManifest& Manifest = FRaiderzImportManifest::Get();
+	ParallelFor(NumSources, [&](int32 Index)
+	{
+		OutRecords[Index] = Manifest.MakeRecord(PackageNames[Index], { SourceFiles[Index] }, ImporterVersion, SettingsHashes[Index]);
+		OutUpToDate[Index] = !bForceImport && PackageExists[Index] && Manifest.IsUpToDate(PackageNames[Index], OutRecords[Index]);
+	});
+}
+
+void URaiderzImportCommandlet::ImportMeshes(const TArray<FString>& EluFiles)
+{
+	TArray<FString> CandidateFiles;
+	TArray<FString> CandidatePackageNames;
+	for (const FString& EluFilePath : EluFiles)
+	{
+		// Skinned models have no skeletal mesh import path yet, so they're reported rather than imported as static meshes
+		if (FPaths::FileExists(EluFilePath + TEXT(".animation.xml")))
+		{
+			UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: skipping skinned model, its skeletal mesh has to be imported separately: %s"), *EluFilePath);
+			NumSkippedSkinnedMeshes++;
+			continue;
+		}
+
+		const FString AssetName = TEXT("SM_") + PackageTools::SanitizePackageName(URaiderzXmlUtilities::GetRaiderzBaseFileName(EluFilePath));
+		CandidateFiles.Add(EluFilePath);
+		CandidatePackageNames.Add(GetDestinationPackageName(EluFilePath, AssetName));
+	}
+
+	TArray<uint32> SettingsHashes;
+	SettingsHashes.Init(MeshOptions.GetSettingsHash(), CandidateFiles.Num());
+
+	TArray<FRaiderzImportRecord> CandidateRecords;
+	TArray<bool> UpToDate;
+	MakeImportRecords(CandidateFiles, CandidatePackageNames, UEluImporter::StaticMeshImportVersion, SettingsHashes, CandidateRecords, UpToDate);
+
+	TArray<FString> StaticEluFiles;
+	TArray<FString> PackageNames;
+	TArray<FRaiderzImportRecord> Records;
+	for (int32 Index = 0; Index < CandidateFiles.Num(); ++Index)
+	{
+		if (UpToDate[Index])
+		{
+			NumUpToDateAssets++;
+			continue;
+		}
+		StaticEluFiles.Add(CandidateFiles[Index]);
+		PackageNames.Add(CandidatePackageNames[Index]);
+		Records.Add(MoveTemp(CandidateRecords[Index]));
+	}
+
+	UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: %d/%d meshes are up to date"), CandidateFiles.Num() - StaticEluFiles.Num(), CandidateFiles.Num());
+
+	for (int32 BatchStart = 0; BatchStart < StaticEluFiles.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, StaticEluFiles.Num() - BatchStart);
+
+		// Parsing doesn't touch any UObject so the whole batch can be parsed on worker threads
+		TArray<FEluFileData> BatchData;
+		BatchData.SetNum(BatchNum);
+		ParallelFor(BatchNum, [&](int32 Index)
+		{
+			BatchData[Index] = UEluImporter::LoadEluData(StaticEluFiles[BatchStart + Index]);
+		});
+
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+		{
+			const FString& EluFilePath = StaticEluFiles[BatchStart + Index];
+			if (!BatchData[Index].bLoadSuccess)
+			{
+				RecordFailedFile(EluFilePath, TEXT("Failed to load elu file"));
+				continue;
+			}
+
+			const FString& PackageName = PackageNames[BatchStart + Index];
+			const FString AssetName = FPackageName::GetShortName(PackageName);
+			UStaticMesh* StaticMesh = UEluImporter::CreateStaticMesh(BatchData[Index], PackageName, AssetName, MeshOptions);
+			if (StaticMesh)
+			{
+				PendingRecords.Add(PackageName, MoveTemp(Records[BatchStart + Index]));
+				NumImportedAssets++;
+			}
+			else
+			{
+				RecordFailedFile(EluFilePath, TEXT("Couldn't create a static mesh for elu file"));
+			}
+		}
+
+		BatchData.Empty();
+		SaveDirtyPackages();
+
+		UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: processed %d/%d meshes"), BatchStart + BatchNum, StaticEluFiles.Num());
+	}
+}
+
+void URaiderzImportCommandlet::ImportAnimations(const TArray<FString>& AniFiles)
+{
+	// Skeletons are resolved up front because loading them has to happen on the game thread
+	TArray<FString> CandidateFiles;
+	TArray<FString> CandidatePackageNames;
+	TArray<USkeleton*> CandidateSkeletons;
+	TArray<uint32> SettingsHashes;
+	const uint32 OptionsHash = AnimationOptions.GetSettingsHash();
+	for (const FString& AniFilePath : AniFiles)
+	{
+		USkeleton* Skeleton = FindSkeletonForAnimation(AniFilePath);
+		if (!Skeleton)
+		{
+			PrintWarning(TEXT("Skipping animation because no skeleton was found for it: ") + AniFilePath);
+			continue;
+		}
+
+		// UCollisionImporter and USoundImporter find animations by this A_ prefixed name
+		const FString AssetName = TEXT("A_") + PackageTools::SanitizePackageName(URaiderzXmlUtilities::GetRaiderzBaseFileName(AniFilePath));
+		CandidateFiles.Add(AniFilePath);
+		CandidatePackageNames.Add(GetDestinationPackageName(AniFilePath, AssetName));
+		CandidateSkeletons.Add(Skeleton);
+		SettingsHashes.Add(HashCombine(OptionsHash, GetTypeHash(Skeleton->GetPathName())));
+	}
+
+	TArray<FRaiderzImportRecord> CandidateRecords;
+	TArray<bool> UpToDate;
+	MakeImportRecords(CandidateFiles, CandidatePackageNames, UEluImporter::AnimationImportVersion, SettingsHashes, CandidateRecords, UpToDate);
+
+	TArray<FString> SkinnedAniFiles;
+	TArray<FString> PackageNames;
+	TArray<USkeleton*> Skeletons;
+	TArray<FRaiderzImportRecord> Records;
+	for (int32 Index = 0; Index < CandidateFiles.Num(); ++Index)
+	{
+		if (UpToDate[Index])
+		{
+			NumUpToDateAssets++;
+			continue;
+		}
+		SkinnedAniFiles.Add(CandidateFiles[Index]);
+		PackageNames.Add(CandidatePackageNames[Index]);
+		Skeletons.Add(CandidateSkeletons[Index]);
+		Records.Add(MoveTemp(CandidateRecords[Index]));
+	}
+
+	UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: %d/%d animations are up to date"), CandidateFiles.Num() - SkinnedAniFiles.Num(), CandidateFiles.Num());
+
+	for (int32 BatchStart = 0; BatchStart < SkinnedAniFiles.Num(); BatchStart += BatchSize)
+	{
+		const int32 BatchNum = FMath::Min(BatchSize, SkinnedAniFiles.Num() - BatchStart);
+
+		TArray<FAniFileData> BatchData;
+		BatchData.SetNum(BatchNum);
+		ParallelFor(BatchNum, [&](int32 Index)
+		{
+			BatchData[Index] = UEluImporter::LoadAniData(SkinnedAniFiles[BatchStart + Index]);
+		});
+
+		for (int32 Index = 0; Index < BatchNum; ++Index)
+		{
+			const FString& AniFilePath = SkinnedAniFiles[BatchStart + Index];
+			if (!BatchData[Index].bLoadSuccess)
+			{
+				RecordFailedFile(AniFilePath, TEXT("Failed to load ani file"));
+				continue;
+			}
+
+			const FString& PackageName = PackageNames[BatchStart + Index];
+			const FString AssetName = FPackageName::GetShortName(PackageName);
+			UAnimSequence* AnimSeq = UEluImporter::CreateAnimSequence(BatchData[Index], Skeletons[BatchStart + Index], PackageName, AssetName, AnimationOptions);
+			if (AnimSeq)
+			{
+				PendingRecords.Add(PackageName, MoveTemp(Records[BatchStart + Index]));
+				ImportedAnimationFolders.Add(FPaths::GetPath(AniFilePath));
+				NumImportedAssets++;
+			}
+			else
+			{
+				RecordFailedFile(AniFilePath, TEXT("Couldn't create an animation for ani file"));
+			}
+		}
+
+		BatchData.Empty();
+		SaveDirtyPackages();
+
+		UE_LOG(LogRaiderZ, Display, TEXT("RaiderzImport: processed %d/%d animations"), BatchStart + BatchNum, SkinnedAniFiles.Num());
+	}
+}
+
+/** Adds the path of the given XML file of a RaiderZ mesh to XmlFiles if the file exists */
+static void AddMeshXmlFile(const FString& MeshName, const FString& Extension, TArray<FString>& XmlFiles)
+{
+	FString XmlFilePath;
+	if (URaiderzXmlUtilities::GetRaiderzFilePath(MeshName + Extension, XmlFilePath))
+	{
+		XmlFiles.Add(XmlFilePath);
+	}
+}
+
+void URaiderzImportCommandlet::ImportNotifies(const TArray<FString>& SourceFiles, bool bImportCollision, bool bImportSound, USoundAttenuation* Attenuation)
+{
+	TArray<FString> SourceFolders;
+	for (const FString& SourceFilePath : SourceFiles)
+	{
+		SourceFolders.AddUnique(FPaths::GetPath(SourceFilePath));
+	}
+
+	FRaiderzImportManifest& Manifest = FRaiderzImportManifest::Get();
+	const uint32 SoundSettingsHash = GetTypeHash(Attenuation ? Attenuation->GetPathName() : FString());
+
+	for (const FString& SourceFolder : SourceFolders)
+	{
+		USkeletalMesh* SkeletalMesh = FindSkeletalMeshForFolder(SourceFolder);
+		if (!SkeletalMesh)
+		{
+			continue;
+		}
+
+		const FString MeshPackageName = SkeletalMesh->GetOutermost()->GetName();
+		const FString MeshName = UEditorFunctionLibrary::GetRaiderZMeshName(SkeletalMesh);
+
+		// Notifies live in the animations, so new animations need them no matter what the manifest says
+		const bool bAnimationsChanged = ImportedAnimationFolders.Contains(SourceFolder);
+
+		// Notifies don't have an asset of their own, so they're recorded under the skeletal mesh's package name
+		auto NeedsImport = [&](const TCHAR* NotifyType, const TArray<FString>& XmlFiles, int32 ImporterVersion, uint32 SettingsHash)
+		{
+			const FString NotifyKey = MeshPackageName + TEXT(":") + NotifyType;
+			FRaiderzImportRecord Record = Manifest.MakeRecord(NotifyKey, XmlFiles, ImporterVersion, SettingsHash);
+			if (!bForceImport && !bAnimationsChanged && Manifest.IsUpToDate(NotifyKey, Record))
+			{
+				NumUpToDateAssets++;
+				return false;
+			}
+
+			PendingRecords.Add(NotifyKey, MoveTemp(Record));
+			return true;
+		};
+
+		bool bImportedNotifies = false;
+
+		if (bImportCollision)
+		{
+			TArray<FString> XmlFiles = { URaiderzXmlUtilities::NPCXmlFilePath, URaiderzXmlUtilities::TalentXmlFilePath, URaiderzXmlUtilities::TalentHitInfoXmlFilePath };
+			AddMeshXmlFile(MeshName, URaiderzXmlUtilities::EluAnimationXmlExt, XmlFiles);
+
+			if (NeedsImport(TEXT("CollisionNotifies"), XmlFiles, UCollisionImporter::ImportVersion, 0))
+			{
+				PrintLog(TEXT("Importing collision notifies for skeletal mesh: ") + SkeletalMesh->GetName());
+				UCollisionImporter::ImportCollisionForSkeletalMesh(SkeletalMesh);
+				bImportedNotifies = true;
+			}
+		}
+
+		if (bImportSound)
+		{
+			TArray<FString> XmlFiles = { URaiderzXmlUtilities::SoundXmlFilePath };
+			AddMeshXmlFile(MeshName, URaiderzXmlUtilities::EluAnimationXmlExt, XmlFiles);
+			AddMeshXmlFile(MeshName, URaiderzXmlUtilities::EluAnimationSoundEventXmlExt, XmlFiles);
+
+			if (NeedsImport(TEXT("SoundNotifies"), XmlFiles, USoundImporter::ImportVersion, SoundSettingsHash))
+			{
+				PrintLog(TEXT("Importing sound notifies for skeletal mesh: ") + SkeletalMesh->GetName());
+				USoundImporter::ImportSoundForSkeletalMesh(SkeletalMesh, Attenuation);
+				bImportedNotifies = true;
+			}
+		}
+
+		if (bImportedNotifies)
+		{
+			SaveDirtyPackages();
+		}
+	}
+}
+
+void URaiderzImportCommandlet::SaveDirtyPackages()
+{
+	TArray<UPackage*> DirtyPackages;
+	for (TObjectIterator<UPackage> It; It; ++It)
+	{
+		UPackage* Package = *It;
+		if (Package->IsDirty() && Package != GetTransientPackage() && Package->GetName().StartsWith(TEXT("/Game/")))
+		{
+			DirtyPackages.Add(Package);
+		}
+	}
+
+	bool bAllSaved = true;
+	for (UPackage* Package : DirtyPackages)
+	{
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+		bool bSaved = UPackage::SavePackage(Package, nullptr, RF_Standalone, *PackageFileName, GError, nullptr, false, true, SAVE_NoError);
+		if (!bSaved)
+		{
+			PrintError(TEXT("Failed to save package: ") + Package->GetName());
+			bAllSaved = false;
+		}
+	}
+
+	// Without knowing which import a failed package belongs to, none of them is recorded, so they all get imported again next time
+	FRaiderzImportManifest& Manifest = FRaiderzImportManifest::Get();
+	if (bAllSaved)
+	{
+		for (const TPair<FString, FRaiderzImportRecord>& Pending : PendingRecords)
+		{
+			Manifest.RecordImport(Pending.Key, Pending.Value);
+		}
+	}
+	PendingRecords.Empty();
+	Manifest.SaveIfDirty();
+
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+}
+
+void URaiderzImportCommandlet::RecordFailedFile(const FString& FilePath, const FString& Reason)
+{
+	PrintError(Reason + TEXT(": ") + FilePath);
+	FailedFiles.Add(FilePath);
+}
@@ -0,0 +1,206 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzImportManifest.h"
+#include "EOD.h"
+
+#include "Misc/Paths.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Hash/CityHash.h"
+#include "HAL/FileManager.h"
+#include "Templates/UniquePtr.h"
+
+/** Bump whenever the layout of the saved manifest changes */
+static const int32 RaiderzImportManifestVersion = 1;
+
+FRaiderzImportManifest& FRaiderzImportManifest::Get()
+{
+	static FRaiderzImportManifest Manifest;
+	return Manifest;
+}
+
+FRaiderzImportManifest::FRaiderzImportManifest() :
+	bLoaded(false),
+	bDirty(false)
+{
+}
+
+FRaiderzImportRecord FRaiderzImportManifest::MakeRecord(const FString& AssetKey, const TArray<FString>& SourcePaths, int32 ImporterVersion, uint32 SettingsHash)
+{
+	// Copied so that the sources can be hashed without holding the lock
+	TArray<FRaiderzImportSource> PreviousSources;
+	{
+		FScopeLock Lock(&ManifestCritical);
+		ConditionalLoad();
+		if (const FRaiderzImportRecord* PreviousRecord = Records.Find(AssetKey))
+		{
+			PreviousSources = PreviousRecord->Sources;
+		}
+	}
+
+	FRaiderzImportRecord Record;
+	Record.ImporterVersion = ImporterVersion;
+	Record.SettingsHash = SettingsHash;
+	Record.Sources.Reserve(SourcePaths.Num());
+
+	for (const FString& SourcePath : SourcePaths)
+	{
+		const FRaiderzImportSource* PreviousSource = PreviousSources.FindByPredicate([&SourcePath](const FRaiderzImportSource& Source)
+		{
+			return Source.Path == SourcePath;
+		});
+
+		if (PreviousSource && PreviousSource->Size >= 0)
+		{
+			FFileStatData FileStat = IFileManager::Get().GetStatData(*SourcePath);
+			if (FileStat.bIsValid && FileStat.ModificationTime == PreviousSource->ModificationTime && FileStat.FileSize == PreviousSource->Size)
+			{
+				Record.Sources.Add(*PreviousSource);
+				continue;
+			}
+		}
+
+		Record.Sources.Add(ReadSource(SourcePath));
+	}
+
+	return Record;
+}
+
+bool FRaiderzImportManifest::IsUpToDate(const FString& AssetKey, const FRaiderzImportRecord& Record)
+{
+	FScopeLock Lock(&ManifestCritical);
+	ConditionalLoad();
+
+	FRaiderzImportRecord* PreviousRecord = Records.Find(AssetKey);
+	if (!PreviousRecord ||
+		PreviousRecord->ImporterVersion != Record.ImporterVersion ||
+		PreviousRecord->SettingsHash != Record.SettingsHash ||
+		PreviousRecord->Sources.Num() != Record.Sources.Num())
+	{
+		return false;
+	}
+
+	bool bSameTimestamps = true;
+	for (int32 Index = 0; Index < Record.Sources.Num(); ++Index)
+	{
+		const FRaiderzImportSource& PreviousSource = PreviousRecord->Sources[Index];
+		const FRaiderzImportSource& Source = Record.Sources[Index];
+		if (Source.Size < 0 || Source.Path != PreviousSource.Path || Source.Size != PreviousSource.Size || Source.ContentHash != PreviousSource.ContentHash)
+		{
+			return false;
+		}
+		bSameTimestamps &= Source.ModificationTime == PreviousSource.ModificationTime;
+	}
+
+	// Files that were only touched keep their asset. Their new timestamps are kept so that they don't get hashed again next time
+	if (!bSameTimestamps)
+	{
+		PreviousRecord->Sources = Record.Sources;
+		bDirty = true;
+	}
+
+	return true;
+}
+
+void FRaiderzImportManifest::RecordImport(const FString& AssetKey, const FRaiderzImportRecord& Record)
+{
+	FScopeLock Lock(&ManifestCritical);
+	ConditionalLoad();
+
+	Records.Add(AssetKey, Record);
+	bDirty = true;
+}
+
+void FRaiderzImportManifest::RemoveRecord(const FString& AssetKey)
+{
+	FScopeLock Lock(&ManifestCritical);
+	ConditionalLoad();
+
+	if (Records.Remove(AssetKey) > 0)
+	{
+		bDirty = true;
+	}
+}
+
+void FRaiderzImportManifest::SaveIfDirty()
+{
+	FScopeLock Lock(&ManifestCritical);
+	if (bDirty)
+	{
+		Save();
+	}
+}
+
+FString FRaiderzImportManifest::GetManifestFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("RaiderZ") / TEXT("ImportManifest.bin");
+}
+
+FRaiderzImportSource FRaiderzImportManifest::ReadSource(const FString& Path)
+{
+	FRaiderzImportSource Source;
+	Source.Path = Path;
+
+	// Stat'ed before reading, so that a file that changes while it's read looks changed the next time it's checked
+	FFileStatData FileStat = IFileManager::Get().GetStatData(*Path);
+	TArray<uint8> FileData;
+	if (!FileStat.bIsValid || FileStat.bIsDirectory || !FFileHelper::LoadFileToArray(FileData, *Path, FILEREAD_Silent))
+	{
+		return Source;
+	}
+
+	Source.ModificationTime = FileStat.ModificationTime;
+	Source.Size = FileData.Num();
+	Source.ContentHash = CityHash64(reinterpret_cast<const char*>(FileData.GetData()), FileData.Num());
+	return Source;
+}
+
+void FRaiderzImportManifest::ConditionalLoad()
+{
+	if (!bLoaded)
+	{
+		bLoaded = true;
+		Load();
+	}
+}
+
+void FRaiderzImportManifest::Load()
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetManifestFilePath(), FILEREAD_Silent));
+	if (!Reader.IsValid())
+	{
+		return;
+	}
+
+	int32 Version = 0;
+	*Reader << Version;
+	if (Version != RaiderzImportManifestVersion)
+	{
+		return;
+	}
+
+	*Reader << Records;
+	if (Reader->IsError())
+	{
+		PrintWarning(TEXT("RaiderZ import manifest is corrupt, every asset will be imported again"));
+		Records.Empty();
+	}
+}
+
+void FRaiderzImportManifest::Save()
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*GetManifestFilePath()));
+	if (!Writer.IsValid())
+	{
+		PrintWarning(TEXT("Failed to save RaiderZ import manifest to: ") + GetManifestFilePath());
+		return;
+	}
+
+	int32 Version = RaiderzImportManifestVersion;
+	*Writer << Version << Records;
+
+	if (Writer->Close())
+	{
+		bDirty = false;
+	}
+}
@@ -0,0 +1,179 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzXmlDatabase.h"
+#include "EOD.h"
+#include "RaiderzXmlUtilities.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+
+const double FRaiderzXmlDatabase::SourceCheckInterval = 2.0;
+
+FRaiderzXmlDatabase& FRaiderzXmlDatabase::Get()
+{
+	static FRaiderzXmlDatabase Database;
+	return Database;
+}
+
+FRaiderzXmlDatabase::FRaiderzXmlDatabase()
+{
+	FRaiderzXmlTable& NPCTable = Tables[(uint8)ERaiderzXmlTable::NPC];
+	NPCTable.FilePath = URaiderzXmlUtilities::NPCXmlFilePath;
+	NPCTable.EntryTag = TEXT("NPC");
+	NPCTable.KeyAttributes = { TEXT("id"), TEXT("MeshName") };
+	NPCTable.ValueAttributes = { TEXT("AniPrefix") };
+
+	FRaiderzXmlTable& TalentTable = Tables[(uint8)ERaiderzXmlTable::Talent];
+	TalentTable.FilePath = URaiderzXmlUtilities::TalentXmlFilePath;
+	TalentTable.EntryTag = TEXT("TALENT");
+	TalentTable.KeyAttributes = { TEXT("id") };
+	TalentTable.ListAttributes = { TEXT("NPC") };
+	TalentTable.ValueAttributes = { TEXT("UseAni"), TEXT("CastingAni") };
+
+	FRaiderzXmlTable& TalentHitInfoTable = Tables[(uint8)ERaiderzXmlTable::TalentHitInfo];
+	TalentHitInfoTable.FilePath = URaiderzXmlUtilities::TalentHitInfoXmlFilePath;
+	TalentHitInfoTable.EntryTag = TEXT("TALENT_HIT");
+	TalentHitInfoTable.KeyAttributes = { TEXT("id") };
+	TalentHitInfoTable.ValueAttributes = { TEXT("CheckTime") };
+	TalentHitInfoTable.ChildTags = { TEXT("HitSegment"), TEXT("Capsule") };
+	TalentHitInfoTable.bReadContent = true;
+
+	FRaiderzXmlTable& SoundTable = Tables[(uint8)ERaiderzXmlTable::Sound];
+	SoundTable.FilePath = URaiderzXmlUtilities::SoundXmlFilePath;
+	SoundTable.EntryTag = TEXT("SOUND");
+	SoundTable.KeyAttributes = { TEXT("name") };
+
+	for (double& CheckTime : LastSourceCheckTimes)
+	{
+		CheckTime = -SourceCheckInterval;
+	}
+}
+
+const FRaiderzXmlElement* FRaiderzXmlDatabase::FindNPCByMeshName(const FString& MeshName)
+{
+	return FindByKey(ERaiderzXmlTable::NPC, TEXT("MeshName"), MeshName);
+}
+
+const TArray<const FRaiderzXmlElement*>& FRaiderzXmlDatabase::GetNPCTalents(const FString& NPCID)
+{
+	static const TArray<const FRaiderzXmlElement*> NoTalents;
+
+	const FRaiderzXmlTable& Table = GetTable(ERaiderzXmlTable::Talent);
+	const TArray<const FRaiderzXmlElement*>* Talents = Table.ListIndexes.FindChecked(TEXT("NPC")).Find(NPCID);
+	return Talents ? *Talents : NoTalents;
+}
+
+const FRaiderzXmlElement* FRaiderzXmlDatabase::FindTalentHitInfo(const FString& TalentID)
+{
+	return FindByKey(ERaiderzXmlTable::TalentHitInfo, TEXT("id"), TalentID);
+}
+
+const FRaiderzXmlElement* FRaiderzXmlDatabase::FindSoundByName(const FString& SoundName)
+{
+	return FindByKey(ERaiderzXmlTable::Sound, TEXT("name"), SoundName);
+}
+
+const TArray<FRaiderzXmlElement>& FRaiderzXmlDatabase::GetAllSounds()
+{
+	return GetTable(ERaiderzXmlTable::Sound).Entries;
+}
+
+const FRaiderzXmlTable& FRaiderzXmlDatabase::GetTable(ERaiderzXmlTable TableType)
+{
+	check(TableType < ERaiderzXmlTable::MAX);
+
+	const uint8 TableIndex = (uint8)TableType;
+	FRaiderzXmlTable& Table = Tables[TableIndex];
+
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (!Table.bLoaded || CurrentTime - LastSourceCheckTimes[TableIndex] >= SourceCheckInterval)
+	{
+		LastSourceCheckTimes[TableIndex] = CurrentTime;
+
+		FFileStatData FileStat = IFileManager::Get().GetStatData(*Table.FilePath);
+		if (!Table.bLoaded || FileStat.ModificationTime != Table.ModificationTime || FileStat.FileSize != Table.Size)
+		{
+			Table.ModificationTime = FileStat.ModificationTime;
+			Table.Size = FileStat.FileSize;
+			LoadTable(Table);
+		}
+	}
+
+	return Table;
+}
+
+void FRaiderzXmlDatabase::InvalidateAll()
+{
+	for (FRaiderzXmlTable& Table : Tables)
+	{
+		Table.Entries.Empty();
+		Table.KeyIndexes.Empty();
+		Table.ListIndexes.Empty();
+		Table.bLoaded = false;
+	}
+}
+
+const FRaiderzXmlElement* FRaiderzXmlDatabase::FindByKey(ERaiderzXmlTable TableType, const FString& Attribute, const FString& Value)
+{
+	const FRaiderzXmlTable& Table = GetTable(TableType);
+	const FRaiderzXmlElement* const* Element = Table.KeyIndexes.FindChecked(Attribute).Find(Value);
+	return Element ? *Element : nullptr;
+}
+
+void FRaiderzXmlDatabase::LoadTable(FRaiderzXmlTable& Table)
+{
+	Table.Entries.Empty();
+	Table.KeyIndexes.Empty();
+	Table.ListIndexes.Empty();
+
+	Table.bLoaded = true;
+
+	TArray<FString> Attributes;
+	if (Table.ValueAttributes.Num() > 0)
+	{
+		Attributes.Append(Table.KeyAttributes);
+		Attributes.Append(Table.ListAttributes);
+		Attributes.Append(Table.ValueAttributes);
+	}
+
+	FString Error;
+	if (!FRaiderzXmlReader::ReadElements(Table.FilePath, Table.EntryTag, Table.ChildTags, Attributes, Table.bReadContent, Table.Entries, Error))
+	{
+		PrintError(TEXT("Failed to read ") + Table.FilePath + TEXT(". ") + Error);
+	}
+
+	for (const FString& Attribute : Table.KeyAttributes)
+	{
+		TMap<FString, const FRaiderzXmlElement*>& Index = Table.KeyIndexes.Add(Attribute);
+		Index.Reserve(Table.Entries.Num());
+		for (const FRaiderzXmlElement& Entry : Table.Entries)
+		{
+			const FString& Value = Entry.GetAttribute(Attribute);
+			if (!Value.IsEmpty() && !Index.Contains(Value))
+			{
+				Index.Add(Value, &Entry);
+			}
+		}
+	}
+
+	for (const FString& Attribute : Table.ListAttributes)
+	{
+		TMap<FString, TArray<const FRaiderzXmlElement*>>& Index = Table.ListIndexes.Add(Attribute);
+		TArray<FString> Values;
+		for (const FRaiderzXmlElement& Entry : Table.Entries)
+		{
+			Values.Reset();
+			Entry.GetAttribute(Attribute).ParseIntoArray(Values, TEXT(","));
+			for (const FString& Value : Values)
+			{
+				const FString TrimmedValue = Value.TrimStartAndEnd();
+				if (!TrimmedValue.IsEmpty())
+				{
+					Index.FindOrAdd(TrimmedValue).AddUnique(&Entry);
+				}
+			}
+		}
+	}
+
+	PrintLog(FString::Printf(TEXT("Read %s: %d %s entries"), *Table.FilePath, Table.Entries.Num(), *Table.EntryTag));
+}
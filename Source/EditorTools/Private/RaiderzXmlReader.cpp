@@ -0,0 +1,653 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#include "RaiderzXmlReader.h"
+
+#include "HAL/FileManager.h"
+
+// --------------------------------------
+//  FRaiderzXmlElement
+// --------------------------------------
+
+const FString& FRaiderzXmlElement::GetAttribute(const FString& Name) const
+{
+	for (const FXmlAttribute& Attribute : Attributes)
+	{
+		if (Attribute.GetTag() == Name)
+		{
+			return Attribute.GetValue();
+		}
+	}
+
+	static const FString EmptyValue;
+	return EmptyValue;
+}
+
+TArray<const FRaiderzXmlElement*> FRaiderzXmlElement::GetElementsWithTag(const FString& InTag) const
+{
+	TArray<const FRaiderzXmlElement*> ResultElements;
+
+	// Depth first without recursion so that results are appended to a single array in document order
+	TArray<const FRaiderzXmlElement*, TInlineAllocator<32>> ElementStack;
+	for (int32 Index = Children.Num() - 1; Index >= 0; --Index)
+	{
+		ElementStack.Push(&Children[Index]);
+	}
+
+	while (ElementStack.Num() > 0)
+	{
+		const FRaiderzXmlElement* Element = ElementStack.Pop(false);
+		if (Element->Tag == InTag)
+		{
+			ResultElements.Add(Element);
+		}
+
+		for (int32 Index = Element->Children.Num() - 1; Index >= 0; --Index)
+		{
+			ElementStack.Push(&Element->Children[Index]);
+		}
+	}
+
+	return ResultElements;
+}
+
+// --------------------------------------
+//  FRaiderzXmlElementBuilder
+// --------------------------------------
+
+/** Collects the entries read by FRaiderzXmlReader::ReadElements into FRaiderzXmlElement trees */
+class FRaiderzXmlElementBuilder : public IRaiderzXmlCallback
+{
+public:
+
+	FRaiderzXmlElementBuilder(const FString& InEntryTag, TArray<FRaiderzXmlElement>& InElements) :
+		EntryTag(InEntryTag),
+		Elements(InElements)
+	{
+	}
+
+	virtual bool ProcessElement(const FString& Tag, const TArray<FXmlAttribute>& Attributes, int32 Depth) override
+	{
+		// Parents stay valid while they're on the stack because elements only get added to the innermost open element
+		FRaiderzXmlElement* Parent = ElementStack.Num() > 0 ? ElementStack.Last() : nullptr;
+		FRaiderzXmlElement* Element = nullptr;
+		if (Parent)
+		{
+			Element = &Parent->Children.AddDefaulted_GetRef();
+		}
+		else if (Tag == EntryTag)
+		{
+			Element = &Elements.AddDefaulted_GetRef();
+		}
+
+		if (Element)
+		{
+			Element->Tag = Tag;
+			Element->Attributes = Attributes;
+		}
+
+		// Child tags outside of any entry are pushed as null so that closing them pops the right element
+		ElementStack.Push(Element);
+		return true;
+	}
+
+	virtual bool ProcessClose(const FString& Tag, const FString& Content, int32 Depth) override
+	{
+		FRaiderzXmlElement* Element = ElementStack.Pop(false);
+		if (Element)
+		{
+			Element->Content = Content;
+		}
+		return true;
+	}
+
+private:
+
+	const FString& EntryTag;
+
+	TArray<FRaiderzXmlElement>& Elements;
+
+	TArray<FRaiderzXmlElement*> ElementStack;
+
+};
+
+// --------------------------------------
+//  FRaiderzXmlReader
+// --------------------------------------
+
+FRaiderzXmlReader::FRaiderzXmlReader() :
+	BufferPos(0),
+	BufferNum(0),
+	LineNumber(1),
+	bReadContent(false)
+{
+}
+
+FRaiderzXmlReader::~FRaiderzXmlReader()
+{
+}
+
+void FRaiderzXmlReader::SetTagFilter(const TArray<FString>& Tags)
+{
+	TagFilter = TSet<FString>(Tags);
+}
+
+void FRaiderzXmlReader::SetAttributeFilter(const TArray<FString>& InAttributes)
+{
+	AttributeFilter = TSet<FString>(InAttributes);
+}
+
+void FRaiderzXmlReader::SetReadContent(bool bInReadContent)
+{
+	bReadContent = bInReadContent;
+}
+
+bool FRaiderzXmlReader::ReadElements(
+	const FString& FilePath,
+	const FString& EntryTag,
+	const TArray<FString>& ChildTags,
+	const TArray<FString>& InAttributes,
+	bool bInReadContent,
+	TArray<FRaiderzXmlElement>& OutElements,
+	FString& OutError)
+{
+	TArray<FString> Tags = ChildTags;
+	Tags.AddUnique(EntryTag);
+
+	FRaiderzXmlReader Reader;
+	Reader.SetTagFilter(Tags);
+	Reader.SetAttributeFilter(InAttributes);
+	Reader.SetReadContent(bInReadContent);
+
+	FRaiderzXmlElementBuilder Builder(EntryTag, OutElements);
+	if (!Reader.ReadFile(FilePath, Builder))
+	{
+		OutError = Reader.GetLastError();
+		return false;
+	}
+	return true;
+}
+
+bool FRaiderzXmlReader::ReadFile(const FString& FilePath, IRaiderzXmlCallback& Callback)
+{
+	LastError.Empty();
+
+	FileReader.Reset(IFileManager::Get().CreateFileReader(*FilePath));
+	if (!FileReader.IsValid())
+	{
+		LastError = TEXT("Couldn't open ") + FilePath;
+		return false;
+	}
+
+	Buffer.SetNumUninitialized(ReadBufferSize, false);
+	BufferPos = 0;
+	BufferNum = 0;
+	LineNumber = 1;
+	OpenTags.Reset();
+	OpenTagsReported.Reset();
+	ContentBytes.Reset();
+	ContentStarts.Reset();
+
+	bool bSuccess = true;
+	bool bContinue = true;
+
+	// Skip the UTF-8 byte order mark
+	if (!ConsumeIfNext("\xEF\xBB\xBF") && (PeekChar() == 0xFF || PeekChar() == 0xFE))
+	{
+		bSuccess = SetError(TEXT("UTF-16 files are not supported"));
+	}
+
+	while (bSuccess && bContinue)
+	{
+		const int32 Char = NextChar();
+		if (Char < 0)
+		{
+			break;
+		}
+
+		const bool bInReportedElement = OpenTagsReported.Num() > 0 && OpenTagsReported.Last();
+		if (Char != '<')
+		{
+			if (bReadContent && bInReportedElement)
+			{
+				if (Char == '&')
+				{
+					ReadEntity(ContentBytes);
+				}
+				else
+				{
+					ContentBytes.Add((uint8)Char);
+				}
+			}
+			continue;
+		}
+
+		const int32 MarkupChar = PeekChar();
+		if (MarkupChar == '?')
+		{
+			bSuccess = SkipPast("?>");
+		}
+		else if (MarkupChar == '!')
+		{
+			NextChar();
+			if (ConsumeIfNext("--"))
+			{
+				bSuccess = SkipPast("-->");
+			}
+			else if (ConsumeIfNext("[CDATA["))
+			{
+				bSuccess = SkipPast("]]>", bReadContent && bInReportedElement ? &ContentBytes : nullptr);
+			}
+			else
+			{
+				// DOCTYPE. Internal DTD subsets aren't used by any RaiderZ file
+				bSuccess = SkipPast(">");
+			}
+		}
+		else if (MarkupChar == '/')
+		{
+			NextChar();
+			bSuccess = ReadEndTag(Callback, bContinue);
+		}
+		else
+		{
+			bSuccess = ReadStartTag(Callback, bContinue);
+		}
+	}
+
+	FileReader.Reset();
+
+	if (bSuccess && bContinue && OpenTags.Num() > 0)
+	{
+		bSuccess = SetError(TEXT("Element '") + OpenTags.Last() + TEXT("' is never closed"));
+	}
+
+	return bSuccess;
+}
+
+bool FRaiderzXmlReader::EnsureBuffered(int32 NumBytes)
+{
+	const int32 NumAvailable = BufferNum - BufferPos;
+	if (NumAvailable >= NumBytes)
+	{
+		return true;
+	}
+
+	if (!FileReader.IsValid())
+	{
+		return false;
+	}
+
+	// Move the unread bytes to the front so that the requested bytes end up contiguous
+	if (NumAvailable > 0 && BufferPos > 0)
+	{
+		FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + BufferPos, NumAvailable);
+	}
+	BufferPos = 0;
+	BufferNum = NumAvailable;
+
+	const int64 NumRemainingInFile = FileReader->TotalSize() - FileReader->Tell();
+	const int32 NumToRead = (int32)FMath::Min<int64>(NumRemainingInFile, ReadBufferSize - BufferNum);
+	if (NumToRead > 0)
+	{
+		FileReader->Serialize(Buffer.GetData() + BufferNum, NumToRead);
+		if (FileReader->IsError())
+		{
+			return false;
+		}
+		BufferNum += NumToRead;
+	}
+
+	return BufferNum >= NumBytes;
+}
+
+void FRaiderzXmlReader::SkipWhitespace()
+{
+	while (IsWhitespace(PeekChar()))
+	{
+		NextChar();
+	}
+}
+
+bool FRaiderzXmlReader::SkipPast(const ANSICHAR* Terminator, TArray<uint8>* OutBytes)
+{
+	const int32 TerminatorLen = FCStringAnsi::Strlen(Terminator);
+	check(TerminatorLen > 0 && TerminatorLen <= 4);
+
+	// The last TerminatorLen bytes read
+	ANSICHAR Window[4] = { 0 };
+	while (true)
+	{
+		const int32 Char = NextChar();
+		if (Char < 0)
+		{
+			return SetError(FString::Printf(TEXT("Expected '%s' before the end of the file"), ANSI_TO_TCHAR(Terminator)));
+		}
+
+		FMemory::Memmove(Window, Window + 1, TerminatorLen - 1);
+		Window[TerminatorLen - 1] = (ANSICHAR)Char;
+		if (FMemory::Memcmp(Window, Terminator, TerminatorLen) == 0)
+		{
+			// Everything but the last byte of the terminator has already been appended
+			if (OutBytes)
+			{
+				OutBytes->RemoveAt(OutBytes->Num() - (TerminatorLen - 1), TerminatorLen - 1, false);
+			}
+			return true;
+		}
+
+		if (OutBytes)
+		{
+			OutBytes->Add((uint8)Char);
+		}
+	}
+}
+
+bool FRaiderzXmlReader::ConsumeIfNext(const ANSICHAR* String)
+{
+	const int32 Len = FCStringAnsi::Strlen(String);
+	if (!EnsureBuffered(Len) || FMemory::Memcmp(Buffer.GetData() + BufferPos, String, Len) != 0)
+	{
+		return false;
+	}
+
+	// None of the strings this is used with contain a line break
+	BufferPos += Len;
+	return true;
+}
+
+bool FRaiderzXmlReader::ReadName(FString& OutName)
+{
+	NameBytes.Reset();
+	while (true)
+	{
+		const int32 Char = PeekChar();
+		if (Char < 0 || IsWhitespace(Char) || Char == '=' || Char == '>' || Char == '/')
+		{
+			break;
+		}
+		NameBytes.Add((uint8)Char);
+		NextChar();
+	}
+
+	if (NameBytes.Num() == 0)
+	{
+		return SetError(TEXT("Expected a name"));
+	}
+
+	OutName.Reset();
+	AppendUTF8ToString(OutName, NameBytes.GetData(), NameBytes.Num());
+	return true;
+}
+
+void FRaiderzXmlReader::ReadEntity(TArray<uint8>& OutBytes)
+{
+	ANSICHAR Name[12];
+	int32 NameLen = 0;
+	while (NameLen < UE_ARRAY_COUNT(Name) - 1)
+	{
+		const int32 Char = PeekChar();
+		if (Char < 0 || Char == ';' || Char == '<' || Char == '&' || IsWhitespace(Char))
+		{
+			break;
+		}
+		Name[NameLen++] = (ANSICHAR)Char;
+		NextChar();
+	}
+	Name[NameLen] = 0;
+
+	uint32 CodePoint = 0;
+	if (PeekChar() == ';')
+	{
+		if (FCStringAnsi::Strcmp(Name, "lt") == 0)
+		{
+			CodePoint = '<';
+		}
+		else if (FCStringAnsi::Strcmp(Name, "gt") == 0)
+		{
+			CodePoint = '>';
+		}
+		else if (FCStringAnsi::Strcmp(Name, "amp") == 0)
+		{
+			CodePoint = '&';
+		}
+		else if (FCStringAnsi::Strcmp(Name, "quot") == 0)
+		{
+			CodePoint = '"';
+		}
+		else if (FCStringAnsi::Strcmp(Name, "apos") == 0)
+		{
+			CodePoint = '\'';
+		}
+		else if (Name[0] == '#')
+		{
+			const bool bHex = Name[1] == 'x' || Name[1] == 'X';
+			CodePoint = (uint32)FCStringAnsi::Strtoui64(Name + (bHex ? 2 : 1), nullptr, bHex ? 16 : 10);
+		}
+	}
+
+	if (CodePoint == 0)
+	{
+		// Not a known entity, keep the text as it is like most lenient parsers do
+		OutBytes.Add('&');
+		OutBytes.Append((const uint8*)Name, NameLen);
+		return;
+	}
+
+	NextChar();
+	AppendUTF8(OutBytes, CodePoint);
+}
+
+bool FRaiderzXmlReader::ReadAttributeValue(FString* OutValue)
+{
+	const int32 Quote = NextChar();
+	if (Quote != '"' && Quote != '\'')
+	{
+		return SetError(TEXT("Expected a quoted attribute value"));
+	}
+
+	ValueBytes.Reset();
+	while (true)
+	{
+		const int32 Char = NextChar();
+		if (Char < 0)
+		{
+			return SetError(TEXT("Attribute value is never closed"));
+		}
+
+		if (Char == Quote)
+		{
+			break;
+		}
+
+		if (!OutValue)
+		{
+			continue;
+		}
+
+		if (Char == '&')
+		{
+			ReadEntity(ValueBytes);
+		}
+		else
+		{
+			ValueBytes.Add((uint8)Char);
+		}
+	}
+
+	if (OutValue)
+	{
+		OutValue->Reset();
+		AppendUTF8ToString(*OutValue, ValueBytes.GetData(), ValueBytes.Num());
+	}
+	return true;
+}
+
+bool FRaiderzXmlReader::ReadStartTag(IRaiderzXmlCallback& Callback, bool& bOutContinue)
+{
+	if (!ReadName(TagName))
+	{
+		return false;
+	}
+
+	const bool bReported = TagFilter.Num() == 0 || TagFilter.Contains(TagName);
+
+	Attributes.Reset();
+	bool bSelfClosing = false;
+	while (true)
+	{
+		SkipWhitespace();
+
+		const int32 Char = PeekChar();
+		if (Char < 0)
+		{
+			return SetError(TEXT("Tag '") + TagName + TEXT("' is never closed"));
+		}
+
+		if (Char == '>')
+		{
+			NextChar();
+			break;
+		}
+
+		if (Char == '/')
+		{
+			NextChar();
+			if (NextChar() != '>')
+			{
+				return SetError(TEXT("Expected '>' after '/' in tag '") + TagName + TEXT("'"));
+			}
+			bSelfClosing = true;
+			break;
+		}
+
+		if (!ReadName(AttributeName))
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (NextChar() != '=')
+		{
+			return SetError(TEXT("Expected '=' after attribute '") + AttributeName + TEXT("'"));
+		}
+		SkipWhitespace();
+
+		// Attributes nobody asked for are skipped without being decoded
+		if (bReported && (AttributeFilter.Num() == 0 || AttributeFilter.Contains(AttributeName)))
+		{
+			FString Value;
+			if (!ReadAttributeValue(&Value))
+			{
+				return false;
+			}
+			Attributes.Add(FXmlAttribute(AttributeName, Value));
+		}
+		else if (!ReadAttributeValue(nullptr))
+		{
+			return false;
+		}
+	}
+
+	const int32 Depth = OpenTags.Num();
+	if (bReported)
+	{
+		bOutContinue = Callback.ProcessElement(TagName, Attributes, Depth);
+	}
+
+	if (bSelfClosing)
+	{
+		if (bReported && bOutContinue)
+		{
+			bOutContinue = Callback.ProcessClose(TagName, FString(), Depth);
+		}
+	}
+	else
+	{
+		OpenTags.Add(TagName);
+		OpenTagsReported.Add(bReported);
+		ContentStarts.Add(ContentBytes.Num());
+	}
+
+	return true;
+}
+
+bool FRaiderzXmlReader::ReadEndTag(IRaiderzXmlCallback& Callback, bool& bOutContinue)
+{
+	if (!ReadName(TagName))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (NextChar() != '>')
+	{
+		return SetError(TEXT("Expected '>' after end tag '") + TagName + TEXT("'"));
+	}
+
+	if (OpenTags.Num() == 0 || !OpenTags.Last().Equals(TagName, ESearchCase::CaseSensitive))
+	{
+		return SetError(TEXT("Unexpected end tag '") + TagName + TEXT("'"));
+	}
+
+	const int32 Depth = OpenTags.Num() - 1;
+	const int32 ContentStart = ContentStarts.Pop(false);
+	if (OpenTagsReported.Last())
+	{
+		FString Content;
+		if (bReadContent)
+		{
+			AppendUTF8ToString(Content, ContentBytes.GetData() + ContentStart, ContentBytes.Num() - ContentStart);
+			Content.TrimStartAndEndInline();
+		}
+		bOutContinue = Callback.ProcessClose(TagName, Content, Depth);
+	}
+
+	// The parent's content continues where this element started
+	ContentBytes.SetNum(ContentStart, false);
+	OpenTags.Pop(false);
+	OpenTagsReported.Pop(false);
+	return true;
+}
+
+bool FRaiderzXmlReader::SetError(const FString& Message)
+{
+	LastError = FString::Printf(TEXT("Line %d: %s"), LineNumber, *Message);
+	return false;
+}
+
+void FRaiderzXmlReader::AppendUTF8ToString(FString& OutString, const uint8* Bytes, int32 Num)
+{
+	if (Num <= 0)
+	{
+		return;
+	}
+
+	FUTF8ToTCHAR Converted((const ANSICHAR*)Bytes, Num);
+	OutString.AppendChars(Converted.Get(), Converted.Length());
+}
+
+void FRaiderzXmlReader::AppendUTF8(TArray<uint8>& OutBytes, uint32 CodePoint)
+{
+	if (CodePoint < 0x80)
+	{
+		OutBytes.Add((uint8)CodePoint);
+	}
+	else if (CodePoint < 0x800)
+	{
+		OutBytes.Add((uint8)(0xC0 | (CodePoint >> 6)));
+		OutBytes.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+	}
+	else if (CodePoint < 0x10000)
+	{
+		OutBytes.Add((uint8)(0xE0 | (CodePoint >> 12)));
+		OutBytes.Add((uint8)(0x80 | ((CodePoint >> 6) & 0x3F)));
+		OutBytes.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+	}
+	else
+	{
+		OutBytes.Add((uint8)(0xF0 | ((CodePoint >> 18) & 0x07)));
+		OutBytes.Add((uint8)(0x80 | ((CodePoint >> 12) & 0x3F)));
+		OutBytes.Add((uint8)(0x80 | ((CodePoint >> 6) & 0x3F)));
+		OutBytes.Add((uint8)(0x80 | (CodePoint & 0x3F)));
+	}
+}
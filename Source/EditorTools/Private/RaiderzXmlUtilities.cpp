@@ -2,6 +2,7 @@
 
 
 #include "RaiderzXmlUtilities.h"
+#include "RaiderzFileCatalog.h"
 
 #include "Misc/Paths.h"
 #include "HAL/FileManagerGeneric.h"
@@ -29,28 +30,7 @@ URaiderzXmlUtilities::URaiderzXmlUtilities(const FObjectInitializer& ObjectIniti
 
 bool URaiderzXmlUtilities::GetRaiderzFilePath(const FString& InFileName, FString& OutFilePath)
 {
-	FString FileExtension = GetRaiderzFileExtension(InFileName);
-
-	if (FileExtension != TEXT(""))
-	{
-		TArray<FString> AllFiles;
-		IFileManager& FileManager = IFileManager::Get();
-
-		FString SearchString = FString("*") + FileExtension;
-		FileManager.FindFilesRecursive(AllFiles, *URaiderzXmlUtilities::DataFolderPath, *SearchString, true, false);
-
-		for (const FString& FilePath : AllFiles)
-		{
-			const FString CleanFileName = FPaths::GetCleanFilename(FilePath);
-			if (CleanFileName == InFileName)
-			{
-				OutFilePath = FilePath;
-				return true;
-			}
-		}
-	}
-
-	return false;
+	return FRaiderzFileCatalog::Get().FindFilePath(InFileName, OutFilePath);
 }
 
 FString URaiderzXmlUtilities::GetRaiderzFileExtension(const FString& FilePath, bool bIncludeDot)
@@ -77,22 +57,28 @@ FString URaiderzXmlUtilities::GetRaiderzBaseFileName(const FString& FilePath)
 
 TArray<FXmlNode*> URaiderzXmlUtilities::GetNodesWithTag(FXmlNode* BaseNode, const FString& Tag)
 {
+	TArray<FXmlNode*> ResultNodes;
 	if (!BaseNode)
 	{
-		return TArray<FXmlNode*>();
+		return ResultNodes;
 	}
 
-	TArray<FXmlNode*> ResultNodes;
-	if (BaseNode->GetTag() == Tag)
+	// Depth first with an explicit stack so that results are gathered into a single array in document order
+	TArray<FXmlNode*, TInlineAllocator<64>> NodeStack;
+	NodeStack.Add(BaseNode);
+	while (NodeStack.Num() > 0)
 	{
-		ResultNodes.Add(BaseNode);
-	}
+		FXmlNode* Node = NodeStack.Pop(false);
+		if (Node->GetTag() == Tag)
+		{
+			ResultNodes.Add(Node);
+		}
 
-	TArray<FXmlNode*> ChildrenNodes = BaseNode->GetChildrenNodes();
-	for (FXmlNode* ChildNode : ChildrenNodes)
-	{
-		TArray<FXmlNode*> ResultingChildNodes = GetNodesWithTag(ChildNode, Tag);
-		ResultNodes.Append(ResultingChildNodes);
+		const TArray<FXmlNode*>& ChildrenNodes = Node->GetChildrenNodes();
+		for (int32 ChildIndex = ChildrenNodes.Num() - 1; ChildIndex >= 0; --ChildIndex)
+		{
+			NodeStack.Add(ChildrenNodes[ChildIndex]);
+		}
 	}
 	return ResultNodes;
 }
@@ -107,17 +93,20 @@ bool URaiderzXmlUtilities::ReadStringFromBinaryData(FString& StringBuffer, const
 
 	// Check if there are enough bytes to write to Buffer.
 	// Binary.Num() was cast to UINT to prevent type mismatch error for signed/unsigned
-	if ((UINT)BinaryData.Num() < StringLength + Offset)
+	if (StringLength < 0 || (UINT)BinaryData.Num() < StringLength + Offset)
 	{
 		return false;
 	}
 
-	const uint8* BinaryDataPtr = BinaryData.GetData();
-	char* String = new char[StringLength + 1];
-	memcpy(String, BinaryDataPtr + Offset, StringLength);
-	StringBuffer = FString(ANSI_TO_TCHAR(String));
+	// Converted in place instead of through a temporary copy. Stored strings may or may not include their null terminator
+	const ANSICHAR* Chars = reinterpret_cast<const ANSICHAR*>(BinaryData.GetData() + Offset);
+	int32 NumChars = 0;
+	while (NumChars < StringLength && Chars[NumChars] != '\0')
+	{
+		++NumChars;
+	}
+	StringBuffer = FString(NumChars, Chars);
 	Offset += StringLength;
-	delete[] String;
 
 	return true;
 }
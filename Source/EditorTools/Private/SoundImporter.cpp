@@ -5,6 +5,7 @@
 #include "EOD.h"
 #include "EditorFunctionLibrary.h"
 #include "RaiderzXmlUtilities.h"
+#include "RaiderzXmlDatabase.h"
 
 #include "PackageTools.h"
 #include "Sound/SoundBase.h"
@@ -63,13 +64,15 @@ void USoundImporter::ImportSoundForSkeletalMesh(USkeletalMesh* Mesh, USoundAtten
 	TArray<FXmlNode*> AddAnimationNodes = URaiderzXmlUtilities::GetNodesWithTag(RootAnimNode, TEXT("AddAnimation"));
 	SlowTask.EnterProgressFrame();
 
-	FXmlFile SoundFileObj(URaiderzXmlUtilities::SoundXmlFilePath);
-	FXmlNode* RootSoundNode = SoundFileObj.GetRootNode();
-	TArray<FXmlNode*> SoundNodes = URaiderzXmlUtilities::GetNodesWithTag(RootSoundNode, TEXT("SOUND"));
+	// Parse sound.xml as part of the XML stage rather than on the first sound lookup
+	FRaiderzXmlDatabase::Get().GetTable(ERaiderzXmlTable::Sound);
 	SlowTask.EnterProgressFrame();
 
-	TArray<FAssetData> AllSoundAssets = UEditorFunctionLibrary::GetAllSoundAssets();
-	TArray<FAnimSoundInfo> AnimSoundInfoArray = GenerateAnimSoundInfoArray(AnimationNodes, AddAnimationNodes, SoundNodes, MeshAnimAssets, AllSoundAssets);
+	// Everything the per event lookups need is hashed up front so that the import stays linear in the number of events
+	const TMap<FString, FString> AnimationFileNames = GetAnimationFileNameMap(AddAnimationNodes);
+	const TMap<FName, const FAssetData*> MeshAnimAssetsByName = GetAssetNameMap(MeshAnimAssets);
+	const TMap<FName, FAssetData> SoundAssetsByName = UEditorFunctionLibrary::GetAllSoundAssetsByName();
+	TArray<FAnimSoundInfo> AnimSoundInfoArray = GenerateAnimSoundInfoArray(AnimationNodes, AnimationFileNames, MeshAnimAssetsByName, SoundAssetsByName);
 
 	FilterAnimSoundInfoArray(AnimSoundInfoArray);
 	CreateAndApplySoundNotifies(AnimSoundInfoArray, AttenuationToApply);
@@ -78,27 +81,43 @@ void USoundImporter::ImportSoundForSkeletalMesh(USkeletalMesh* Mesh, USoundAtten
 	PrintLog(TEXT("Finished imported sound notifies!"));
 }
 
-bool USoundImporter::GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, FXmlNode* AnimNode, FString& OutFileName)
+TMap<FString, FString> USoundImporter::GetAnimationFileNameMap(const TArray<FXmlNode*>& AddAnimNodes)
 {
-	check(AnimNode);
-	const FString& AnimationName = AnimNode->GetAttribute(TEXT("name"));
+	TMap<FString, FString> AnimationFileNames;
+	AnimationFileNames.Reserve(AddAnimNodes.Num());
 	for (FXmlNode* Node : AddAnimNodes)
 	{
-		if (Node && Node->GetAttribute(TEXT("name")) == AnimationName)
+		if (Node)
 		{
-			OutFileName = Node->GetAttribute(TEXT("filename"));
-			return true;
+			const FString& AnimationName = Node->GetAttribute(TEXT("name"));
+			if (!AnimationFileNames.Contains(AnimationName))
+			{
+				AnimationFileNames.Add(AnimationName, Node->GetAttribute(TEXT("filename")));
+			}
 		}
 	}
-	return false;
+	return AnimationFileNames;
+}
+
+TMap<FName, const FAssetData*> USoundImporter::GetAssetNameMap(const TArray<FAssetData>& Assets)
+{
+	TMap<FName, const FAssetData*> AssetsByName;
+	AssetsByName.Reserve(Assets.Num());
+	for (const FAssetData& AssetData : Assets)
+	{
+		if (!AssetsByName.Contains(AssetData.AssetName))
+		{
+			AssetsByName.Add(AssetData.AssetName, &AssetData);
+		}
+	}
+	return AssetsByName;
 }
 
 TArray<FAnimSoundInfo> USoundImporter::GenerateAnimSoundInfoArray(
 	const TArray<FXmlNode*>& AnimationNodes,
-	const TArray<FXmlNode*>& AddAnimationNodes,
-	const TArray<FXmlNode*>& SoundNodes,
-	const TArray<FAssetData>& MeshAnimAssets,
-	const TArray<FAssetData>& AllSoundAssets)
+	const TMap<FString, FString>& AnimationFileNames,
+	const TMap<FName, const FAssetData*>& MeshAnimAssetsByName,
+	const TMap<FName, FAssetData>& SoundAssetsByName)
 {
 	FScopedSlowTask GenTask(AnimationNodes.Num(), FText::FromString("Generating AnimSoundInfo Array!"));
 	GenTask.MakeDialog();
@@ -112,15 +131,14 @@ TArray<FAnimSoundInfo> USoundImporter::GenerateAnimSoundInfoArray(
 			continue;
 		}
 
-		FString AnimationFileName;
-		bool bFoundFileName = GetAnimationFileName(AddAnimationNodes, AnimNode, AnimationFileName);
-		if (!bFoundFileName)
+		const FString* AnimationFileName = AnimationFileNames.Find(AnimNode->GetAttribute(TEXT("name")));
+		if (!AnimationFileName)
 		{
 			GenTask.EnterProgressFrame();
 			continue;
 		}
 
-		FAnimSoundInfo AnimSoundInfo = GetAnimSoundInfo(AnimNode, SoundNodes, AnimationFileName, MeshAnimAssets, AllSoundAssets);
+		FAnimSoundInfo AnimSoundInfo = GetAnimSoundInfo(AnimNode, *AnimationFileName, MeshAnimAssetsByName, SoundAssetsByName);
 
 		AnimSoundInfoArray.Add(AnimSoundInfo);
 		GenTask.EnterProgressFrame();
@@ -130,36 +148,33 @@ TArray<FAnimSoundInfo> USoundImporter::GenerateAnimSoundInfoArray(
 
 FAnimSoundInfo USoundImporter::GetAnimSoundInfo(
 	FXmlNode* AnimNode,
-	const TArray<FXmlNode*>& SoundNodes,
 	const FString& AnimationFileName,
-	const TArray<FAssetData>& MeshAnimAssets,
-	const TArray<FAssetData>& AllSoundAssets)
+	const TMap<FName, const FAssetData*>& MeshAnimAssetsByName,
+	const TMap<FName, FAssetData>& SoundAssetsByName)
 {
 	check(AnimNode);
 	const FString& AnimationName = AnimNode->GetAttribute(TEXT("name"));
 
 	FAnimSoundInfo AnimSoundInfo;
 	FString EditorAnimFileName = TEXT("A_") + URaiderzXmlUtilities::GetRaiderzBaseFileName(AnimationFileName);
-	for (const FAssetData& AssetData : MeshAnimAssets)
-	{
-		if (AssetData.AssetName.ToString() != EditorAnimFileName)
-		{
-			continue;
-		}
 
+	// FNAME_Find doesn't add names for animations that were never imported
+	const FName EditorAnimName(*EditorAnimFileName, FNAME_Find);
+	const FAssetData* const* AssetData = EditorAnimName.IsNone() ? nullptr : MeshAnimAssetsByName.Find(EditorAnimName);
+	if (AssetData)
+	{
 		FString LogMessage = FString("Found animation file: ") + EditorAnimFileName;
 		PrintLog(LogMessage);
 
 		AnimSoundInfo.AnimationName = AnimationName;
 		AnimSoundInfo.AnimationFileName = AnimationFileName;
-		AnimSoundInfo.AnimationAssetData = AssetData;
-		AnimSoundInfo.FrameToSoundAssetMap = GetFrameToSoundAssetMap(AnimNode, SoundNodes, AllSoundAssets);
-		break;
+		AnimSoundInfo.AnimationAssetData = **AssetData;
+		AnimSoundInfo.FrameToSoundAssetMap = GetFrameToSoundAssetMap(AnimNode, SoundAssetsByName);
 	}
 	return AnimSoundInfo;
 }
 
-TMap<float, FAssetData> USoundImporter::GetFrameToSoundAssetMap(FXmlNode* AnimNode, const TArray<FXmlNode*>& SoundNodes, const TArray<FAssetData>& AllSoundAssets)
+TMap<float, FAssetData> USoundImporter::GetFrameToSoundAssetMap(FXmlNode* AnimNode, const TMap<FName, FAssetData>& SoundAssetsByName)
 {
 	TMap<float, FAssetData> FrameToSoundAssetMap;
 	TArray<FXmlNode*> EventNodes = URaiderzXmlUtilities::GetNodesWithTag(AnimNode, TEXT("EVENT"));
@@ -174,7 +189,7 @@ TMap<float, FAssetData> USoundImporter::GetFrameToSoundAssetMap(FXmlNode* AnimNo
 		int32 Frame = FCString::Atoi(*FrameStr);
 		float ActualFrame = float(Frame) / 160.f;
 
-		FAssetData SoundAssetData = GetSoundAsset(EventNode, SoundNodes, AllSoundAssets);
+		FAssetData SoundAssetData = GetSoundAsset(EventNode, SoundAssetsByName);
 		if (SoundAssetData.IsValid())
 		{
 			FrameToSoundAssetMap.Add(ActualFrame, SoundAssetData);
@@ -183,9 +198,9 @@ TMap<float, FAssetData> USoundImporter::GetFrameToSoundAssetMap(FXmlNode* AnimNo
 	return FrameToSoundAssetMap;
 }
 
-FString USoundImporter::GetEditorSoundName(FXmlNode* EventNode, const TArray<FXmlNode*>& SoundNodes)
+FString USoundImporter::GetEditorSoundName(FXmlNode* EventNode)
 {
-	if (!EventNode || SoundNodes.Num() == 0)
+	if (!EventNode)
 	{
 		return TEXT("");	
 	}
@@ -203,48 +218,35 @@ FString USoundImporter::GetEditorSoundName(FXmlNode* EventNode, const TArray<FXm
 		}
 	}
 
-	for (FXmlNode* Node : SoundNodes)
+	const FRaiderzXmlElement* SoundNode = FRaiderzXmlDatabase::Get().FindSoundByName(SoundName);
+	if (SoundNode)
 	{
-		if (!Node)
-		{
-			continue;
-		}
-
-		if (Node->GetAttribute(TEXT("name")) == SoundName)
-		{
-			const FString& SoundFilePath = Node->GetAttribute(TEXT("filename"));
-			const FString& SoundFileName = FPaths::GetCleanFilename(SoundFilePath);
-			const FString& ProbableEditorSoundName = URaiderzXmlUtilities::GetRaiderzBaseFileName(SoundFileName);
-			const FString& EditorSoundName = PackageTools::SanitizePackageName(ProbableEditorSoundName);
-			return  EditorSoundName;
-		}
+		const FString& SoundFilePath = SoundNode->GetAttribute(TEXT("filename"));
+		const FString& SoundFileName = FPaths::GetCleanFilename(SoundFilePath);
+		const FString& ProbableEditorSoundName = URaiderzXmlUtilities::GetRaiderzBaseFileName(SoundFileName);
+		const FString& EditorSoundName = PackageTools::SanitizePackageName(ProbableEditorSoundName);
+		return  EditorSoundName;
 	}
 
 	return TEXT("");
 }
 
-FAssetData USoundImporter::GetSoundAsset(FXmlNode* EventNode, const TArray<FXmlNode*>& SoundNodes, const TArray<FAssetData>& AllSoundAssets)
+FAssetData USoundImporter::GetSoundAsset(FXmlNode* EventNode, const TMap<FName, FAssetData>& SoundAssetsByName)
 {
 	if (!EventNode)
 	{
 		return FAssetData();
 	}
 
-	const FString& EditorSoundName = GetEditorSoundName(EventNode, SoundNodes);
+	const FString& EditorSoundName = GetEditorSoundName(EventNode);
 	if (EditorSoundName == TEXT(""))
 	{
 		return FAssetData();
 	}
 
-	for (const FAssetData& SoundAsset : AllSoundAssets)
-	{
-		if (SoundAsset.AssetName.ToString() == EditorSoundName)
-		{
-			return SoundAsset;
-		}
-	}
-
-	return FAssetData();
+	const FName SoundAssetName(*EditorSoundName, FNAME_Find);
+	const FAssetData* SoundAsset = SoundAssetName.IsNone() ? nullptr : SoundAssetsByName.Find(SoundAssetName);
+	return SoundAsset ? *SoundAsset : FAssetData();
 }
 
 void USoundImporter::CreateAndApplySoundNotifies(const TArray<FAnimSoundInfo>& AnimSoundInfoArray, USoundAttenuation* AttenuationToApply)
@@ -381,24 +383,28 @@ void USoundImporter::ApplyAttenuationToNotifySound(UAnimSequenceBase* Animation,
 
 void USoundImporter::FilterAnimSoundInfoArray(TArray<FAnimSoundInfo>& AnimSoundInfoArray)
 {
-	int32 Num = AnimSoundInfoArray.Num();
-
 	FScopedSlowTask FilterTask(AnimSoundInfoArray.Num(), FText::FromString("Filtering anim sound info array!"));
 	FilterTask.MakeDialog();
 
-	for (int i = Num - 1; i >= 0; i--)
+	// Keeps the first info of every animation, in order
+	TSet<FName> SeenAnimations;
+	SeenAnimations.Reserve(AnimSoundInfoArray.Num());
+
+	int32 NumKept = 0;
+	for (int32 Index = 0; Index < AnimSoundInfoArray.Num(); ++Index)
 	{
-		const FAnimSoundInfo& SoundInfo = AnimSoundInfoArray[i];
-		for (int j = i - 1; j >= 0; j--)
+		bool bAlreadySeen = false;
+		SeenAnimations.Add(AnimSoundInfoArray[Index].AnimationAssetData.ObjectPath, &bAlreadySeen);
+		if (!bAlreadySeen)
 		{
-			const FAnimSoundInfo& ComInfo = AnimSoundInfoArray[j];
-			if (SoundInfo.AnimationAssetData == ComInfo.AnimationAssetData)
+			if (NumKept != Index)
 			{
-				AnimSoundInfoArray.RemoveAt(i);
-				break;
+				AnimSoundInfoArray[NumKept] = MoveTemp(AnimSoundInfoArray[Index]);
 			}
+			++NumKept;
 		}
 
 		FilterTask.EnterProgressFrame();
 	}
+	AnimSoundInfoArray.SetNum(NumKept);
 }
@@ -0,0 +1,87 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRaiderzBinaryReader;
+class FVecKey;
+class FRotKey;
+
+/** A track of animation keys in structure of arrays layout, so that whole tracks can be processed with vector instructions */
+struct EDITORTOOLS_API FAniKeyTrackSoA
+{
+	TArray<int32> Frames;
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	/** Only used by rotation tracks */
+	TArray<float> W;
+
+	FORCEINLINE int32 Num() const { return Frames.Num(); }
+
+	/** Resizes every component array. Keeps the allocations so that a track can be reused for every node of a file */
+	void SetNumUninitialized(int32 NewNum, bool bWithW);
+};
+
+/**
+ * Bulk decoder for the quantized key records of v12 .ani files.
+ *
+ * Records are decoded a whole track at a time into FAniKeyTrackSoA, and quaternion W components are rebuilt
+ * four keys at a time with the engine's vector intrinsics (SSE or NEON, depending on the platform).
+ */
+class EDITORTOOLS_API FAniKeyDecoder
+{
+public:
+
+	/** Size of a quantized key record: an int32 frame followed by three half precision floats */
+	static const int32 ShortVecKeySize = 10;
+
+	/** Size of a full precision rotation record without W: an int32 frame followed by three floats */
+	static const int32 UniqueVecKeySize = 16;
+
+	/** Reads Count quantized key records into OutTrack */
+	static bool ReadShortVecKeys(FRaiderzBinaryReader& Reader, int32 Count, FAniKeyTrackSoA& OutTrack, bool bWithW);
+
+	/** Reads Count full precision frame-first key records into OutTrack */
+	static bool ReadUniqueVecKeys(FRaiderzBinaryReader& Reader, int32 Count, FAniKeyTrackSoA& OutTrack, bool bWithW);
+
+	/** Sets the W of every key so that the quaternion has unit length, or to 0 if X, Y and Z alone are already longer than that */
+	static void ReconstructQuatW(FAniKeyTrackSoA& Track);
+
+	/** Appends the keys of Track to OutKeys */
+	static void AppendPositionKeys(const FAniKeyTrackSoA& Track, TArray<FVecKey>& OutKeys);
+
+	/** Appends the keys of Track, which must have W, to OutKeys */
+	static void AppendRotationKeys(const FAniKeyTrackSoA& Track, TArray<FRotKey>& OutKeys);
+
+	/** Converts a half precision float to single precision without branches, so that loops over it get vectorized */
+	static FORCEINLINE float HalfToFloat(uint16 Half)
+	{
+		// Shift exponent and mantissa into place and rebias the exponent. Inf/NaN need a larger bias and denormals a renormalization
+		const uint32 ShiftedExponent = 0x7c00 << 13;
+		const uint32 Magic = 113 << 23;
+
+		uint32 Bits = (Half & 0x7fff) << 13;
+		const uint32 Exponent = Bits & ShiftedExponent;
+		Bits += (127 - 15) << 23;
+		Bits += Exponent == ShiftedExponent ? (128 - 16) << 23 : 0;
+
+		const uint32 DenormalBits = Bits + (1 << 23);
+		float DenormalValue;
+		float MagicValue;
+		FMemory::Memcpy(&DenormalValue, &DenormalBits, sizeof(float));
+		FMemory::Memcpy(&MagicValue, &Magic, sizeof(float));
+		DenormalValue -= MagicValue;
+
+		uint32 DenormalResult;
+		FMemory::Memcpy(&DenormalResult, &DenormalValue, sizeof(uint32));
+		Bits = Exponent == 0 ? DenormalResult : Bits;
+		Bits |= (uint32)(Half & 0x8000) << 16;
+
+		float Result;
+		FMemory::Memcpy(&Result, &Bits, sizeof(float));
+		return Result;
+	}
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RaiderzBinaryReader.h"
+#include "AniKeyDecoder.h"
 
 enum class EAnimationType
 {
@@ -130,8 +132,8 @@ public:
 class EDITORTOOLS_API FAniNode
 {
 public:
-	FString NodeName;
-	FString ParentNodeName;
+	FName NodeName;
+	FName ParentNodeName;
 	int VertexCount;
 	int VertexPointCount;
 
@@ -153,21 +155,21 @@ public:
 class EDITORTOOLS_API FAnimationFileLoadImpl
 {
 public:
-	virtual bool LoadVertexAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version) = 0;
-	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version) = 0;
-	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version) = 0;
+	virtual bool LoadVertexAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version) = 0;
+	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version) = 0;
+	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version) = 0;
 };
 
 
 class EDITORTOOLS_API FAnimationFileLoadImpl_v6: public FAnimationFileLoadImpl
 {
 private:
-	virtual void LoadVertexAniBoundingBox(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual void LoadVertexAniBoundingBox(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader);
 
 public:
-	virtual bool LoadVertexAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version) override;
-	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
-	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
+	virtual bool LoadVertexAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version) override;
+	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
+	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
 
 };
 
@@ -181,20 +183,24 @@ public:
 class EDITORTOOLS_API FAnimationFileLoadImpl_v9 : public FAnimationFileLoadImpl_v7
 {
 public:
-	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
+	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
 
 };
 
 class EDITORTOOLS_API FAnimationFileLoadImpl_v11 : public FAnimationFileLoadImpl_v9
 {
 public:
-	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
-	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
+	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
+	virtual bool LoadVisibilityKey(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
 
 };
 
 class EDITORTOOLS_API FAnimationFileLoadImpl_v12 : public FAnimationFileLoadImpl_v11
 {
 public:
-	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, TArray<uint8>& BinaryData, UINT& Offset, DWORD Version)override;
+	virtual bool LoadBoneAni(TSharedPtr<FAniNode> Node, FRaiderzBinaryReader& Reader, DWORD Version)override;
+
+private:
+	/** Decoded keys of the track that is being loaded. Reused for every track of the file to avoid allocations */
+	FAniKeyTrackSoA DecodedKeys;
 };
@@ -6,6 +6,7 @@
 #include "AnimNotify_RaidCollision.h"
 
 #include "XmlFile.h"
+#include "RaiderzXmlReader.h"
 #include "AssetData.h"
 #include "UObject/NoExportTypes.h"
 #include "CollisionImporter.generated.h"
@@ -46,36 +47,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category = EditorLibrary)
 	static void ImportCollisionForSkeletalMesh(USkeletalMesh* Mesh);
 
+	/** Bump whenever ImportCollisionForSkeletalMesh creates different notifies from the same XML, so that FRaiderzImportManifest applies them again */
+	static const int32 ImportVersion = 1;
+
 private:
 
 	static TArray<FCollisionInfo> GenerateCollisionInfoArray(
-		FXmlNode* NPCNode,
-		const TArray<FXmlNode*>& TalentNodes,
+		const FRaiderzXmlElement* NPCNode,
+		const TArray<const FRaiderzXmlElement*>& TalentNodes,
 		const TArray<FXmlNode*>& AddAnimNodes,
-		const TArray<FXmlNode*>& TalentHitNodes,
 		const TArray<FAssetData>& MeshAnimAssets);
 
 	static bool GetCollisionInfo(
-		FXmlNode* NPCNode,
-		FXmlNode* TalentNode,
+		const FRaiderzXmlElement* NPCNode,
+		const FRaiderzXmlElement* TalentNode,
 		const TArray<FXmlNode*>& AddAnimNodes,
-		const TArray<FXmlNode*>& TalentHitNodes,
 		const FString& AnimationFileName,
 		const TArray<FAssetData>& MeshAnimAssets,
 		FCollisionInfo& OutCollisionInfo);
 
-	static TMap<FString, TArray<FString>> GetFrameToCollisionStringMap(const TArray<FXmlNode*>& TalentHitNodes, FXmlNode* TalentNode, FXmlNode* NPCNode);
-	static FXmlNode* GetTalentHitNodeWithID(const TArray<FXmlNode*>& TalentHitNodes, const FString& TalentID);
-	static bool GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, FXmlNode* TalentNode, FXmlNode* NPCNode, FString& OutFileName);
+	static TMap<FString, TArray<FString>> GetFrameToCollisionStringMap(const FRaiderzXmlElement* TalentNode, const FRaiderzXmlElement* NPCNode);
+	static bool GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, const FRaiderzXmlElement* TalentNode, const FRaiderzXmlElement* NPCNode, FString& OutFileName);
 
 	static void CreateAndApplyCollisionNotifies(const TArray<FCollisionInfo>& CollisionInfoArray);
 	static void AddCollisionNotifiesToAnimation(UAnimSequenceBase* Animation, const TMap<FString, TArray<FString>>& FrameToCollisionStringMap);
 	static TArray<FRaidCapsule> GenerateRaidCapsules(const TArray<FString>& CapsuleStrings);
 	static bool HasCollisionNotify(UAnimSequenceBase* Animation, float FrameTime, const TArray<FRaidCapsule>& RaidCapsules);
 
-	static FXmlNode* GetNPCNode(FXmlNode* NPCRootNode, const FString& MeshName);
-	static TArray<FXmlNode*> GetNPCTalents(FXmlNode* TalentRootNode, const FString& InNPCID);
-
 	/** Name of the mesh that is currently being processed */
 	static FString CurrentMeshName;
 
@@ -30,8 +30,12 @@ public:
 	static bool IsHumanPlayerMesh(USkeletalMesh* Mesh);
 	static FString GetRaiderZMeshName(USkeletalMesh* Mesh);
 
+	/** Returns a snapshot of the animations made for the skeleton of the given mesh, which stays valid while assets get imported or renamed */
 	static TArray<FAssetData> GetAllAnimationsForSkeletalMesh(USkeletalMesh* SkeletalMesh);
 	static TArray<FAssetData> GetAllSoundAssets();
 
+	/** Returns all sound assets mapped by asset name. If several sounds share a name the first one found is kept */
+	static TMap<FName, FAssetData> GetAllSoundAssetsByName();
+
 
 };
@@ -9,7 +9,14 @@
 #include "UObject/NoExportTypes.h"
 #include "EluImporter.generated.h"
 
+class USkeleton;
+class UStaticMesh;
+class UAnimSequence;
 class USkeletalMesh;
+class UAnimBoneCompressionSettings;
+class UBodySetup;
+struct FRawAnimSequenceTrack;
+struct FRawMesh;
 
 struct EDITORTOOLS_API FEluFileData
 {
@@ -28,6 +35,74 @@ public:
 
 };
 
+/** Settings for turning parsed .ani data into an animation asset */
+struct EDITORTOOLS_API FEluAnimationImportOptions
+{
+	/** Rate the key tracks are resampled at, in frames per second. RaiderZ animations are authored at 30 */
+	float SampleRate;
+
+	/** A position track whose samples all stay within this distance (cm) of its first sample is stored as a single key */
+	float PositionTolerance;
+
+	/** A rotation track whose samples all stay within this angle (radians) of its first sample is stored as a single key */
+	float RotationTolerance;
+
+	/** A scale track whose samples all stay within this distance of its first sample is stored as a single key */
+	float ScaleTolerance;
+
+	/** Compression settings of the created sequences. If null, the project's default bone compression settings are used */
+	UAnimBoneCompressionSettings* BoneCompressionSettings;
+
+	/** Whether an animation that already exists in the destination package is rebuilt in place, keeping its notifies and every reference to it */
+	bool bReplaceExisting;
+
+	FEluAnimationImportOptions() :
+		SampleRate(30.f),
+		PositionTolerance(0.01f),
+		RotationTolerance(0.0002f),
+		ScaleTolerance(0.0001f),
+		BoneCompressionSettings(nullptr),
+		bReplaceExisting(false)
+	{
+	}
+
+	/** Returns a hash of the settings that affect the created sequence, for FRaiderzImportManifest */
+	uint32 GetSettingsHash() const;
+};
+
+/** Settings for turning parsed .elu data into a static mesh asset */
+struct EDITORTOOLS_API FEluStaticMeshImportOptions
+{
+	/** Whether the nodes of every RaiderZ LOD level are imported as LODs of the static mesh. If false, only the most detailed level is imported */
+	bool bImportLODs;
+
+	/** Screen size below which each LOD gets used, starting with LOD 0. LODs past the end of the list get half the screen size of the LOD before them */
+	TArray<float> LODScreenSizes;
+
+	/**
+	 * Whether nodes flagged RM_FLAG_COLLISION_MESH or RM_FLAG_COLLISION_MESHONLY are turned into simple collision shapes.
+	 * Meshes that get any are set to use their simple collision for complex queries too.
+	 */
+	bool bImportSimpleCollision;
+
+	/** Whether a static mesh that already exists in the destination package is rebuilt in place, keeping every reference to it */
+	bool bReplaceExisting;
+
+	FEluStaticMeshImportOptions() :
+		bImportLODs(true),
+		LODScreenSizes({ 1.f, 0.5f, 0.25f, 0.125f }),
+		bImportSimpleCollision(true),
+		bReplaceExisting(false)
+	{
+	}
+
+	/** Returns the screen size of the given LOD */
+	float GetLODScreenSize(int32 LODIndex) const;
+
+	/** Returns a hash of the settings that affect the created mesh, for FRaiderzImportManifest */
+	uint32 GetSettingsHash() const;
+};
+
 /**
  * 
  */
@@ -51,12 +126,82 @@ public:
 
 	static const int TICKSPERFRAME = 160;
 
-private:
+	/** RaiderZ key frames are in 3ds Max ticks, of which there are 4800 per second (160 per frame at 30 fps) */
+	static const int TICKSPERSECOND = 4800;
 
-	static bool PickEluFile(FString& OutFilePath);
+	/** Bump whenever CreateStaticMesh builds a different mesh from the same data, so that FRaiderzImportManifest re-imports existing ones */
+	static const int32 StaticMeshImportVersion = 1;
+
+	/** Bump whenever CreateAnimSequence builds a different sequence from the same data, so that FRaiderzImportManifest re-imports existing ones */
+	static const int32 AnimationImportVersion = 1;
+
+	/**
+	 * Parses an elu file into memory, or loads the result of an earlier parse of the same file contents from FEluMeshCache.
+	 * Doesn't touch any UObject so it's safe to call from worker threads. Check FEluFileData::bLoadSuccess of the result.
+	 */
 	static FEluFileData LoadEluData(const FString& EluFilePath);
+
+	/**
+	 * Parses an ani file into memory. Doesn't touch any UObject so it's safe to call from worker threads.
+	 * Check FAniFileData::bLoadSuccess of the result.
+	 */
 	static FAniFileData LoadAniData(const FString& AniFilePath);
+
+	/**
+	 * Creates a static mesh asset from parsed elu data. Returns nullptr if the package already exists, unless Options.bReplaceExisting is set. Game thread only.
+	 *
+	 * Nodes are grouped by their LODProjectIndex and each group becomes a LOD of the mesh, from the lowest index to the highest,
+	 * with the screen sizes of Options.
+	 */
+	static UStaticMesh* CreateStaticMesh(
+		const FEluFileData& EluData,
+		const FString& PackageName,
+		const FString& AssetName,
+		const FEluStaticMeshImportOptions& Options = FEluStaticMeshImportOptions());
+
+	/**
+	 * Creates an animation asset for Skeleton from parsed ani data. Returns nullptr if the package already exists, unless Options.bReplaceExisting is set. Game thread only.
+	 *
+	 * The key tracks of every bone are resampled at Options.SampleRate, tracks that stay constant within the given tolerances are reduced to a single key,
+	 * and bones that don't move away from the skeleton's reference pose get no track at all. The sequence is then compressed with Options.BoneCompressionSettings.
+	 */
+	static UAnimSequence* CreateAnimSequence(
+		const FAniFileData& AniData,
+		USkeleton* Skeleton,
+		const FString& PackageName,
+		const FString& AssetName,
+		const FEluAnimationImportOptions& Options = FEluAnimationImportOptions());
+
+private:
+
+	static bool PickEluFile(FString& OutFilePath);
 	static bool ImportEluStaticMesh_Internal(const FString& EluFilePath);
 	static bool ImportEluSkeletalMesh_Internal(const FString& EluFilePath);
 
+	/** Builds the render geometry of all nodes of the given RaiderZ LOD level into OutRawMesh, in the mesh's local space */
+	static void BuildStaticMeshLOD(const TArray<TSharedPtr<FEluMeshNode>>& EluMeshNodes, int32 LODProjectIndex, FRawMesh& OutRawMesh);
+
+	/**
+	 * Adds simple collision shapes to BodySetup for every collision node of EluMeshNodes. Returns the number of shapes added.
+	 * Nodes that are boxes become box elements, flat rectangles become thin boxes and other flat nodes become thin slabs, convex nodes
+	 * become the convex hull of their points and concave nodes are decomposed into several hulls.
+	 * bOutIsExact is false if any node was thickened or decomposed, since those shapes only approximate it.
+	 */
+	static int32 BuildSimpleCollision(const TArray<TSharedPtr<FEluMeshNode>>& EluMeshNodes, UBodySetup* BodySetup, bool& bOutIsExact);
+
+	/** Returns true if all Points lie on the planes of Bounds and every one of its 8 corners is among them, within Tolerance */
+	static bool HasAllBoxCorners(const TArray<FVector>& Points, const FBox& Bounds, const FVector& Tolerance);
+
+	/** Returns true if all points of MeshNode lie on one side of the plane of each of its faces, within Tolerance */
+	static bool IsConvexNode(const FEluMeshNode& MeshNode, float Tolerance);
+
+	/** Samples the position, rotation and scale keys of Node at NumFrames evenly spaced ticks */
+	static void SampleAniNode(const FAniNode& Node, bool bHasBaseTransform, int32 NumFrames, float TicksPerSample, FRawAnimSequenceTrack& OutTrack);
+
+	/**
+	 * Collapses the components of Track that stay within tolerance of their first sample to a single key.
+	 * Returns false if the whole track is within tolerance of RefPose, in which case the bone doesn't need a track.
+	 */
+	static bool ReduceRawTrack(FRawAnimSequenceTrack& Track, const FTransform& RefPose, const FEluAnimationImportOptions& Options);
+
 };
@@ -0,0 +1,40 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FEluFileData;
+class FEluMeshNode;
+
+/**
+ * Binary cache of parsed .elu files, stored in the project's DerivedDataCache folder.
+ *
+ * Entries are keyed by a hash of the .elu file's contents, so an unchanged file loads straight from its cached blob
+ * no matter where it lives or when it was touched, and any edit to it misses the cache.
+ * Blobs are tagged with a format version that has to be bumped whenever FEluMeshNode or the way it's parsed changes.
+ * Thread safe, so it can be used from the parallel parse in the import commandlet.
+ */
+class EDITORTOOLS_API FEluMeshCache
+{
+public:
+
+	/** Returns the cache key of an .elu file with the given contents */
+	static FString GetCacheKey(const uint8* FileData, int64 FileSize);
+
+	/** Loads the cached parse of the file with the given key. Returns false if there's no valid entry for it */
+	static bool Load(const FString& CacheKey, FEluFileData& OutEluData);
+
+	/** Stores the parse of the file with the given key */
+	static void Save(const FString& CacheKey, const FEluFileData& EluData);
+
+	/** Folder cache entries are stored in */
+	static FString GetCacheFolderPath();
+
+private:
+
+	static void SerializeEluData(FArchive& Ar, FEluFileData& EluData);
+
+	static void SerializeMeshNode(FArchive& Ar, FEluMeshNode& MeshNode);
+
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "RaiderzBinaryReader.h"
 
 
 enum RMESH_ALIGN : int
@@ -52,24 +53,13 @@ public:
 	WORD n_bin;	// binormal  index
 };
 
+/** A polygon of a mesh node. Its corners are Vertices consecutive entries of FEluMeshNode::FaceSubDataTable, starting at FirstSubData */
 class EDITORTOOLS_API FMeshPolygonData
 {
 public:
+	int32 FirstSubData;
 	int Vertices;
-	TArray<FFaceSubData> FaceSubDatas;
 	short MaterialID;
-
-	FString ToString()
-	{
-		FString FinalString;
-		FinalString += TEXT("Material ID: ") + FString::FromInt(MaterialID) + TEXT("\n");
-		for (int i = 0; i < FaceSubDatas.Num(); i++)
-		{
-			FFaceSubData& SubData = FaceSubDatas[i];
-			FinalString += TEXT("SubData_") + FString::FromInt(i) + TEXT(": ") + SubData.ToString() + TEXT("\n");
-		}
-		return FinalString;
-	}
 };
 
 class EDITORTOOLS_API FPhysiqueSubData
@@ -130,8 +120,9 @@ public:
 
 	int BipID;
 
-	FString NodeName;
-	FString NodeParentName;
+	/** Interned, since the same bone names are repeated across every mesh and animation of a character */
+	FName NodeName;
+	FName NodeParentName;
 	int ParentNodeID;
 
 	DWORD dwFlag;
@@ -162,6 +153,9 @@ public:
 	int FaceCount;
 	TArray<FMeshPolygonData> PolygonTable;
 
+	/** Corners of all polygons of PolygonTable, back to back */
+	TArray<FFaceSubData> FaceSubDataTable;
+
 	int TotalDegree;	// I suppose it means total number of angles?
 	int TotalTriangles;
 
@@ -203,6 +197,8 @@ public:
 		TangentTanCount = 0;
 		TangentBinCount = 0;
 		TexCoordCount = 0;
+		TexCoordExtraCount = 0;
+		LODProjectIndex = 0;
 		FaceCount = 0;
 		TotalDegree = 0;
 		TotalTriangles = 0;
@@ -217,10 +213,16 @@ public:
 
 	void AddFlag(DWORD Flag) { dwFlag |= Flag; }
 
+	/** Returns the corners of the given polygon of this node */
+	FORCEINLINE TArrayView<const FFaceSubData> GetPolygonSubDatas(const FMeshPolygonData& PolyData) const
+	{
+		return TArrayView<const FFaceSubData>(FaceSubDataTable.GetData() + PolyData.FirstSubData, PolyData.Vertices);
+	}
+
 	FString ToString()
 	{
 		FString FinalString;
-		FinalString += TEXT("Node name: ") + NodeName + TEXT("\n");
+		FinalString += TEXT("Node name: ") + NodeName.ToString() + TEXT("\n");
 		FinalString += TEXT("LODIndex: ") + FString::FromInt(LODProjectIndex)  + TEXT("\n");
 
 		FinalString += TEXT("Num of points: ") + FString::FromInt(PointsTable.Num())  + TEXT("\n");
@@ -235,8 +237,16 @@ public:
 
 		for (int i = 0; i < PolygonTable.Num(); i++)
 		{
-			FMeshPolygonData& PolyData = PolygonTable[i];
-			FinalString += TEXT("PolyData_") + FString::FromInt(i) + TEXT(": ") + PolyData.ToString() + TEXT("\n");
+			const FMeshPolygonData& PolyData = PolygonTable[i];
+			FinalString += TEXT("PolyData_") + FString::FromInt(i) + TEXT(": Material ID: ") + FString::FromInt(PolyData.MaterialID) + TEXT("\n");
+
+			const TArrayView<const FFaceSubData> SubDatas = GetPolygonSubDatas(PolyData);
+			for (int k = 0; k < SubDatas.Num(); k++)
+			{
+				FFaceSubData SubData = SubDatas[k];
+				FinalString += TEXT("SubData_") + FString::FromInt(k) + TEXT(": ") + SubData.ToString() + TEXT("\n");
+			}
+			FinalString += TEXT("\n");
 		}
 
 		return FinalString;
@@ -256,13 +266,20 @@ public:
 	int CurrentEluVersion;
 
 	/**
-	 * Loads the elu mesh node info from BinaryData stream.
+	 * Loads the elu mesh node info from the binary stream of an elu file.
 	 * @param MeshNode The EluMeshNode object to write info to.
-	 * @param BinaryData Binary stream to read binary data from
-	 * @param Offset Offset to start reading binary data from in binary stream. This will get modified.
+	 * @param Reader Reader over the elu file. Its read offset gets advanced past the mesh node.
 	 * @return Returns true if binary data writing was successful.
 	 */
-	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) = 0;
+	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) = 0;
+
+protected:
+
+	/** Loads the total degree, total triangle count and FaceCount polygons of variable degree */
+	bool LoadPolygonTable(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
+
+	/** Keeps the PHYSIQUE_MAX_WEIGHT heaviest bone weights of a vertex at the front of its sub data and normalizes them */
+	static void SelectPhysiqueWeights(FPhysiqueInfo& PhysiqueInfo);
 };
 
 
@@ -270,20 +287,20 @@ class EDITORTOOLS_API FEluMeshNodeLoader_v12 : public FEluMeshNodeLoader
 {
 
 public:
-	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 	
 	//~ 
-	virtual bool LoadName(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadName(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 
-	virtual bool LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 
-	virtual bool LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadFace(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 
-	virtual bool LoadVertexInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadVertexInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 
-	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset);
+	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader);
 	//~
 };
 
@@ -291,10 +308,10 @@ class EDITORTOOLS_API FEluMeshNodeLoader_v13 : public FEluMeshNodeLoader_v12
 {
 
 public:
-	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool Load(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 	
 	//~
-	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 	//~
 };
 
@@ -303,7 +320,7 @@ class EDITORTOOLS_API FEluMeshNodeLoader_v14 : public FEluMeshNodeLoader_v13
 
 public:
 	
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
 };
 
@@ -311,18 +328,18 @@ class EDITORTOOLS_API FEluMeshNodeLoader_v15 : public FEluMeshNodeLoader_v14
 {
 
 public:
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
-	virtual bool LoadFace(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadFace(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 	
-	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 };
 
 class EDITORTOOLS_API FEluMeshNodeLoader_v16 : public FEluMeshNodeLoader_v15
 {
 
 public:
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
 };
 
@@ -330,26 +347,26 @@ class EDITORTOOLS_API FEluMeshNodeLoader_v17 : public FEluMeshNodeLoader_v16
 {
 
 public:
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 };
 
 class EDITORTOOLS_API FEluMeshNodeLoader_v18 : public FEluMeshNodeLoader_v17
 {
 
 public:
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 };
 
 class EDITORTOOLS_API FEluMeshNodeLoader_v20 : public FEluMeshNodeLoader_v18
 {
 
 public:
-	virtual bool LoadName(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadName(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
-	virtual bool LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadInfo(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
-	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadVertex(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
-	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, TArray<uint8>& BinaryData, UINT& Offset) override;
+	virtual bool LoadEtc(TSharedPtr<FEluMeshNode> MeshNode, FRaiderzBinaryReader& Reader) override;
 
 };
@@ -0,0 +1,53 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FRawMesh;
+
+/**
+ * Import time clean up of the raw meshes built from .elu nodes, run before they're handed to UStaticMesh::Build.
+ *
+ * RaiderZ nodes come with their own position tables and faces in exporter order, so the same point shows up once per node
+ * and the triangles touching it are spread all over the index buffer. This welds the points and orders the triangles
+ * of each material so that the builder emits its vertices in the order the GPU's post-transform cache wants them.
+ */
+class EDITORTOOLS_API FEluMeshOptimizer
+{
+public:
+
+	/** Size of the FIFO post-transform cache triangles are ordered for. Small enough to suit every GPU the game targets */
+	static const int32 DefaultCacheSize = 16;
+
+	/** Welds the positions and orders the faces of RawMesh. Logs how much both steps saved */
+	static void OptimizeRawMesh(FRawMesh& RawMesh, const FString& MeshName);
+
+	/** Merges bitwise identical vertex positions and drops positions no wedge uses. Returns how many positions got removed */
+	static int32 WeldVertexPositions(FRawMesh& RawMesh);
+
+	/**
+	 * Returns the ID of the built vertex each wedge of RawMesh turns into.
+	 * Wedges share an ID if they have the same position, tangent basis, UVs and color, which are the attributes the static mesh builder welds by.
+	 */
+	static int32 GetWedgeVertexIDs(const FRawMesh& RawMesh, TArray<int32>& OutVertexIDs);
+
+	/**
+	 * Reorders the faces of every material of RawMesh with Tipsify (Sander, Nehab & Barczak 2007), moving their wedges along with them.
+	 * Only reorders triangle lists, so a mesh that isn't one is left as it is.
+	 */
+	static void OptimizeFaceOrder(FRawMesh& RawMesh, int32 CacheSize = DefaultCacheSize);
+
+	/** Returns the average number of post-transform cache misses per triangle for the given triangle list, simulating a FIFO cache */
+	static float ComputeACMR(const TArray<int32>& Indices, int32 NumVertices, int32 CacheSize = DefaultCacheSize);
+
+private:
+
+	/**
+	 * Orders the triangles of the given list for a cache of CacheSize vertices in linear time.
+	 * @param Indices Triangle list over vertices 0 to NumVertices - 1. Every vertex has to be used by at least one triangle.
+	 * @param OutTriangleOrder Receives the new position of each triangle, as indices of triangles of the list.
+	 */
+	static void TipsifyTriangles(const TArray<int32>& Indices, int32 NumVertices, int32 CacheSize, TArray<int32>& OutTriangleOrder);
+
+};
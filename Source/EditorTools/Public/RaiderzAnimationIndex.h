@@ -0,0 +1,61 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+/**
+ * Index of every animation asset in the project, mapped by the skeleton it's made for.
+ *
+ * Built from the asset registry the first time it's used and then kept up to date from the registry's
+ * asset added, removed and renamed events, so looking up the animations of a skeleton doesn't go through every animation in the project.
+ * Game thread only.
+ */
+class EDITORTOOLS_API FRaiderzAnimationIndex
+{
+public:
+
+	static FRaiderzAnimationIndex& Get();
+
+	/**
+	 * Returns a copy of all animation assets whose Skeleton tag points to the given skeleton.
+	 * A copy because the index changes whenever the asset registry reports an added, removed or renamed asset.
+	 */
+	TArray<FAssetData> GetAnimationsForSkeleton(const FSoftObjectPath& SkeletonPath);
+
+	/** Stops listening to asset registry events and drops the index. Called on module shutdown */
+	void Shutdown();
+
+private:
+
+	FRaiderzAnimationIndex();
+
+	/** Builds the index from the asset registry and subscribes to its events the first time it's needed */
+	void ConditionalInitialize();
+
+	void AddAnimation(const FAssetData& AssetData);
+
+	void RemoveAnimation(const FName& ObjectPath);
+
+	static bool IsAnimationAsset(const FAssetData& AssetData);
+
+	void OnAssetAdded(const FAssetData& AssetData);
+
+	void OnAssetRemoved(const FAssetData& AssetData);
+
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	/** Animation assets mapped by the path of their skeleton */
+	TMap<FSoftObjectPath, TArray<FAssetData>> SkeletonAnimations;
+
+	/** Skeleton path of every indexed animation, mapped by the animation's object path. Used to find an animation's entry when it's removed or renamed */
+	TMap<FName, FSoftObjectPath> AnimationSkeletons;
+
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+
+	bool bInitialized;
+
+};
@@ -0,0 +1,124 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "Async/MappedFileHandle.h"
+
+/**
+ * Sequential reader for RaiderZ binary files (.elu, .ani).
+ * Files are memory mapped whenever the platform supports it, so the data is read in place instead of being copied into a buffer first.
+ * Every read is bounds checked and fails without advancing the read offset if there aren't enough bytes left.
+ */
+class EDITORTOOLS_API FRaiderzBinaryReader
+{
+public:
+
+	FRaiderzBinaryReader();
+
+	/** Creates a reader over a memory block that is owned by the caller and must outlive this reader */
+	FRaiderzBinaryReader(const uint8* InData, int64 InSize);
+
+	~FRaiderzBinaryReader();
+
+	FRaiderzBinaryReader(const FRaiderzBinaryReader&) = delete;
+	FRaiderzBinaryReader& operator=(const FRaiderzBinaryReader&) = delete;
+
+	/** Maps the file at FilePath for reading, falling back to loading it into memory if the file can't be mapped */
+	bool OpenFile(const FString& FilePath);
+
+	/** Unmaps the file (if any) and resets the reader */
+	void Close();
+
+	FORCEINLINE bool IsOpen() const { return Data != nullptr; }
+
+	FORCEINLINE const uint8* GetData() const { return Data; }
+
+	FORCEINLINE int64 GetSize() const { return Size; }
+
+	FORCEINLINE uint32 Tell() const { return Offset; }
+
+	FORCEINLINE int64 GetRemainingSize() const { return Size - Offset; }
+
+	/** Returns true if Count elements of ElementSize bytes can still be read. Counts read from the file must pass this before anything is reserved for them */
+	FORCEINLINE bool CanRead(int64 Count, int64 ElementSize) const { return Count >= 0 && Count * ElementSize <= GetRemainingSize(); }
+
+	/** Moves the read offset forward by NumBytes */
+	bool Skip(uint32 NumBytes);
+
+	/** Copies NumBytes from the current read offset into Buffer */
+	bool Read(void* Buffer, uint32 NumBytes);
+
+	template<typename T>
+	FORCEINLINE bool Read(T& Value)
+	{
+		return Read(&Value, sizeof(T));
+	}
+
+	/** Reads a length prefixed ANSI string */
+	bool ReadString(FString& OutString);
+
+	/** Reads a length prefixed ANSI string straight into the name table, without building an intermediate FString */
+	bool ReadName(FName& OutName);
+
+	/**
+	 * Returns a view of Count elements of type T at the current read offset without copying them.
+	 * @note The view points into the file data, which is only byte aligned. Only use it with plain data types on platforms that support unaligned loads.
+	 */
+	template<typename T>
+	bool ReadView(int32 Count, TArrayView<const T>& OutView)
+	{
+		static_assert(TIsTriviallyCopyConstructible<T>::Value, "FRaiderzBinaryReader::ReadView only supports plain data types");
+
+		if (!CanRead(Count, sizeof(T)))
+		{
+			return false;
+		}
+
+		const int64 NumBytes = (int64)Count * sizeof(T);
+
+		OutView = TArrayView<const T>(reinterpret_cast<const T*>(Data + Offset), Count);
+		Offset += (uint32)NumBytes;
+		return true;
+	}
+
+	/** Appends Count elements of type T to OutArray with a single block copy */
+	template<typename T>
+	bool ReadArray(int32 Count, TArray<T>& OutArray)
+	{
+		static_assert(TIsTriviallyCopyConstructible<T>::Value, "FRaiderzBinaryReader::ReadArray only supports plain data types");
+
+		if (!CanRead(Count, sizeof(T)))
+		{
+			return false;
+		}
+
+		const int64 NumBytes = (int64)Count * sizeof(T);
+
+		// Copy from the untyped file data so that the copy doesn't assume the source is aligned for T
+		const int32 StartIndex = OutArray.AddUninitialized(Count);
+		FMemory::Memcpy(OutArray.GetData() + StartIndex, Data + Offset, NumBytes);
+		Offset += (uint32)NumBytes;
+		return true;
+	}
+
+private:
+
+	/** Reads a length prefixed ANSI string, returning a view of its characters up to the first null terminator */
+	bool ReadStringView(TArrayView<const ANSICHAR>& OutChars);
+
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+
+	/** File contents if the file couldn't be memory mapped */
+	TArray<uint8> FallbackData;
+
+	const uint8* Data;
+
+	int64 Size;
+
+	uint32 Offset;
+
+};
@@ -0,0 +1,124 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/DateTime.h"
+#include "HAL/CriticalSection.h"
+
+/** A single file inside the RaiderZ data folder */
+struct EDITORTOOLS_API FRaiderzFileEntry
+{
+	/** Full path of the file */
+	FString Path;
+
+	FDateTime ModificationTime;
+
+	int64 Size;
+
+	FRaiderzFileEntry() :
+		Size(-1)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FRaiderzFileEntry& Entry)
+	{
+		return Ar << Entry.Path << Entry.ModificationTime << Entry.Size;
+	}
+};
+
+/** Directory listing of a single folder inside the RaiderZ data folder */
+struct FRaiderzFolderEntry
+{
+	/** Modification time of the folder when it was last listed. Adding, removing or renaming a file changes it */
+	FDateTime ModificationTime;
+
+	/** Catalog keys of the files that were listed in this folder */
+	TArray<FString> FileKeys;
+
+	/** Names of the child folders */
+	TArray<FString> SubFolders;
+
+	friend FArchive& operator<<(FArchive& Ar, FRaiderzFolderEntry& Entry)
+	{
+		return Ar << Entry.ModificationTime << Entry.FileKeys << Entry.SubFolders;
+	}
+};
+
+/**
+ * Catalog of every file in URaiderzXmlUtilities::DataFolderPath, mapped by lowercase file name.
+ * If several folders contain a file with the same name, all of them are kept and lookups return the one that was found first.
+ *
+ * The catalog is saved to the project's Saved folder and loaded on first use, so it only has to be built once.
+ * Refreshing it re-lists just the folders whose modification time changed since the last refresh,
+ * and every looked up file is stat'ed so that its modification time and size stay current.
+ */
+class EDITORTOOLS_API FRaiderzFileCatalog
+{
+public:
+
+	static FRaiderzFileCatalog& Get();
+
+	/**
+	 * Finds the full path of the file with the given name (case insensitive). If the file found first has been deleted, the next file with the same name is returned.
+	 * Refreshes the catalog once if no file is found.
+	 */
+	bool FindFilePath(const FString& FileName, FString& OutFilePath);
+
+	/** Same as FindFilePath but also returns the modification time and size of the file */
+	bool FindFile(const FString& FileName, FRaiderzFileEntry& OutEntry);
+
+	/** Re-lists the folders that changed since the last refresh and saves the catalog if anything changed */
+	void Refresh();
+
+	/** Minimum number of seconds between two refreshes caused by failed lookups, so that batches of missing files don't rescan the data folder each time */
+	static const double MinRefreshInterval;
+
+private:
+
+	FRaiderzFileCatalog();
+
+	/** Returns the catalog key for a file name */
+	static FString GetFileKey(const FString& FileName);
+
+	static FString GetCatalogFilePath();
+
+	/** Loads the catalog from disk the first time it's needed and refreshes it */
+	void ConditionalInitialize();
+
+	bool FindFile_Locked(const FString& FileKey, FRaiderzFileEntry& OutEntry);
+
+	void Refresh_Locked();
+
+	/** Re-lists FolderPath if it changed and recurses into its child folders */
+	void RefreshFolder(const FString& FolderPath);
+
+	/** Lists the files and child folders of FolderPath and updates the catalog with them */
+	void ScanFolder(const FString& FolderPath, const FDateTime& FolderModificationTime);
+
+	/** Removes FolderPath, its child folders and all their files from the catalog */
+	void RemoveFolder(const FString& FolderPath);
+
+	/** Removes the file with the given key that lives in FolderPath, keeping files of the same name in other folders */
+	void RemoveFileIfInFolder(const FString& FileKey, const FString& FolderPath);
+
+	void Load();
+
+	void Save();
+
+	/** Files mapped by their lowercase file name. Files of the same name in different folders are kept in the order they were found */
+	TMap<FString, TArray<FRaiderzFileEntry>> Files;
+
+	/** Folders mapped by their full path */
+	TMap<FString, FRaiderzFolderEntry> Folders;
+
+	FCriticalSection CatalogCritical;
+
+	double LastRefreshTime;
+
+	bool bInitialized;
+
+	/** True if the catalog changed since it was last saved */
+	bool bDirty;
+
+};
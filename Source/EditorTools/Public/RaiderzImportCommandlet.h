@@ -0,0 +1,139 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AssetData.h"
+#include "EluImporter.h"
+#include "RaiderzImportManifest.h"
+#include "Commandlets/Commandlet.h"
+#include "RaiderzImportCommandlet.generated.h"
+
+class USkeleton;
+class USkeletalMesh;
+class USoundAttenuation;
+class UAnimBoneCompressionSettings;
+
+/**
+ * Imports RaiderZ meshes, animations, collision notifies and sound notifies without any user interaction.
+ *
+ * Usage: UE4Editor-Cmd.exe EOD.uproject -run=RaiderzImport (-Dir=<folder> | -Manifest=<file>) [-Dest=/Game/RaiderZ/Imported]
+ *        [-Meshes] [-Animations] [-Collision] [-Sound] [-Skeleton=<skeleton path>] [-Attenuation=<sound attenuation path>] [-BatchSize=64]
+ *        [-AnimCompression=<bone compression settings path>] [-AnimSampleRate=30] [-AnimPosTolerance=0.01] [-AnimRotTolerance=0.0002]
+ *        [-NoMeshLODs] [-LODScreenSizes=1.0,0.5,0.25,0.125] [-NoSimpleCollision] [-Force]
+ *
+ * If none of the stage switches is passed, all stages run. A manifest is a text file with one .elu or .ani path per line.
+ * Files are parsed in parallel, a batch at a time, while asset creation and saving stay on the game thread.
+ * Skinned models are skipped and reported. Animations and notifies are imported for the skeletal mesh SK_<folder name> of the RaiderZ model folder a file lives in.
+ *
+ * Every import is recorded in FRaiderzImportManifest. Sources whose contents, importer version and settings match the record of their asset are skipped,
+ * and assets whose sources changed are rebuilt in place. -Force imports everything again. Notifies are applied again whenever one of the XML files
+ * they're read from changed or an animation of the skeletal mesh got imported.
+ */
+UCLASS()
+class EDITORTOOLS_API URaiderzImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	URaiderzImportCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+
+	/** Collects the .elu and .ani files named by -Dir or -Manifest. Returns false if neither was passed */
+	bool GatherSourceFiles(const FString& Params, TArray<FString>& OutEluFiles, TArray<FString>& OutAniFiles);
+
+	/** Returns the long package name an imported asset of the given source file is created in */
+	FString GetDestinationPackageName(const FString& SourceFilePath, const FString& AssetName) const;
+
+	/** Finds the skeleton that animations of the given .ani file get imported for */
+	USkeleton* FindSkeletonForAnimation(const FString& AniFilePath);
+
+	/** Finds the imported skeletal mesh of a RaiderZ model folder, e.g. SK_goblin for .../Monster/goblin */
+	USkeletalMesh* FindSkeletalMeshForFolder(const FString& FolderPath);
+
+	/**
+	 * Makes the import manifest record of every source file and returns in OutUpToDate which of their assets can be skipped.
+	 * Nothing is up to date with -Force, or if the asset's package has been deleted since it was imported.
+	 */
+	void MakeImportRecords(
+		const TArray<FString>& SourceFiles,
+		const TArray<FString>& PackageNames,
+		int32 ImporterVersion,
+		const TArray<uint32>& SettingsHashes,
+		TArray<FRaiderzImportRecord>& OutRecords,
+		TArray<bool>& OutUpToDate);
+
+	/**
+	 * Imports .elu files as static meshes. Files of skinned models (the ones with an .elu.animation.xml) are logged and skipped,
+	 * their skeletal meshes have to be imported separately.
+	 */
+	void ImportMeshes(const TArray<FString>& EluFiles);
+
+	void ImportAnimations(const TArray<FString>& AniFiles);
+
+	void ImportNotifies(const TArray<FString>& SourceFiles, bool bImportCollision, bool bImportSound, USoundAttenuation* Attenuation);
+
+	/**
+	 * Saves every dirty content package to disk and lets GC reclaim what's no longer referenced.
+	 * Pending import records are only written to the manifest if every package got saved.
+	 */
+	void SaveDirtyPackages();
+
+	/** Logs why a source file couldn't be imported and remembers it for the summary at the end of the run */
+	void RecordFailedFile(const FString& FilePath, const FString& Reason);
+
+	/** Root folder that -Dir pointed to. Relative folder structure below it is mirrored under DestinationPath */
+	FString SourceRootPath;
+
+	/** Content folder imported assets are created in */
+	FString DestinationPath;
+
+	/** Whether -Force was passed, which ignores the import manifest */
+	bool bForceImport;
+
+	/** Manifest records of the imports since the last save, mapped by asset key */
+	TMap<FString, FRaiderzImportRecord> PendingRecords;
+
+	/** Source folders that had animations imported, whose notifies have to be applied again */
+	TSet<FString> ImportedAnimationFolders;
+
+	/** Skeleton passed through -Skeleton that overrides the per folder skeleton lookup */
+	UPROPERTY(Transient)
+	USkeleton* SkeletonOverride;
+
+	/** Compression settings passed through -AnimCompression. Kept here so that garbage collection between batches doesn't reclaim them */
+	UPROPERTY(Transient)
+	UAnimBoneCompressionSettings* AnimCompressionSettings;
+
+	/** Resampling, key reduction and compression settings of imported animations */
+	FEluAnimationImportOptions AnimationOptions;
+
+	/** LOD and collision settings of imported static meshes */
+	FEluStaticMeshImportOptions MeshOptions;
+
+	/** Skeletons that have already been looked up for each RaiderZ model folder */
+	UPROPERTY(Transient)
+	TMap<FString, USkeleton*> FolderSkeletons;
+
+	/** Skeletal mesh assets in the asset registry mapped by their asset name */
+	TMap<FName, FAssetData> SkeletalMeshAssets;
+
+	/** Number of files that are parsed in parallel before their assets get created */
+	int32 BatchSize;
+
+	int32 NumImportedAssets;
+
+	int32 NumUpToDateAssets;
+
+	/** Number of skinned model .elu files that were skipped because only static meshes are imported */
+	int32 NumSkippedSkinnedMeshes;
+
+	/** Source files that couldn't be parsed or imported. Any failed file makes the commandlet return an error code */
+	TArray<FString> FailedFiles;
+
+};
@@ -0,0 +1,117 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/DateTime.h"
+#include "HAL/CriticalSection.h"
+
+/** A source file an asset was imported from, as it was at import time */
+struct EDITORTOOLS_API FRaiderzImportSource
+{
+	/** Full path of the file */
+	FString Path;
+
+	FDateTime ModificationTime;
+
+	/** Size of the file, or -1 if it couldn't be read */
+	int64 Size;
+
+	/** CityHash64 of the file contents */
+	uint64 ContentHash;
+
+	FRaiderzImportSource() :
+		Size(-1),
+		ContentHash(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FRaiderzImportSource& Source)
+	{
+		return Ar << Source.Path << Source.ModificationTime << Source.Size << Source.ContentHash;
+	}
+};
+
+/** What a single asset was imported from and how */
+struct EDITORTOOLS_API FRaiderzImportRecord
+{
+	/** The .elu, .ani or XML files the asset was built from */
+	TArray<FRaiderzImportSource> Sources;
+
+	/** Version of the importer that created the asset, e.g. UEluImporter::StaticMeshImportVersion */
+	int32 ImporterVersion;
+
+	/** Hash of the import settings the asset was created with, e.g. FEluStaticMeshImportOptions::GetSettingsHash */
+	uint32 SettingsHash;
+
+	FRaiderzImportRecord() :
+		ImporterVersion(0),
+		SettingsHash(0)
+	{
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FRaiderzImportRecord& Record)
+	{
+		return Ar << Record.Sources << Record.ImporterVersion << Record.SettingsHash;
+	}
+};
+
+/**
+ * Remembers which RaiderZ source files, importer version and settings every imported asset was created from,
+ * so that a re-import only has to process the assets whose sources or settings changed since.
+ *
+ * Records are keyed by the long package name of the asset, or by any other unique name for imports that don't create an asset of their own,
+ * like the notifies applied to the animations of a skeletal mesh. The manifest is saved to the project's Saved folder.
+ * Source files are only hashed again if their modification time or size changed, so checking an unchanged data folder is cheap.
+ */
+class EDITORTOOLS_API FRaiderzImportManifest
+{
+public:
+
+	static FRaiderzImportManifest& Get();
+
+	/**
+	 * Returns the record of importing AssetKey from SourcePaths right now with the given importer version and settings.
+	 * Only reads the sources whose modification time or size differ from the last recorded import of AssetKey. Thread safe.
+	 */
+	FRaiderzImportRecord MakeRecord(const FString& AssetKey, const TArray<FString>& SourcePaths, int32 ImporterVersion, uint32 SettingsHash);
+
+	/** Whether AssetKey was last imported from the same source contents, with the same importer version and settings as Record. Thread safe */
+	bool IsUpToDate(const FString& AssetKey, const FRaiderzImportRecord& Record);
+
+	/** Stores Record as the last import of AssetKey. Thread safe */
+	void RecordImport(const FString& AssetKey, const FRaiderzImportRecord& Record);
+
+	/** Forgets AssetKey, so that it gets imported again the next time. Thread safe */
+	void RemoveRecord(const FString& AssetKey);
+
+	/** Saves the manifest if it changed since it was loaded or last saved */
+	void SaveIfDirty();
+
+private:
+
+	FRaiderzImportManifest();
+
+	static FString GetManifestFilePath();
+
+	/** Stats and hashes the file at Path. Leaves Size at -1 if the file can't be read */
+	static FRaiderzImportSource ReadSource(const FString& Path);
+
+	/** Loads the manifest from disk the first time it's needed */
+	void ConditionalLoad();
+
+	void Load();
+
+	void Save();
+
+	/** Last import of every asset, mapped by asset key */
+	TMap<FString, FRaiderzImportRecord> Records;
+
+	FCriticalSection ManifestCritical;
+
+	bool bLoaded;
+
+	/** True if the manifest changed since it was last saved */
+	bool bDirty;
+
+};
@@ -0,0 +1,116 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RaiderzXmlReader.h"
+#include "Misc/DateTime.h"
+
+/** The RaiderZ game data tables that FRaiderzXmlDatabase keeps parsed */
+enum class ERaiderzXmlTable : uint8
+{
+	NPC,
+	Talent,
+	TalentHitInfo,
+	Sound,
+	MAX
+};
+
+/** The entries of a game data XML file together with hash indexes over them */
+struct FRaiderzXmlTable
+{
+	FString FilePath;
+
+	/** Tag of the nodes that make up the entries of this table, e.g. NPC or TALENT */
+	FString EntryTag;
+
+	/** Attributes whose values are unique per entry. Each of them gets an index */
+	TArray<FString> KeyAttributes;
+
+	/** Attributes that contain a comma separated list of values. Each of them gets an index from every listed value to all entries listing it */
+	TArray<FString> ListAttributes;
+
+	/** Other attributes that are kept. If empty, every attribute is kept */
+	TArray<FString> ValueAttributes;
+
+	/** Tags of the descendants of entries that are kept */
+	TArray<FString> ChildTags;
+
+	/** Whether the text content of entries and their kept descendants is read */
+	bool bReadContent;
+
+	/** Modification time and size of the file when it was parsed. Used to notice that the file changed */
+	FDateTime ModificationTime;
+	int64 Size;
+
+	bool bLoaded;
+
+	TArray<FRaiderzXmlElement> Entries;
+
+	/** Entries mapped by key attribute and then by attribute value. If several entries share a value the first one is kept */
+	TMap<FString, TMap<FString, const FRaiderzXmlElement*>> KeyIndexes;
+
+	/** Entries mapped by list attribute and then by each listed value */
+	TMap<FString, TMap<FString, TArray<const FRaiderzXmlElement*>>> ListIndexes;
+
+	FRaiderzXmlTable() :
+		bReadContent(false),
+		Size(-1),
+		bLoaded(false)
+	{
+	}
+};
+
+/**
+ * Editor lifetime cache of the RaiderZ game data XML files (npc.xml, talent.xml, talent_hit_info.xml and sound.xml).
+ *
+ * Each file is streamed through FRaiderzXmlReader once, the first time it's needed, keeping only the tags and attributes the importers use.
+ * The entries are indexed by the attributes the importers look them up by.
+ * A file is read again if its modification time or size changed, which also invalidates all elements previously returned for it.
+ * So returned elements should not be held on to past the import that looked them up. Game thread only.
+ */
+class EDITORTOOLS_API FRaiderzXmlDatabase
+{
+public:
+
+	static FRaiderzXmlDatabase& Get();
+
+	/** Returns the NPC entry of npc.xml that uses the given mesh */
+	const FRaiderzXmlElement* FindNPCByMeshName(const FString& MeshName);
+
+	/** Returns the TALENT entries that list the given NPC ID in their NPC attribute */
+	const TArray<const FRaiderzXmlElement*>& GetNPCTalents(const FString& NPCID);
+
+	/** Returns the TALENT_HIT entry of talent_hit_info.xml for the given talent ID, including its HitSegment and Capsule elements */
+	const FRaiderzXmlElement* FindTalentHitInfo(const FString& TalentID);
+
+	/** Returns the SOUND entry of sound.xml with the given name */
+	const FRaiderzXmlElement* FindSoundByName(const FString& SoundName);
+
+	/** Returns all SOUND entries of sound.xml */
+	const TArray<FRaiderzXmlElement>& GetAllSounds();
+
+	/** Returns the given table, parsing it first if it hasn't been parsed yet or its file changed */
+	const FRaiderzXmlTable& GetTable(ERaiderzXmlTable TableType);
+
+	/** Drops all parsed tables. They are parsed again on next use */
+	void InvalidateAll();
+
+	/** Source files are checked for changes at most once per this many seconds, since lookups happen in tight loops during imports */
+	static const double SourceCheckInterval;
+
+private:
+
+	FRaiderzXmlDatabase();
+
+	const FRaiderzXmlElement* FindByKey(ERaiderzXmlTable TableType, const FString& Attribute, const FString& Value);
+
+	/** Reads the file of Table and rebuilds its indexes */
+	static void LoadTable(FRaiderzXmlTable& Table);
+
+	FRaiderzXmlTable Tables[(uint8)ERaiderzXmlTable::MAX];
+
+	/** Last time each table's source file was checked for changes */
+	double LastSourceCheckTimes[(uint8)ERaiderzXmlTable::MAX];
+
+};
@@ -0,0 +1,185 @@
+// Copyright 2018 Moikkai Games. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "XmlFile.h"
+#include "Templates/UniquePtr.h"
+
+/** An element pulled out of an XML file by FRaiderzXmlReader::ReadElements, with only the requested attributes and child elements */
+struct EDITORTOOLS_API FRaiderzXmlElement
+{
+	FString Tag;
+
+	/** Text content of the element, with surrounding whitespace trimmed. Only read if requested */
+	FString Content;
+
+	TArray<FXmlAttribute> Attributes;
+
+	TArray<FRaiderzXmlElement> Children;
+
+	/** Returns the value of the given attribute, or an empty string if the element doesn't have it */
+	const FString& GetAttribute(const FString& Name) const;
+
+	/** Returns all descendants of this element with the given tag, in document order */
+	TArray<const FRaiderzXmlElement*> GetElementsWithTag(const FString& InTag) const;
+};
+
+/** Receives the elements read by FRaiderzXmlReader. Returning false from any callback stops reading */
+class IRaiderzXmlCallback
+{
+public:
+
+	virtual ~IRaiderzXmlCallback() {}
+
+	/** Called for the start tag of every reported element. Depth of the root element is 0 */
+	virtual bool ProcessElement(const FString& Tag, const TArray<FXmlAttribute>& Attributes, int32 Depth) = 0;
+
+	/** Called when a reported element closes. Content is empty unless the reader was asked to read content */
+	virtual bool ProcessClose(const FString& Tag, const FString& Content, int32 Depth) { return true; }
+};
+
+/**
+ * Streaming XML reader for RaiderZ game data files.
+ *
+ * Unlike FXmlFile it never holds more than a small read buffer of the file in memory and doesn't build a tree.
+ * It reports elements to a callback in a single pass, optionally limited to a set of tags and attributes,
+ * so that attributes nobody asked for are skipped without ever being decoded.
+ * Supports UTF-8 and ASCII files, comments, CDATA sections, processing instructions and the predefined and numeric character entities.
+ */
+class EDITORTOOLS_API FRaiderzXmlReader
+{
+public:
+
+	FRaiderzXmlReader();
+
+	~FRaiderzXmlReader();
+
+	FRaiderzXmlReader(const FRaiderzXmlReader&) = delete;
+	FRaiderzXmlReader& operator=(const FRaiderzXmlReader&) = delete;
+
+	/** Only elements with these tags get reported. If empty, every element is reported */
+	void SetTagFilter(const TArray<FString>& Tags);
+
+	/** Only these attributes get read. If empty, every attribute is read */
+	void SetAttributeFilter(const TArray<FString>& InAttributes);
+
+	/** Whether the text content of reported elements is read. Off by default since RaiderZ tables keep nearly everything in attributes */
+	void SetReadContent(bool bInReadContent);
+
+	/** Reads the file, reporting elements to Callback. Returns false if the file couldn't be opened or isn't well formed */
+	bool ReadFile(const FString& FilePath, IRaiderzXmlCallback& Callback);
+
+	/** Describes why the last ReadFile failed */
+	const FString& GetLastError() const { return LastError; }
+
+	/**
+	 * Reads every element with EntryTag, together with the descendants of it that have one of ChildTags, into OutElements.
+	 * InAttributes is used as the attribute filter, so if it's empty every attribute is kept.
+	 */
+	static bool ReadElements(
+		const FString& FilePath,
+		const FString& EntryTag,
+		const TArray<FString>& ChildTags,
+		const TArray<FString>& InAttributes,
+		bool bInReadContent,
+		TArray<FRaiderzXmlElement>& OutElements,
+		FString& OutError);
+
+	/** Size of the buffer the file is read through */
+	static const int32 ReadBufferSize = 64 * 1024;
+
+private:
+
+	/** Makes sure at least NumBytes unread bytes are in the read buffer, reading more of the file if needed. Returns false if the file doesn't have that many bytes left */
+	bool EnsureBuffered(int32 NumBytes);
+
+	/** Returns the next byte of the file without consuming it, or -1 at the end of the file */
+	FORCEINLINE int32 PeekChar()
+	{
+		if (BufferPos == BufferNum && !EnsureBuffered(1))
+		{
+			return -1;
+		}
+		return Buffer[BufferPos];
+	}
+
+	/** Consumes and returns the next byte of the file, or -1 at the end of the file */
+	FORCEINLINE int32 NextChar()
+	{
+		const int32 Char = PeekChar();
+		if (Char >= 0)
+		{
+			++BufferPos;
+			LineNumber += Char == '\n' ? 1 : 0;
+		}
+		return Char;
+	}
+
+	FORCEINLINE static bool IsWhitespace(int32 Char)
+	{
+		return Char == ' ' || Char == '\t' || Char == '\r' || Char == '\n';
+	}
+
+	void SkipWhitespace();
+
+	/** Consumes everything up to and including Terminator. If OutBytes is given, everything before the terminator is appended to it */
+	bool SkipPast(const ANSICHAR* Terminator, TArray<uint8>* OutBytes = nullptr);
+
+	/** Consumes the given string if the file continues with it */
+	bool ConsumeIfNext(const ANSICHAR* String);
+
+	/** Reads a tag or attribute name into OutName */
+	bool ReadName(FString& OutName);
+
+	/** Reads a character entity (after its '&') and appends it to OutBytes as UTF-8 */
+	void ReadEntity(TArray<uint8>& OutBytes);
+
+	/** Reads a quoted attribute value. If OutValue is null the value is skipped without being decoded */
+	bool ReadAttributeValue(FString* OutValue);
+
+	bool ReadStartTag(IRaiderzXmlCallback& Callback, bool& bOutContinue);
+
+	bool ReadEndTag(IRaiderzXmlCallback& Callback, bool& bOutContinue);
+
+	bool SetError(const FString& Message);
+
+	/** Decodes Num bytes of UTF-8 and appends them to OutString */
+	static void AppendUTF8ToString(FString& OutString, const uint8* Bytes, int32 Num);
+
+	static void AppendUTF8(TArray<uint8>& OutBytes, uint32 CodePoint);
+
+	TUniquePtr<FArchive> FileReader;
+
+	TArray<uint8> Buffer;
+
+	int32 BufferPos;
+
+	int32 BufferNum;
+
+	int32 LineNumber;
+
+	TSet<FString> TagFilter;
+
+	TSet<FString> AttributeFilter;
+
+	bool bReadContent;
+
+	/** Tags of the elements that are currently open, and whether each of them gets reported */
+	TArray<FString> OpenTags;
+	TArray<bool> OpenTagsReported;
+
+	/** Content of all open reported elements. ContentStarts holds where the content of each open element begins */
+	TArray<uint8> ContentBytes;
+	TArray<int32> ContentStarts;
+
+	/** Scratch buffers reused across tags to avoid allocations */
+	TArray<uint8> NameBytes;
+	TArray<uint8> ValueBytes;
+	FString TagName;
+	FString AttributeName;
+	TArray<FXmlAttribute> Attributes;
+
+	FString LastError;
+
+};
@@ -21,6 +21,7 @@ public:
 	URaiderzXmlUtilities(const FObjectInitializer& ObjectInitializer);
 
 	//---
+	/** Finds a file anywhere inside DataFolderPath by its file name (case insensitive), using FRaiderzFileCatalog */
 	static bool GetRaiderzFilePath(const FString& InFileName, FString& OutFilePath);
 	static FString GetRaiderzFileExtension(const FString& FilePath, bool bIncludeDot = true);
 	static FString GetRaiderzBaseFileName(const FString& FilePath);
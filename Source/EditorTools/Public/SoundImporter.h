@@ -47,27 +47,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = EditorLibrary)
 	static void ImportSoundForSkeletalMesh(USkeletalMesh* Mesh, USoundAttenuation* AttenuationToApply = nullptr);
 
+	/** Bump whenever ImportSoundForSkeletalMesh creates different notifies from the same XML, so that FRaiderzImportManifest applies them again */
+	static const int32 ImportVersion = 1;
+
 private:
 
-	static bool GetAnimationFileName(const TArray<FXmlNode*>& AddAnimNodes, FXmlNode* AnimNode, FString& OutFileName);
+	/** Maps the name of every AddAnimation node to its file name. If several nodes share a name the first one is kept */
+	static TMap<FString, FString> GetAnimationFileNameMap(const TArray<FXmlNode*>& AddAnimNodes);
+
+	/** Maps the given assets by asset name. If several assets share a name the first one is kept */
+	static TMap<FName, const FAssetData*> GetAssetNameMap(const TArray<FAssetData>& Assets);
 
 	static TArray<FAnimSoundInfo> GenerateAnimSoundInfoArray(
 		const TArray<FXmlNode*>& AnimationNodes,
-		const TArray<FXmlNode*>& AddAnimationNodes,
-		const TArray<FXmlNode*>& SoundNodes,
-		const TArray<FAssetData>& MeshAnimAssets,
-		const TArray<FAssetData>& AllSoundAssets);
+		const TMap<FString, FString>& AnimationFileNames,
+		const TMap<FName, const FAssetData*>& MeshAnimAssetsByName,
+		const TMap<FName, FAssetData>& SoundAssetsByName);
 
 	static FAnimSoundInfo GetAnimSoundInfo(
 		FXmlNode* AnimNode,
-		const TArray<FXmlNode*>& SoundNodes,
 		const FString& AnimationFileName,
-		const TArray<FAssetData>& MeshAnimAssets,
-		const TArray<FAssetData>& AllSoundAssets);
+		const TMap<FName, const FAssetData*>& MeshAnimAssetsByName,
+		const TMap<FName, FAssetData>& SoundAssetsByName);
 
-	static FString GetEditorSoundName(FXmlNode* EventNode, const TArray<FXmlNode*>& SoundNodes);
-	static FAssetData GetSoundAsset(FXmlNode* EventNode, const TArray<FXmlNode*>& SoundNodes, const TArray<FAssetData>& AllSoundAssets);
-	static TMap<float, FAssetData> GetFrameToSoundAssetMap(FXmlNode* AnimNode, const TArray<FXmlNode*>& SoundNodes, const TArray<FAssetData>& AllSoundAssets);
+	static FString GetEditorSoundName(FXmlNode* EventNode);
+	static FAssetData GetSoundAsset(FXmlNode* EventNode, const TMap<FName, FAssetData>& SoundAssetsByName);
+	static TMap<float, FAssetData> GetFrameToSoundAssetMap(FXmlNode* AnimNode, const TMap<FName, FAssetData>& SoundAssetsByName);
 
 	static void CreateAndApplySoundNotifies(const TArray<FAnimSoundInfo>& AnimSoundInfoArray, USoundAttenuation* AttenuationToApply);
 	static void AddSoundNotifiesToAnimation(UAnimSequenceBase* Animation, const TMap<float, FAssetData>& FrameToSoundAssetMap, USoundAttenuation* AttenuationToApply);